@@ -39,7 +39,11 @@ static VALUE aggregate_function__set_init(VALUE self);
 static VALUE aggregate_function__set_update(VALUE self);
 static VALUE aggregate_function__set_combine(VALUE self);
 static VALUE aggregate_function__set_finalize(VALUE self);
+static VALUE aggregate_function__set_combine_batch(VALUE self);
+static VALUE aggregate_function__set_finalize_batch(VALUE self);
 static VALUE aggregate_function__set_special_handling(VALUE self);
+static VALUE aggregate_function__set_state(VALUE self, VALUE state_class, VALUE types, VALUE initial);
+static VALUE aggregate_function__set_combine_operations(VALUE self, VALUE operations);
 
 static const rb_data_type_t aggregate_function_data_type = {
     "DuckDB/AggregateFunction",
@@ -53,11 +57,17 @@ static void mark(void *ctx) {
     rb_gc_mark_movable(p->update_proc);
     rb_gc_mark_movable(p->combine_proc);
     rb_gc_mark_movable(p->finalize_proc);
+    rb_gc_mark_movable(p->combine_batch_proc);
+    rb_gc_mark_movable(p->finalize_batch_proc);
+    rb_gc_mark_movable(p->state_class);
 }
 
 static void deallocate(void *ctx) {
     rubyDuckDBAggregateFunction *p = (rubyDuckDBAggregateFunction *)ctx;
     duckdb_destroy_aggregate_function(&(p->aggregate_function));
+    if (p->fields != NULL) {
+        xfree(p->fields);
+    }
     xfree(p);
 }
 
@@ -75,6 +85,15 @@ static void compact(void *ctx) {
     if (p->finalize_proc != Qnil) {
         p->finalize_proc = rb_gc_location(p->finalize_proc);
     }
+    if (p->combine_batch_proc != Qnil) {
+        p->combine_batch_proc = rb_gc_location(p->combine_batch_proc);
+    }
+    if (p->finalize_batch_proc != Qnil) {
+        p->finalize_batch_proc = rb_gc_location(p->finalize_batch_proc);
+    }
+    if (p->state_class != Qnil) {
+        p->state_class = rb_gc_location(p->state_class);
+    }
 }
 
 static VALUE allocate(VALUE klass) {
@@ -83,7 +102,8 @@ static VALUE allocate(VALUE klass) {
 }
 
 static size_t memsize(const void *p) {
-    return sizeof(rubyDuckDBAggregateFunction);
+    const rubyDuckDBAggregateFunction *ctx = (const rubyDuckDBAggregateFunction *)p;
+    return sizeof(rubyDuckDBAggregateFunction) + ctx->field_count * sizeof(rubyDuckDBAggregateField);
 }
 
 rubyDuckDBAggregateFunction *rbduckdb_get_struct_aggregate_function(VALUE obj) {
@@ -100,7 +120,12 @@ static VALUE aggregate_function_initialize(VALUE self) {
     p->update_proc = Qnil;
     p->combine_proc = Qnil;
     p->finalize_proc = Qnil;
+    p->combine_batch_proc = Qnil;
+    p->finalize_batch_proc = Qnil;
     p->special_handling = false;
+    p->field_count = 0;
+    p->fields = NULL;
+    p->state_class = Qnil;
     return self;
 }
 
@@ -191,6 +216,29 @@ static idx_t state_size_callback(duckdb_function_info info) {
     return sizeof(ruby_aggregate_state);
 }
 
+/*
+ * Typed state (set_state): the fields live in the state buffer itself, one
+ * 8-byte slot each, so the state needs no registry entry and init, a native
+ * combine and destroy never touch Ruby.
+ */
+static idx_t typed_state_size_callback(duckdb_function_info info) {
+    rubyDuckDBAggregateFunction *ctx;
+
+    ctx = (rubyDuckDBAggregateFunction *)duckdb_aggregate_function_get_extra_info(info);
+    return ctx->field_count * sizeof(rubyDuckDBAggregateSlot);
+}
+
+static void typed_state_init_callback(duckdb_function_info info, duckdb_aggregate_state state_p) {
+    rubyDuckDBAggregateFunction *ctx;
+    rubyDuckDBAggregateSlot *slots = (rubyDuckDBAggregateSlot *)state_p;
+    idx_t f;
+
+    ctx = (rubyDuckDBAggregateFunction *)duckdb_aggregate_function_get_extra_info(info);
+    for (f = 0; f < ctx->field_count; f++) {
+        memcpy(&slots[f], &ctx->fields[f].initial, sizeof(rubyDuckDBAggregateSlot));
+    }
+}
+
 /* init callback dispatch argument */
 struct init_callback_arg {
     rubyDuckDBAggregateFunction *ctx;
@@ -249,6 +297,7 @@ struct update_callback_arg {
     duckdb_function_info info;
     duckdb_data_chunk input;
     duckdb_aggregate_state *states;
+    VALUE view;
     duckdb_vector *input_vectors;
     duckdb_logical_type *input_types;
     idx_t row_count;
@@ -274,6 +323,8 @@ static void release_chunk_states(struct update_callback_arg *arg) {
     ruby_aggregate_state **states = (ruby_aggregate_state **)arg->states;
     idx_t i;
 
+    if (arg->ctx->field_count > 0) return;
+
     for (i = 0; i < arg->row_count; i++) {
         state_registry_remove(states[i]);
     }
@@ -307,6 +358,11 @@ static VALUE update_process_rows(VALUE varg) {
         arg->input_types[j] = duckdb_vector_get_column_type(arg->input_vectors[j]);
     }
 
+    /* A typed state is passed as one view, re-pointed at each row's state. */
+    if (arg->ctx->field_count > 0) {
+        arg->view = rbduckdb_aggregate_function_state_new(arg->ctx);
+    }
+
     for (i = 0; i < arg->row_count; i++) {
         ruby_aggregate_state *state = states[i];
         struct update_one_arg one;
@@ -334,7 +390,12 @@ static VALUE update_process_rows(VALUE varg) {
             }
         }
 
-        rb_ary_store(args, 0, state_registry_load(state));
+        if (arg->view != Qnil) {
+            rbduckdb_aggregate_function_state_bind(arg->view, state);
+            rb_ary_store(args, 0, arg->view);
+        } else {
+            rb_ary_store(args, 0, state_registry_load(state));
+        }
         for (j = 0; j < arg->col_count; j++) {
             rb_ary_store(args, (long)j + 1, rbduckdb_vector_value_at(arg->input_vectors[j], arg->input_types[j], i));
         }
@@ -350,7 +411,9 @@ static VALUE update_process_rows(VALUE varg) {
             return Qnil;
         }
 
-        state_registry_store(state, ret);
+        if (arg->view == Qnil) {
+            state_registry_store(state, ret);
+        }
     }
 
     RB_GC_GUARD(args);
@@ -362,6 +425,10 @@ static VALUE update_cleanup_callback(VALUE varg) {
     struct update_callback_arg *arg = (struct update_callback_arg *)varg;
     idx_t j;
 
+    if (arg->view != Qnil) {
+        rbduckdb_aggregate_function_state_bind(arg->view, NULL);
+    }
+
     if (arg->input_types != NULL) {
         for (j = 0; j < arg->col_count; j++) {
             duckdb_destroy_logical_type(&arg->input_types[j]);
@@ -418,6 +485,7 @@ static void update_callback(duckdb_function_info info,
     arg.info = info;
     arg.input = input;
     arg.states = states;
+    arg.view = Qnil;
     arg.input_vectors = NULL;
     arg.input_types = NULL;
     arg.row_count = duckdb_data_chunk_get_size(input);
@@ -480,6 +548,200 @@ static void execute_combine_callback_protected(void *user_data) {
     }
 }
 
+/*
+ * Combines typed states with the fields' native operations, without the GVL.
+ * Returns false after reporting an error when an operation is missing or a
+ * BIGINT sum overflows.
+ */
+static bool typed_combine_native(rubyDuckDBAggregateFunction *ctx, duckdb_function_info info,
+                                 duckdb_aggregate_state *source, duckdb_aggregate_state *target, idx_t count) {
+    rubyDuckDBAggregateSlot *src, *tgt;
+    rubyDuckDBAggregateSlot s, t;
+    idx_t i, f;
+
+    for (i = 0; i < count; i++) {
+        src = (rubyDuckDBAggregateSlot *)source[i];
+        tgt = (rubyDuckDBAggregateSlot *)target[i];
+        for (f = 0; f < ctx->field_count; f++) {
+            int op = ctx->fields[f].combine_op;
+
+            memcpy(&s, &src[f], sizeof(s));
+            memcpy(&t, &tgt[f], sizeof(t));
+            if (ctx->fields[f].type == RBDUCKDB_AGGREGATE_FIELD_DOUBLE) {
+                if (op == RBDUCKDB_AGGREGATE_COMBINE_SUM) {
+                    t.dbl += s.dbl;
+                } else if (op == RBDUCKDB_AGGREGATE_COMBINE_MIN) {
+                    t.dbl = s.dbl < t.dbl ? s.dbl : t.dbl;
+                } else if (op == RBDUCKDB_AGGREGATE_COMBINE_MAX) {
+                    t.dbl = s.dbl > t.dbl ? s.dbl : t.dbl;
+                } else {
+                    goto no_combine;
+                }
+            } else {
+                if (op == RBDUCKDB_AGGREGATE_COMBINE_SUM) {
+                    if ((s.bigint > 0 && t.bigint > INT64_MAX - s.bigint) ||
+                        (s.bigint < 0 && t.bigint < INT64_MIN - s.bigint)) {
+                        duckdb_aggregate_function_set_error(info, "BIGINT overflow while combining aggregate states");
+                        return false;
+                    }
+                    t.bigint += s.bigint;
+                } else if (op == RBDUCKDB_AGGREGATE_COMBINE_MIN) {
+                    t.bigint = s.bigint < t.bigint ? s.bigint : t.bigint;
+                } else if (op == RBDUCKDB_AGGREGATE_COMBINE_MAX) {
+                    t.bigint = s.bigint > t.bigint ? s.bigint : t.bigint;
+                } else {
+                    goto no_combine;
+                }
+            }
+            memcpy(&tgt[f], &t, sizeof(t));
+        }
+    }
+    return true;
+
+no_combine:
+    duckdb_aggregate_function_set_error(info, "aggregate function with a typed state needs set_combine");
+    return false;
+}
+
+struct typed_combine_one_arg {
+    rubyDuckDBAggregateFunction *ctx;
+    VALUE source_view;
+    VALUE target_view;
+    duckdb_aggregate_state source;
+    duckdb_aggregate_state target;
+};
+
+/* The views are allocated on the first call, so an allocation failure is caught too. */
+static VALUE call_typed_combine_proc(VALUE varg) {
+    struct typed_combine_one_arg *arg = (struct typed_combine_one_arg *)varg;
+
+    if (NIL_P(arg->source_view)) {
+        arg->source_view = rbduckdb_aggregate_function_state_new(arg->ctx);
+    }
+    if (NIL_P(arg->target_view)) {
+        arg->target_view = rbduckdb_aggregate_function_state_new(arg->ctx);
+    }
+    rbduckdb_aggregate_function_state_bind(arg->source_view, arg->source);
+    rbduckdb_aggregate_function_state_bind(arg->target_view, arg->target);
+    return rb_funcall(arg->ctx->combine_proc, rb_intern("call"), 2, arg->source_view, arg->target_view);
+}
+
+/* Ruby combine of typed states: the block updates the target view in place. */
+static void execute_typed_combine_callback_protected(void *user_data) {
+    struct combine_callback_arg *arg = (struct combine_callback_arg *)user_data;
+    struct typed_combine_one_arg one;
+    int exception_state = 0;
+    idx_t i;
+
+    one.ctx = arg->ctx;
+    one.source_view = Qnil;
+    one.target_view = Qnil;
+
+    for (i = 0; i < arg->count && !exception_state; i++) {
+        one.source = arg->source[i];
+        one.target = arg->target[i];
+        rb_protect(call_typed_combine_proc, (VALUE)&one, &exception_state);
+    }
+    if (!NIL_P(one.source_view)) {
+        rbduckdb_aggregate_function_state_bind(one.source_view, NULL);
+    }
+    if (!NIL_P(one.target_view)) {
+        rbduckdb_aggregate_function_state_bind(one.target_view, NULL);
+    }
+    if (exception_state) {
+        report_ruby_error_to_duckdb(arg->info);
+    }
+    RB_GC_GUARD(one.source_view);
+    RB_GC_GUARD(one.target_view);
+}
+
+/*
+ * Returns the states of a batch as a Ruby Array: the registry VALUEs, or for a
+ * typed state one view per state, which detach_batch_views detaches again.
+ * It allocates, so the batch callbacks build their arrays inside rb_protect.
+ */
+static VALUE batch_states(rubyDuckDBAggregateFunction *ctx, duckdb_aggregate_state *states, idx_t count) {
+    VALUE ary = rb_ary_new_capa((long)count);
+    idx_t i;
+
+    for (i = 0; i < count; i++) {
+        if (ctx->field_count > 0) {
+            VALUE view = rbduckdb_aggregate_function_state_new(ctx);
+            rbduckdb_aggregate_function_state_bind(view, states[i]);
+            rb_ary_push(ary, view);
+        } else {
+            rb_ary_push(ary, state_registry_load((ruby_aggregate_state *)states[i]));
+        }
+    }
+    return ary;
+}
+
+static void detach_batch_views(rubyDuckDBAggregateFunction *ctx, VALUE ary) {
+    long i;
+
+    if (ctx->field_count == 0 || NIL_P(ary)) return;
+    for (i = 0; i < RARRAY_LEN(ary); i++) {
+        rbduckdb_aggregate_function_state_bind(RARRAY_AREF(ary, i), NULL);
+    }
+}
+
+/* Raises unless a batch callback returned an Array with one value per state. */
+static VALUE check_batch_result(VALUE ret, idx_t count, const char *name) {
+    VALUE ary = rb_check_array_type(ret);
+
+    if (NIL_P(ary) || RARRAY_LEN(ary) != (long)count) {
+        rb_raise(rb_eTypeError, "%s must return an Array of %llu values", name, (unsigned long long)count);
+    }
+    return ary;
+}
+
+struct combine_batch_arg {
+    struct combine_callback_arg *arg;
+    VALUE sources;
+    VALUE targets;
+};
+
+static VALUE call_combine_batch_proc(VALUE varg) {
+    struct combine_batch_arg *batch = (struct combine_batch_arg *)varg;
+    struct combine_callback_arg *arg = batch->arg;
+    ruby_aggregate_state **tgt = (ruby_aggregate_state **)arg->target;
+    VALUE ret;
+    idx_t i;
+
+    batch->sources = batch_states(arg->ctx, arg->source, arg->count);
+    batch->targets = batch_states(arg->ctx, arg->target, arg->count);
+    ret = rb_funcall(arg->ctx->combine_batch_proc, rb_intern("call"), 2, batch->sources, batch->targets);
+    /* Typed targets were updated in place through their views. */
+    if (arg->ctx->field_count > 0) {
+        return Qnil;
+    }
+    ret = check_batch_result(ret, arg->count, "combine_batch");
+    for (i = 0; i < arg->count; i++) {
+        state_registry_store(tgt[i], RARRAY_AREF(ret, (long)i));
+    }
+    return Qnil;
+}
+
+/* One Ruby call merges all count (source, target) pairs. */
+static void execute_combine_batch_callback_protected(void *user_data) {
+    struct combine_callback_arg *arg = (struct combine_callback_arg *)user_data;
+    struct combine_batch_arg batch;
+    int exception_state;
+
+    batch.arg = arg;
+    batch.sources = Qnil;
+    batch.targets = Qnil;
+
+    rb_protect(call_combine_batch_proc, (VALUE)&batch, &exception_state);
+    detach_batch_views(arg->ctx, batch.sources);
+    detach_batch_views(arg->ctx, batch.targets);
+    if (exception_state) {
+        report_ruby_error_to_duckdb(arg->info);
+    }
+    RB_GC_GUARD(batch.sources);
+    RB_GC_GUARD(batch.targets);
+}
+
 static void combine_callback(duckdb_function_info info,
                              duckdb_aggregate_state *source,
                              duckdb_aggregate_state *target,
@@ -491,7 +753,11 @@ static void combine_callback(duckdb_function_info info,
     if (ctx == NULL) {
         return;
     }
-    if (ctx->combine_proc == Qnil) {
+    if (ctx->field_count > 0 && ctx->combine_proc == Qnil && ctx->combine_batch_proc == Qnil) {
+        typed_combine_native(ctx, info, source, target, count);
+        return;
+    }
+    if (ctx->combine_proc == Qnil && ctx->combine_batch_proc == Qnil) {
         /* Reached only if _set_init was called directly (bypassing the Ruby
          * wrapper) without setting a combine proc. Raise rather than SIGSEGV. */
         duckdb_aggregate_function_set_error(info, "combine callback invoked with no combine proc set");
@@ -504,6 +770,14 @@ static void combine_callback(duckdb_function_info info,
     arg.target = target;
     arg.count = count;
 
+    if (ctx->combine_batch_proc != Qnil) {
+        rbduckdb_function_executor_dispatch(execute_combine_batch_callback_protected, &arg);
+        return;
+    }
+    if (ctx->field_count > 0) {
+        rbduckdb_function_executor_dispatch(execute_typed_combine_callback_protected, &arg);
+        return;
+    }
     rbduckdb_function_executor_dispatch(execute_combine_callback_protected, &arg);
 }
 
@@ -518,13 +792,26 @@ struct finalize_callback_arg {
 };
 
 struct finalize_one_arg {
-    VALUE finalize_proc;
-    VALUE ruby_state;
+    rubyDuckDBAggregateFunction *ctx;
+    ruby_aggregate_state *state;
+    VALUE view;
 };
 
+/*
+ * A typed state is passed as one view, re-pointed at each state; it is
+ * allocated on the first call, so an allocation failure is caught too.
+ */
 static VALUE call_finalize_proc(VALUE varg) {
     struct finalize_one_arg *arg = (struct finalize_one_arg *)varg;
-    return rb_funcall(arg->finalize_proc, rb_intern("call"), 1, arg->ruby_state);
+
+    if (arg->ctx->field_count == 0) {
+        return rb_funcall(arg->ctx->finalize_proc, rb_intern("call"), 1, state_registry_load(arg->state));
+    }
+    if (NIL_P(arg->view)) {
+        arg->view = rbduckdb_aggregate_function_state_new(arg->ctx);
+    }
+    rbduckdb_aggregate_function_state_bind(arg->view, arg->state);
+    return rb_funcall(arg->ctx->finalize_proc, rb_intern("call"), 1, arg->view);
 }
 
 struct vector_set_arg {
@@ -544,18 +831,18 @@ static void execute_finalize_callback_protected(void *user_data) {
     struct finalize_callback_arg *arg = (struct finalize_callback_arg *)user_data;
     ruby_aggregate_state **states = (ruby_aggregate_state **)arg->source_p;
     duckdb_logical_type result_type = duckdb_vector_get_column_type(arg->result);
+    struct finalize_one_arg one;
     idx_t i;
 
+    one.ctx = arg->ctx;
+    one.view = Qnil;
+
     for (i = 0; i < arg->count; i++) {
-        ruby_aggregate_state *state = states[i];
-        struct finalize_one_arg one;
         struct vector_set_arg vsa;
         int exception_state;
         VALUE ret;
 
-        one.finalize_proc = arg->ctx->finalize_proc;
-        one.ruby_state = state_registry_load(state);
-
+        one.state = states[i];
         ret = rb_protect(call_finalize_proc, (VALUE)&one, &exception_state);
         if (exception_state) {
             report_ruby_error_to_duckdb(arg->info);
@@ -574,18 +861,77 @@ static void execute_finalize_callback_protected(void *user_data) {
         }
 
         /* Release Ruby state from the GC registry. */
-        state_registry_remove(state);
+        if (arg->ctx->field_count == 0) {
+            state_registry_remove(states[i]);
+        }
     }
 
 cleanup:
-    /* Clean up registry entries for the current (failed) state and any
-       remaining unprocessed states so we don't leak GC-registered objects. */
-    for (; i < arg->count; i++) {
-        state_registry_remove(states[i]);
+    if (arg->ctx->field_count > 0) {
+        /* Typed states hold no Ruby objects; only the view needs detaching. */
+        if (!NIL_P(one.view)) {
+            rbduckdb_aggregate_function_state_bind(one.view, NULL);
+        }
+        RB_GC_GUARD(one.view);
+    } else {
+        /* Clean up registry entries for the current (failed) state and any
+           remaining unprocessed states so we don't leak GC-registered objects. */
+        for (; i < arg->count; i++) {
+            state_registry_remove(states[i]);
+        }
     }
     duckdb_destroy_logical_type(&result_type);
 }
 
+struct finalize_batch_arg {
+    struct finalize_callback_arg *arg;
+    VALUE states;
+    duckdb_logical_type result_type;
+};
+
+static VALUE call_finalize_batch_proc(VALUE varg) {
+    struct finalize_batch_arg *batch = (struct finalize_batch_arg *)varg;
+    struct finalize_callback_arg *arg = batch->arg;
+    VALUE ret;
+    idx_t i;
+
+    batch->states = batch_states(arg->ctx, arg->source_p, arg->count);
+    ret = rb_funcall(arg->ctx->finalize_batch_proc, rb_intern("call"), 1, batch->states);
+    ret = check_batch_result(ret, arg->count, "finalize_batch");
+    for (i = 0; i < arg->count; i++) {
+        rbduckdb_vector_set_value_at(arg->result, batch->result_type, arg->offset + i, RARRAY_AREF(ret, (long)i));
+    }
+    return Qnil;
+}
+
+/* One Ruby call finalizes all count states. */
+static void execute_finalize_batch_callback_protected(void *user_data) {
+    struct finalize_callback_arg *arg = (struct finalize_callback_arg *)user_data;
+    struct finalize_batch_arg batch;
+    int exception_state;
+    idx_t i;
+
+    batch.arg = arg;
+    batch.states = Qnil;
+    batch.result_type = duckdb_vector_get_column_type(arg->result);
+
+    rb_protect(call_finalize_batch_proc, (VALUE)&batch, &exception_state);
+    if (exception_state) {
+        report_ruby_error_to_duckdb(arg->info);
+    }
+
+    if (arg->ctx->field_count > 0) {
+        detach_batch_views(arg->ctx, batch.states);
+    } else {
+        /* Release the Ruby states from the GC registry, as finalize does. */
+        for (i = 0; i < arg->count; i++) {
+            state_registry_remove((ruby_aggregate_state *)arg->source_p[i]);
+        }
+    }
+    duckdb_destroy_logical_type(&batch.result_type);
+    RB_GC_GUARD(batch.states);
+}
+
 static void finalize_callback(duckdb_function_info info,
                               duckdb_aggregate_state *source,
                               duckdb_vector result,
@@ -598,7 +944,7 @@ static void finalize_callback(duckdb_function_info info,
     if (ctx == NULL) {
         return;
     }
-    if (ctx->finalize_proc == Qnil) {
+    if (ctx->finalize_proc == Qnil && ctx->finalize_batch_proc == Qnil) {
         /* Reached only if _set_init was called directly (bypassing the Ruby
          * wrapper) without setting a finalize proc. Raise rather than SIGSEGV. */
         duckdb_aggregate_function_set_error(info, "finalize callback invoked with no finalize proc set");
@@ -612,6 +958,10 @@ static void finalize_callback(duckdb_function_info info,
     arg.count = count;
     arg.offset = offset;
 
+    if (ctx->finalize_batch_proc != Qnil) {
+        rbduckdb_function_executor_dispatch(execute_finalize_batch_callback_protected, &arg);
+        return;
+    }
     rbduckdb_function_executor_dispatch(execute_finalize_callback_protected, &arg);
 }
 
@@ -657,6 +1007,19 @@ static void destroy_callback(duckdb_aggregate_state *states, idx_t count) {
  * three before calling _set_init).
  */
 static void maybe_set_functions(rubyDuckDBAggregateFunction *p) {
+    if (p->field_count > 0) {
+        /* Typed state: no registry entries, so no destructor. */
+        duckdb_aggregate_function_set_extra_info(p->aggregate_function, p, NULL);
+        duckdb_aggregate_function_set_functions(
+            p->aggregate_function,
+            typed_state_size_callback,
+            typed_state_init_callback,
+            update_callback,
+            combine_callback,
+            finalize_callback);
+        rbduckdb_function_executor_ensure_started();
+        return;
+    }
     if (p->init_proc == Qnil) {
         return;
     }
@@ -684,6 +1047,9 @@ static VALUE aggregate_function__set_init(VALUE self) {
     }
 
     TypedData_Get_Struct(self, rubyDuckDBAggregateFunction, &aggregate_function_data_type, p);
+    if (p->field_count > 0) {
+        rb_raise(eDuckDBError, "the aggregate function has a typed state; set_init cannot be used");
+    }
     p->init_proc = rb_block_proc();
 
     maybe_set_functions(p);
@@ -717,6 +1083,7 @@ static VALUE aggregate_function__set_combine(VALUE self) {
 
     TypedData_Get_Struct(self, rubyDuckDBAggregateFunction, &aggregate_function_data_type, p);
     p->combine_proc = rb_block_proc();
+    p->combine_batch_proc = Qnil;
 
     maybe_set_functions(p);
 
@@ -733,6 +1100,7 @@ static VALUE aggregate_function__set_finalize(VALUE self) {
 
     TypedData_Get_Struct(self, rubyDuckDBAggregateFunction, &aggregate_function_data_type, p);
     p->finalize_proc = rb_block_proc();
+    p->finalize_batch_proc = Qnil;
 
     maybe_set_functions(p);
 
@@ -748,12 +1116,109 @@ static VALUE aggregate_function__set_special_handling(VALUE self) {
     return self;
 }
 
+/* :nodoc: */
+static VALUE aggregate_function__set_combine_batch(VALUE self) {
+    rubyDuckDBAggregateFunction *p;
+
+    if (!rb_block_given_p()) {
+        rb_raise(rb_eArgError, "block is required");
+    }
+
+    TypedData_Get_Struct(self, rubyDuckDBAggregateFunction, &aggregate_function_data_type, p);
+    p->combine_batch_proc = rb_block_proc();
+    p->combine_proc = Qnil;
+
+    maybe_set_functions(p);
+
+    return self;
+}
+
+/* :nodoc: */
+static VALUE aggregate_function__set_finalize_batch(VALUE self) {
+    rubyDuckDBAggregateFunction *p;
+
+    if (!rb_block_given_p()) {
+        rb_raise(rb_eArgError, "block is required");
+    }
+
+    TypedData_Get_Struct(self, rubyDuckDBAggregateFunction, &aggregate_function_data_type, p);
+    p->finalize_batch_proc = rb_block_proc();
+    p->finalize_proc = Qnil;
+
+    maybe_set_functions(p);
+
+    return self;
+}
+
+/* :nodoc: */
+static VALUE aggregate_function__set_state(VALUE self, VALUE state_class, VALUE types, VALUE initial) {
+    rubyDuckDBAggregateFunction *p;
+    rubyDuckDBAggregateField *fields;
+    long count, i;
+
+    TypedData_Get_Struct(self, rubyDuckDBAggregateFunction, &aggregate_function_data_type, p);
+    Check_Type(types, T_ARRAY);
+    Check_Type(initial, T_ARRAY);
+    count = RARRAY_LEN(types);
+    if (count == 0 || RARRAY_LEN(initial) != count) {
+        rb_raise(rb_eArgError, "a typed state needs at least one field and an initial value for each");
+    }
+    if (p->init_proc != Qnil || p->field_count > 0) {
+        rb_raise(eDuckDBError, "the aggregate function state is already set");
+    }
+
+    fields = ALLOC_N(rubyDuckDBAggregateField, count);
+    for (i = 0; i < count; i++) {
+        fields[i].type = NUM2INT(rb_ary_entry(types, i));
+        fields[i].combine_op = RBDUCKDB_AGGREGATE_COMBINE_NONE;
+        if (fields[i].type == RBDUCKDB_AGGREGATE_FIELD_DOUBLE) {
+            fields[i].initial.dbl = NUM2DBL(rb_ary_entry(initial, i));
+        } else {
+            fields[i].initial.bigint = NUM2LL(rb_ary_entry(initial, i));
+        }
+    }
+
+    p->fields = fields;
+    p->field_count = (idx_t)count;
+    p->state_class = state_class;
+
+    maybe_set_functions(p);
+
+    return self;
+}
+
+/* :nodoc: */
+static VALUE aggregate_function__set_combine_operations(VALUE self, VALUE operations) {
+    rubyDuckDBAggregateFunction *p;
+    idx_t f;
+
+    TypedData_Get_Struct(self, rubyDuckDBAggregateFunction, &aggregate_function_data_type, p);
+    Check_Type(operations, T_ARRAY);
+    if ((idx_t)RARRAY_LEN(operations) != p->field_count) {
+        rb_raise(rb_eArgError, "expected a combine operation for each of the %llu state fields",
+                 (unsigned long long)p->field_count);
+    }
+    for (f = 0; f < p->field_count; f++) {
+        p->fields[f].combine_op = NUM2INT(rb_ary_entry(operations, (long)f));
+    }
+    p->combine_proc = Qnil;
+    p->combine_batch_proc = Qnil;
+
+    return self;
+}
+
 /* Returns the number of Ruby states currently tracked in the registry. */
 static VALUE aggregate_function_s__state_registry_size(VALUE klass) {
     (void)klass;
     return LONG2NUM((long)RHASH_SIZE(g_aggregate_state_registry));
 }
 
+/* Returns the global executor thread, which aggregate callbacks should not need. */
+static VALUE aggregate_function_s__executor_thread(VALUE klass) {
+    (void)klass;
+    return rbduckdb_function_executor_thread();
+}
+
 void rbduckdb_init_aggregate_function(void) {
 #if 0
     VALUE mDuckDB = rb_define_module("DuckDB");
@@ -768,9 +1233,16 @@ void rbduckdb_init_aggregate_function(void) {
     rb_define_private_method(cDuckDBAggregateFunction, "_set_update", aggregate_function__set_update, 0);
     rb_define_private_method(cDuckDBAggregateFunction, "_set_combine", aggregate_function__set_combine, 0);
     rb_define_private_method(cDuckDBAggregateFunction, "_set_finalize", aggregate_function__set_finalize, 0);
+    rb_define_private_method(cDuckDBAggregateFunction, "_set_combine_batch", aggregate_function__set_combine_batch, 0);
+    rb_define_private_method(cDuckDBAggregateFunction, "_set_finalize_batch", aggregate_function__set_finalize_batch, 0);
     rb_define_private_method(cDuckDBAggregateFunction, "_set_special_handling", aggregate_function__set_special_handling, 0);
+    rb_define_private_method(cDuckDBAggregateFunction, "_set_state", aggregate_function__set_state, 3);
+    rb_define_private_method(cDuckDBAggregateFunction, "_set_combine_operations",
+                             aggregate_function__set_combine_operations, 1);
     rb_define_singleton_method(cDuckDBAggregateFunction, "_state_registry_size",
                                aggregate_function_s__state_registry_size, 0);
+    rb_define_singleton_method(cDuckDBAggregateFunction, "_executor_thread",
+                               aggregate_function_s__executor_thread, 0);
 
     g_aggregate_state_registry = rb_hash_new();
     rb_gc_register_mark_object(g_aggregate_state_registry);
@@ -1,13 +1,42 @@
 #ifndef RUBY_DUCKDB_AGGREGATE_FUNCTION_H
 #define RUBY_DUCKDB_AGGREGATE_FUNCTION_H
 
+/* Field types of a typed aggregate state (AggregateFunction#set_state). */
+#define RBDUCKDB_AGGREGATE_FIELD_BIGINT 0
+#define RBDUCKDB_AGGREGATE_FIELD_DOUBLE 1
+
+/* Native combine operations of a typed aggregate state field. */
+#define RBDUCKDB_AGGREGATE_COMBINE_NONE 0
+#define RBDUCKDB_AGGREGATE_COMBINE_SUM  1
+#define RBDUCKDB_AGGREGATE_COMBINE_MIN  2
+#define RBDUCKDB_AGGREGATE_COMBINE_MAX  3
+
+/* One field of a typed aggregate state; each takes an 8-byte slot in the state buffer. */
+typedef union {
+    int64_t bigint;
+    double dbl;
+} rubyDuckDBAggregateSlot;
+
+typedef struct {
+    int type;
+    int combine_op;
+    rubyDuckDBAggregateSlot initial;
+} rubyDuckDBAggregateField;
+
 struct _rubyDuckDBAggregateFunction {
     duckdb_aggregate_function aggregate_function;
     VALUE init_proc;
     VALUE update_proc;
     VALUE combine_proc;
     VALUE finalize_proc;
+    /* Called once per batch of states instead of combine_proc / finalize_proc when set. */
+    VALUE combine_batch_proc;
+    VALUE finalize_batch_proc;
     bool special_handling; /* true when set_special_handling was called */
+    /* Typed state: the fields and the AggregateFunction::State subclass viewing them (0 / Qnil when untyped). */
+    idx_t field_count;
+    rubyDuckDBAggregateField *fields;
+    VALUE state_class;
 };
 
 typedef struct _rubyDuckDBAggregateFunction rubyDuckDBAggregateFunction;
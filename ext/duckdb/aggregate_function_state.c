@@ -0,0 +1,109 @@
+#include "ruby-duckdb.h"
+
+VALUE cDuckDBAggregateFunctionState;
+
+static void deallocate(void *ctx);
+static VALUE allocate(VALUE klass);
+static size_t memsize(const void *p);
+static VALUE aggregate_function_state__get(VALUE self, VALUE index);
+static VALUE aggregate_function_state__set(VALUE self, VALUE index, VALUE value);
+
+static const rb_data_type_t aggregate_function_state_data_type = {
+    "DuckDB/AggregateFunction/State",
+    {NULL, deallocate, memsize,},
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static void deallocate(void *ctx) {
+    rubyDuckDBAggregateFunctionState *p = (rubyDuckDBAggregateFunctionState *)ctx;
+    xfree(p);
+}
+
+static VALUE allocate(VALUE klass) {
+    rubyDuckDBAggregateFunctionState *ctx = xcalloc((size_t)1, sizeof(rubyDuckDBAggregateFunctionState));
+    return TypedData_Wrap_Struct(klass, &aggregate_function_state_data_type, ctx);
+}
+
+static size_t memsize(const void *p) {
+    return sizeof(rubyDuckDBAggregateFunctionState);
+}
+
+/*
+ * Creates a view of the typed states of +function+, as an instance of its
+ * State subclass. The view is pointed at a state buffer with
+ * rbduckdb_aggregate_function_state_bind.
+ */
+VALUE rbduckdb_aggregate_function_state_new(rubyDuckDBAggregateFunction *function) {
+    rubyDuckDBAggregateFunctionState *ctx;
+    VALUE obj = allocate(function->state_class);
+
+    TypedData_Get_Struct(obj, rubyDuckDBAggregateFunctionState, &aggregate_function_state_data_type, ctx);
+    ctx->function = function;
+    ctx->data = NULL;
+    return obj;
+}
+
+/*
+ * Points the view at a state buffer, or detaches it when +data+ is NULL. DuckDB
+ * owns the buffer, so views are detached before the callback using them returns.
+ */
+void rbduckdb_aggregate_function_state_bind(VALUE obj, void *data) {
+    rubyDuckDBAggregateFunctionState *ctx;
+
+    TypedData_Get_Struct(obj, rubyDuckDBAggregateFunctionState, &aggregate_function_state_data_type, ctx);
+    ctx->data = (char *)data;
+}
+
+static rubyDuckDBAggregateSlot *state_slot(VALUE self, VALUE index, int *type) {
+    rubyDuckDBAggregateFunctionState *ctx;
+    long i;
+
+    TypedData_Get_Struct(self, rubyDuckDBAggregateFunctionState, &aggregate_function_state_data_type, ctx);
+    if (ctx->data == NULL) {
+        rb_raise(eDuckDBError, "aggregate state can only be used inside the callback it was passed to");
+    }
+    i = NUM2LONG(index);
+    if (i < 0 || (idx_t)i >= ctx->function->field_count) {
+        rb_raise(rb_eIndexError, "field index %ld is out of range", i);
+    }
+    *type = ctx->function->fields[i].type;
+    return (rubyDuckDBAggregateSlot *)(ctx->data + (size_t)i * sizeof(rubyDuckDBAggregateSlot));
+}
+
+/* :nodoc: */
+static VALUE aggregate_function_state__get(VALUE self, VALUE index) {
+    rubyDuckDBAggregateSlot slot;
+    int type;
+
+    memcpy(&slot, state_slot(self, index, &type), sizeof(slot));
+    if (type == RBDUCKDB_AGGREGATE_FIELD_DOUBLE) {
+        return DBL2NUM(slot.dbl);
+    }
+    return LL2NUM(slot.bigint);
+}
+
+/* :nodoc: */
+static VALUE aggregate_function_state__set(VALUE self, VALUE index, VALUE value) {
+    rubyDuckDBAggregateSlot slot;
+    rubyDuckDBAggregateSlot *dest;
+    int type;
+
+    dest = state_slot(self, index, &type);
+    if (type == RBDUCKDB_AGGREGATE_FIELD_DOUBLE) {
+        slot.dbl = NUM2DBL(value);
+    } else {
+        slot.bigint = NUM2LL(value);
+    }
+    memcpy(dest, &slot, sizeof(slot));
+    return value;
+}
+
+void rbduckdb_init_aggregate_function_state(void) {
+#if 0
+    VALUE mDuckDB = rb_define_module("DuckDB");
+#endif
+    cDuckDBAggregateFunctionState = rb_define_class_under(cDuckDBAggregateFunction, "State", rb_cObject);
+    rb_define_alloc_func(cDuckDBAggregateFunctionState, allocate);
+    rb_define_private_method(cDuckDBAggregateFunctionState, "_get", aggregate_function_state__get, 1);
+    rb_define_private_method(cDuckDBAggregateFunctionState, "_set", aggregate_function_state__set, 2);
+}
@@ -0,0 +1,17 @@
+#ifndef RUBY_DUCKDB_AGGREGATE_FUNCTION_STATE_H
+#define RUBY_DUCKDB_AGGREGATE_FUNCTION_STATE_H
+
+struct _rubyDuckDBAggregateFunctionState {
+    rubyDuckDBAggregateFunction *function;
+    char *data;
+};
+
+typedef struct _rubyDuckDBAggregateFunctionState rubyDuckDBAggregateFunctionState;
+
+extern VALUE cDuckDBAggregateFunctionState;
+
+void rbduckdb_init_aggregate_function_state(void);
+VALUE rbduckdb_aggregate_function_state_new(rubyDuckDBAggregateFunction *function);
+void rbduckdb_aggregate_function_state_bind(VALUE obj, void *data);
+
+#endif
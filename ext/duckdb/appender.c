@@ -72,6 +72,12 @@ static size_t memsize(const void *p) {
     return sizeof(rubyDuckDBAppender);
 }
 
+rubyDuckDBAppender *rbduckdb_get_struct_appender(VALUE obj) {
+    rubyDuckDBAppender *ctx;
+    TypedData_Get_Struct(obj, rubyDuckDBAppender, &appender_data_type, ctx);
+    return ctx;
+}
+
 /* call-seq:
  *   DuckDB::Appender.create_query -> DuckDB::Appender
  *
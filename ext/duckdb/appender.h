@@ -7,6 +7,7 @@ struct _rubyDuckDBAppender {
 
 typedef struct _rubyDuckDBAppender rubyDuckDBAppender;
 
+rubyDuckDBAppender *rbduckdb_get_struct_appender(VALUE obj);
 void rbduckdb_init_appender(void);
 
 #endif
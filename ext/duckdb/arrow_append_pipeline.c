@@ -0,0 +1,608 @@
+#include "ruby-duckdb.h"
+
+/*
+ * Cross-platform threading primitives, as in function_executor.c.
+ * MSVC (mswin) does not provide <pthread.h>.
+ */
+#ifdef _MSC_VER
+#include <windows.h>
+#include <process.h>
+#else
+#include <pthread.h>
+#endif
+
+/*
+ * Pipelined Arrow ingestion backing DuckDB::Connection#append_arrow.
+ *
+ * One native thread pulls struct ArrowArrays from the producer's stream,
+ * several native threads convert them with duckdb_data_chunk_from_arrow
+ * (each on its own connection), and the calling Ruby thread appends the
+ * converted chunks in stream order, all without the GVL. The batches in
+ * flight are bounded by a ring of slots, so a fast producer cannot run ahead
+ * of the appender. The first `skip` batches are read and discarded unconverted,
+ * so a checkpointed load can resume where it stopped.
+ *
+ * None of the native threads ever calls the Ruby API; the producer's
+ * get_next callback must not need the GVL either.
+ */
+
+static VALUE cDuckDBArrowAppendPipeline;
+
+#define PIPELINE_ERROR_SIZE 512
+
+enum pipeline_slot_state {
+    SLOT_EMPTY = 0,
+    SLOT_PULLED,
+    SLOT_CONVERTING,
+    SLOT_READY
+};
+
+typedef struct {
+    enum pipeline_slot_state state;
+    struct ArrowArray array;
+    duckdb_data_chunk chunk;
+} pipeline_slot;
+
+struct converter_arg;
+
+#ifdef _MSC_VER
+typedef HANDLE pipeline_thread_t;
+#else
+typedef pthread_t pipeline_thread_t;
+#endif
+
+typedef struct {
+    VALUE connection;
+    VALUE converted;
+    struct ArrowArrayStream *stream;
+    duckdb_arrow_converted_schema converted_schema;
+#ifdef _MSC_VER
+    CRITICAL_SECTION lock;
+    CONDITION_VARIABLE cond;
+#else
+    pthread_mutex_t lock;
+    pthread_cond_t cond;
+#endif
+    bool sync_initialized;
+    idx_t capacity;
+    idx_t skip;       /* batches still to discard from the stream's start */
+    pipeline_slot *slots;
+    idx_t pulled;     /* batches pulled from the stream */
+    idx_t converting; /* next batch to convert */
+    idx_t consumed;   /* next batch to append */
+    bool end_of_stream;
+    bool stop;
+    char error[PIPELINE_ERROR_SIZE];
+    int converter_count;
+    duckdb_connection *connections;
+    struct converter_arg *converter_args;
+    pipeline_thread_t *threads;
+    int thread_count;
+    bool closed;
+} rubyDuckDBArrowAppendPipeline;
+
+struct converter_arg {
+    rubyDuckDBArrowAppendPipeline *pipeline;
+    duckdb_connection con;
+};
+
+struct consume_arg {
+    rubyDuckDBArrowAppendPipeline *pipeline;
+    duckdb_appender appender;
+    idx_t max_chunks;
+    idx_t chunks;
+    idx_t rows;
+    bool interrupted;
+    bool append_failed;
+};
+
+static void mark(void *ctx);
+static void deallocate(void *ctx);
+static VALUE allocate(VALUE klass);
+static size_t memsize(const void *p);
+static void compact(void *ctx);
+static void pipeline_lock(rubyDuckDBArrowAppendPipeline *p);
+static void pipeline_unlock(rubyDuckDBArrowAppendPipeline *p);
+static void pipeline_wait(rubyDuckDBArrowAppendPipeline *p);
+static void pipeline_broadcast(rubyDuckDBArrowAppendPipeline *p);
+static void pipeline_fail(rubyDuckDBArrowAppendPipeline *p, const char *message);
+static void pull_batches(rubyDuckDBArrowAppendPipeline *p);
+static void convert_batches(struct converter_arg *arg);
+static int start_thread(rubyDuckDBArrowAppendPipeline *p, void *arg, bool puller);
+static void pipeline_shutdown(rubyDuckDBArrowAppendPipeline *p);
+static void *consume_chunks(void *data);
+static void consume_stop(void *data);
+static VALUE connection__arrow_append_pipeline(VALUE self, VALUE address, VALUE converted, VALUE threads, VALUE skip);
+static VALUE arrow_append_pipeline_append(int argc, VALUE *argv, VALUE self);
+static VALUE arrow_append_pipeline_close(VALUE self);
+
+static const rb_data_type_t arrow_append_pipeline_data_type = {
+    "DuckDB/ArrowAppendPipeline",
+    {mark, deallocate, memsize, compact},
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static void mark(void *ctx) {
+    rubyDuckDBArrowAppendPipeline *p = (rubyDuckDBArrowAppendPipeline *)ctx;
+    rb_gc_mark(p->connection);
+    rb_gc_mark(p->converted);
+}
+
+static void deallocate(void *ctx) {
+    rubyDuckDBArrowAppendPipeline *p = (rubyDuckDBArrowAppendPipeline *)ctx;
+
+    pipeline_shutdown(p);
+    if (p->sync_initialized) {
+#ifdef _MSC_VER
+        DeleteCriticalSection(&p->lock);
+#else
+        pthread_cond_destroy(&p->cond);
+        pthread_mutex_destroy(&p->lock);
+#endif
+    }
+    xfree(p);
+}
+
+static VALUE allocate(VALUE klass) {
+    rubyDuckDBArrowAppendPipeline *ctx = xcalloc((size_t)1, sizeof(rubyDuckDBArrowAppendPipeline));
+    ctx->connection = Qnil;
+    ctx->converted = Qnil;
+    return TypedData_Wrap_Struct(klass, &arrow_append_pipeline_data_type, ctx);
+}
+
+static size_t memsize(const void *p) {
+    const rubyDuckDBArrowAppendPipeline *ctx = (const rubyDuckDBArrowAppendPipeline *)p;
+    return sizeof(rubyDuckDBArrowAppendPipeline) + sizeof(pipeline_slot) * ctx->capacity;
+}
+
+static void compact(void *ctx) {
+    rubyDuckDBArrowAppendPipeline *p = (rubyDuckDBArrowAppendPipeline *)ctx;
+    p->connection = rb_gc_location(p->connection);
+    p->converted = rb_gc_location(p->converted);
+}
+
+static void pipeline_lock(rubyDuckDBArrowAppendPipeline *p) {
+#ifdef _MSC_VER
+    EnterCriticalSection(&p->lock);
+#else
+    pthread_mutex_lock(&p->lock);
+#endif
+}
+
+static void pipeline_unlock(rubyDuckDBArrowAppendPipeline *p) {
+#ifdef _MSC_VER
+    LeaveCriticalSection(&p->lock);
+#else
+    pthread_mutex_unlock(&p->lock);
+#endif
+}
+
+static void pipeline_wait(rubyDuckDBArrowAppendPipeline *p) {
+#ifdef _MSC_VER
+    SleepConditionVariableCS(&p->cond, &p->lock, INFINITE);
+#else
+    pthread_cond_wait(&p->cond, &p->lock);
+#endif
+}
+
+static void pipeline_broadcast(rubyDuckDBArrowAppendPipeline *p) {
+#ifdef _MSC_VER
+    WakeAllConditionVariable(&p->cond);
+#else
+    pthread_cond_broadcast(&p->cond);
+#endif
+}
+
+/* Records the first error and stops every stage. Called with the lock held. */
+static void pipeline_fail(rubyDuckDBArrowAppendPipeline *p, const char *message) {
+    if (p->error[0] == '\0') {
+        snprintf(p->error, PIPELINE_ERROR_SIZE, "%s", message);
+    }
+    p->stop = true;
+    pipeline_broadcast(p);
+}
+
+/* Puller thread: reads batches from the stream into free slots. */
+static void pull_batches(rubyDuckDBArrowAppendPipeline *p) {
+    struct ArrowArray array;
+    char message[PIPELINE_ERROR_SIZE];
+    const char *err;
+    pipeline_slot *slot;
+    int rc;
+
+    pipeline_lock(p);
+    while (!p->stop) {
+        while (!p->stop && p->pulled - p->consumed >= p->capacity) {
+            pipeline_wait(p);
+        }
+        if (p->stop) {
+            break;
+        }
+        pipeline_unlock(p);
+
+        memset(&array, 0, sizeof(array));
+        rc = p->stream->get_next(p->stream, &array);
+        if (rc != 0) {
+            err = p->stream->get_last_error(p->stream);
+            snprintf(message, PIPELINE_ERROR_SIZE, "failed to get next Arrow chunk: %s", err ? err : "unknown error");
+        }
+
+        pipeline_lock(p);
+        if (rc != 0) {
+            pipeline_fail(p, message);
+            break;
+        }
+        /* End of stream: a released array (release == NULL). */
+        if (array.release == NULL) {
+            p->end_of_stream = true;
+            pipeline_broadcast(p);
+            break;
+        }
+        if (p->stop) {
+            array.release(&array);
+            break;
+        }
+        if (p->skip > 0) {
+            p->skip--;
+            array.release(&array);
+            continue;
+        }
+        slot = &p->slots[p->pulled % p->capacity];
+        slot->array = array;
+        slot->state = SLOT_PULLED;
+        p->pulled++;
+        pipeline_broadcast(p);
+    }
+    pipeline_unlock(p);
+}
+
+/* Converter thread: turns pulled batches into data chunks, in any order. */
+static void convert_batches(struct converter_arg *arg) {
+    rubyDuckDBArrowAppendPipeline *p = arg->pipeline;
+    struct ArrowArray array;
+    duckdb_data_chunk chunk;
+    duckdb_error_data error_data;
+    char message[PIPELINE_ERROR_SIZE];
+    pipeline_slot *slot;
+    bool failed;
+
+    pipeline_lock(p);
+    for (;;) {
+        while (!p->stop && p->converting >= p->pulled && !p->end_of_stream) {
+            pipeline_wait(p);
+        }
+        if (p->stop || p->converting >= p->pulled) {
+            break;
+        }
+        slot = &p->slots[p->converting % p->capacity];
+        p->converting++;
+        slot->state = SLOT_CONVERTING;
+        array = slot->array;
+        memset(&slot->array, 0, sizeof(slot->array));
+        pipeline_unlock(p);
+
+        chunk = NULL;
+        failed = false;
+        /* duckdb_data_chunk_from_arrow takes ownership of the array (nulls its
+         * release). On error before that, we still own it and must release it. */
+        error_data = duckdb_data_chunk_from_arrow(arg->con, &array, p->converted_schema, &chunk);
+        if (array.release != NULL) {
+            array.release(&array);
+        }
+        if (error_data != NULL) {
+            if (duckdb_error_data_has_error(error_data)) {
+                snprintf(message, PIPELINE_ERROR_SIZE, "%s", duckdb_error_data_message(error_data));
+                failed = true;
+            }
+            duckdb_destroy_error_data(&error_data);
+        }
+
+        pipeline_lock(p);
+        if (failed) {
+            if (chunk) {
+                duckdb_destroy_data_chunk(&chunk);
+            }
+            pipeline_fail(p, message);
+            break;
+        }
+        slot->chunk = chunk;
+        slot->state = SLOT_READY;
+        pipeline_broadcast(p);
+    }
+    pipeline_unlock(p);
+}
+
+#ifdef _MSC_VER
+static unsigned __stdcall puller_main(void *arg) {
+    pull_batches((rubyDuckDBArrowAppendPipeline *)arg);
+    return 0;
+}
+
+static unsigned __stdcall converter_main(void *arg) {
+    convert_batches((struct converter_arg *)arg);
+    return 0;
+}
+#else
+static void *puller_main(void *arg) {
+    pull_batches((rubyDuckDBArrowAppendPipeline *)arg);
+    return NULL;
+}
+
+static void *converter_main(void *arg) {
+    convert_batches((struct converter_arg *)arg);
+    return NULL;
+}
+#endif
+
+static int start_thread(rubyDuckDBArrowAppendPipeline *p, void *arg, bool puller) {
+    pipeline_thread_t *thread = &p->threads[p->thread_count];
+
+#ifdef _MSC_VER
+    *thread = (HANDLE)_beginthreadex(NULL, 0, puller ? puller_main : converter_main, arg, 0, NULL);
+    if (*thread == 0) {
+        return 0;
+    }
+#else
+    if (pthread_create(thread, NULL, puller ? puller_main : converter_main, arg) != 0) {
+        return 0;
+    }
+#endif
+    p->thread_count++;
+    return 1;
+}
+
+/*
+ * Stops and joins every native thread, then frees the batches still in
+ * flight. Never calls Ruby, so it is safe from deallocate.
+ */
+static void pipeline_shutdown(rubyDuckDBArrowAppendPipeline *p) {
+    int i;
+    idx_t s;
+
+    if (p->closed) {
+        return;
+    }
+    p->closed = true;
+
+    if (p->sync_initialized) {
+        pipeline_lock(p);
+        p->stop = true;
+        pipeline_broadcast(p);
+        pipeline_unlock(p);
+    }
+    for (i = 0; i < p->thread_count; i++) {
+#ifdef _MSC_VER
+        WaitForSingleObject(p->threads[i], INFINITE);
+        CloseHandle(p->threads[i]);
+#else
+        pthread_join(p->threads[i], NULL);
+#endif
+    }
+    p->thread_count = 0;
+
+    for (s = 0; p->slots && s < p->capacity; s++) {
+        if (p->slots[s].array.release != NULL) {
+            p->slots[s].array.release(&p->slots[s].array);
+        }
+        if (p->slots[s].chunk) {
+            duckdb_destroy_data_chunk(&p->slots[s].chunk);
+        }
+    }
+    if (p->connections) {
+        for (i = 0; i < p->converter_count; i++) {
+            if (p->connections[i]) {
+                duckdb_disconnect(&p->connections[i]);
+            }
+        }
+    }
+    free(p->slots);
+    free(p->connections);
+    free(p->converter_args);
+    free(p->threads);
+    p->slots = NULL;
+    p->connections = NULL;
+    p->converter_args = NULL;
+    p->threads = NULL;
+    p->capacity = 0;
+}
+
+/* :nodoc: */
+static VALUE connection__arrow_append_pipeline(VALUE self, VALUE address, VALUE converted, VALUE threads, VALUE skip) {
+    rubyDuckDBConnection *ctxcon;
+    rubyDuckDBArrowAppendPipeline *ctx;
+    VALUE obj;
+    int converter_count;
+    int i;
+
+    ctxcon = rbduckdb_get_struct_connection(self);
+    if (NIL_P(ctxcon->database)) {
+        rb_raise(eDuckDBError, "connection is not associated with a database");
+    }
+    converter_count = NUM2INT(threads);
+    if (converter_count < 1) {
+        rb_raise(rb_eArgError, "threads must be positive");
+    }
+    if (NUM2LL(skip) < 0) {
+        rb_raise(rb_eArgError, "skip must not be negative");
+    }
+    obj = allocate(cDuckDBArrowAppendPipeline);
+    TypedData_Get_Struct(obj, rubyDuckDBArrowAppendPipeline, &arrow_append_pipeline_data_type, ctx);
+    ctx->connection = self;
+    ctx->converted = converted;
+    ctx->stream = (struct ArrowArrayStream *)(uintptr_t)NUM2ULL(address);
+    ctx->converted_schema = rbduckdb_get_struct_arrow_converted_schema(converted)->converted_schema;
+    if (ctx->stream == NULL) {
+        rb_raise(eDuckDBError, "Arrow producer returned a NULL stream");
+    }
+
+#ifdef _MSC_VER
+    InitializeCriticalSection(&ctx->lock);
+    InitializeConditionVariable(&ctx->cond);
+#else
+    pthread_mutex_init(&ctx->lock, NULL);
+    pthread_cond_init(&ctx->cond, NULL);
+#endif
+    ctx->sync_initialized = true;
+
+    ctx->converter_count = converter_count;
+    ctx->capacity = (idx_t)converter_count * 2;
+    ctx->skip = (idx_t)NUM2ULL(skip);
+    ctx->slots = calloc((size_t)ctx->capacity, sizeof(pipeline_slot));
+    ctx->connections = calloc((size_t)converter_count, sizeof(duckdb_connection));
+    ctx->converter_args = calloc((size_t)converter_count, sizeof(struct converter_arg));
+    ctx->threads = calloc((size_t)converter_count + 1, sizeof(pipeline_thread_t));
+    if (!ctx->slots || !ctx->connections || !ctx->converter_args || !ctx->threads) {
+        rb_raise(rb_eNoMemError, "failed to allocate Arrow append pipeline");
+    }
+
+    for (i = 0; i < converter_count; i++) {
+        if (rbduckdb_database_connect(ctxcon->database, &ctx->connections[i]) == DuckDBError) {
+            rb_raise(eDuckDBError, "failed to connect to the database");
+        }
+    }
+
+    if (!start_thread(ctx, ctx, true)) {
+        rb_raise(eDuckDBError, "failed to start Arrow puller thread");
+    }
+    for (i = 0; i < converter_count; i++) {
+        ctx->converter_args[i].pipeline = ctx;
+        ctx->converter_args[i].con = ctx->connections[i];
+        if (!start_thread(ctx, &ctx->converter_args[i], false)) {
+            pipeline_shutdown(ctx);
+            rb_raise(eDuckDBError, "failed to start Arrow converter thread");
+        }
+    }
+
+    return obj;
+}
+
+/* Appends converted chunks in stream order; runs without the GVL. */
+static void *consume_chunks(void *data) {
+    struct consume_arg *arg = (struct consume_arg *)data;
+    rubyDuckDBArrowAppendPipeline *p = arg->pipeline;
+    pipeline_slot *slot;
+    duckdb_data_chunk chunk;
+    duckdb_state state;
+
+    pipeline_lock(p);
+    while (arg->chunks < arg->max_chunks) {
+        slot = &p->slots[p->consumed % p->capacity];
+        while (!p->stop && !arg->interrupted && slot->state != SLOT_READY &&
+               !(p->end_of_stream && p->consumed >= p->pulled)) {
+            pipeline_wait(p);
+        }
+        if (p->stop || arg->interrupted || slot->state != SLOT_READY) {
+            break;
+        }
+        chunk = slot->chunk;
+        slot->chunk = NULL;
+        slot->state = SLOT_EMPTY;
+        p->consumed++;
+        pipeline_broadcast(p);
+        pipeline_unlock(p);
+
+        arg->rows += duckdb_data_chunk_get_size(chunk);
+        state = duckdb_append_data_chunk(arg->appender, chunk);
+        duckdb_destroy_data_chunk(&chunk);
+
+        pipeline_lock(p);
+        if (state == DuckDBError) {
+            arg->append_failed = true;
+            break;
+        }
+        arg->chunks++;
+    }
+    pipeline_unlock(p);
+    return NULL;
+}
+
+static void consume_stop(void *data) {
+    struct consume_arg *arg = (struct consume_arg *)data;
+    rubyDuckDBArrowAppendPipeline *p = arg->pipeline;
+
+    pipeline_lock(p);
+    arg->interrupted = true;
+    pipeline_broadcast(p);
+    pipeline_unlock(p);
+}
+
+/*
+ * :nodoc:
+ * call-seq:
+ *   pipeline.append(appender, max_chunks = nil) -> [chunks, rows]
+ *
+ * Appends up to max_chunks converted chunks (all remaining when nil) and
+ * returns how many chunks and rows were appended. [0, 0] means the stream
+ * is exhausted.
+ */
+static VALUE arrow_append_pipeline_append(int argc, VALUE *argv, VALUE self) {
+    rubyDuckDBArrowAppendPipeline *ctx;
+    struct consume_arg arg;
+    VALUE appender;
+    VALUE max_chunks;
+    duckdb_error_data error_data;
+    VALUE message;
+
+    rb_scan_args(argc, argv, "11", &appender, &max_chunks);
+    TypedData_Get_Struct(self, rubyDuckDBArrowAppendPipeline, &arrow_append_pipeline_data_type, ctx);
+    if (ctx->closed) {
+        rb_raise(eDuckDBError, "Arrow append pipeline is closed");
+    }
+
+    memset(&arg, 0, sizeof(arg));
+    arg.pipeline = ctx;
+    arg.appender = rbduckdb_get_struct_appender(appender)->appender;
+    arg.max_chunks = NIL_P(max_chunks) ? (idx_t)-1 : (idx_t)NUM2ULL(max_chunks);
+
+    for (;;) {
+        arg.interrupted = false;
+        rb_thread_call_without_gvl(consume_chunks, &arg, consume_stop, &arg);
+        if (!arg.interrupted) {
+            break;
+        }
+        /* Raises if the interrupt was an exception (e.g. Interrupt, Thread#raise). */
+        rb_thread_check_ints();
+    }
+
+    if (arg.append_failed) {
+        error_data = duckdb_appender_error_data(arg.appender);
+        message = rb_str_new_cstr(error_data && duckdb_error_data_has_error(error_data)
+                                  ? duckdb_error_data_message(error_data)
+                                  : "failed to append_data_chunk");
+        if (error_data) {
+            duckdb_destroy_error_data(&error_data);
+        }
+        rb_raise(eDuckDBError, "%s", StringValueCStr(message));
+    }
+    if (ctx->error[0] != '\0') {
+        rb_raise(eDuckDBError, "%s", ctx->error);
+    }
+
+    return rb_assoc_new(ULL2NUM(arg.chunks), ULL2NUM(arg.rows));
+}
+
+/*
+ * :nodoc:
+ * Stops and joins the pipeline's threads. Must be called before the stream
+ * is released.
+ */
+static VALUE arrow_append_pipeline_close(VALUE self) {
+    rubyDuckDBArrowAppendPipeline *ctx;
+
+    TypedData_Get_Struct(self, rubyDuckDBArrowAppendPipeline, &arrow_append_pipeline_data_type, ctx);
+    pipeline_shutdown(ctx);
+    return Qnil;
+}
+
+void rbduckdb_init_arrow_append_pipeline(void) {
+#if 0
+    VALUE mDuckDB = rb_define_module("DuckDB");
+#endif
+    cDuckDBArrowAppendPipeline = rb_define_class_under(mDuckDB, "ArrowAppendPipeline", rb_cObject);
+    rb_undef_alloc_func(cDuckDBArrowAppendPipeline);
+
+    rb_define_method(cDuckDBArrowAppendPipeline, "append", arrow_append_pipeline_append, -1);
+    rb_define_method(cDuckDBArrowAppendPipeline, "close", arrow_append_pipeline_close, 0);
+
+    rb_define_private_method(cDuckDBConnection, "_arrow_append_pipeline", connection__arrow_append_pipeline, 4);
+}
@@ -0,0 +1,6 @@
+#ifndef RUBY_DUCKDB_ARROW_APPEND_PIPELINE_H
+#define RUBY_DUCKDB_ARROW_APPEND_PIPELINE_H
+
+void rbduckdb_init_arrow_append_pipeline(void);
+
+#endif
@@ -3,24 +3,18 @@
 /*
  * Internal helpers backing DuckDB::Connection#append_arrow. They consume an
  * Arrow producer's struct ArrowArrayStream (given by its address) and convert
- * each chunk into a DuckDB::DataChunk using DuckDB's unstable Arrow C API. The
- * Ruby layer owns the loop, the appender lifecycle, and error handling; these
- * primitives only do the raw-pointer / C-API work.
+ * its schema using DuckDB's unstable Arrow C API. The chunks themselves are
+ * converted and appended by DuckDB::ArrowAppendPipeline (arrow_append_pipeline.c).
  */
 
 static VALUE cDuckDBArrowConvertedSchema;
 
-typedef struct {
-    duckdb_arrow_converted_schema converted_schema;
-} rubyDuckDBArrowConvertedSchema;
-
 static void deallocate(void *ctx);
 static VALUE allocate(VALUE klass);
 static size_t memsize(const void *p);
 static void raise_error_data(duckdb_error_data error_data);
 
 static VALUE connection__arrow_converted_schema(VALUE self, VALUE address);
-static VALUE connection__arrow_next_chunk(VALUE self, VALUE address, VALUE converted);
 static VALUE connection__arrow_release(VALUE self, VALUE address);
 
 static const rb_data_type_t arrow_converted_schema_data_type = {
@@ -47,6 +41,12 @@ static size_t memsize(const void *p) {
     return sizeof(rubyDuckDBArrowConvertedSchema);
 }
 
+rubyDuckDBArrowConvertedSchema *rbduckdb_get_struct_arrow_converted_schema(VALUE obj) {
+    rubyDuckDBArrowConvertedSchema *ctx;
+    TypedData_Get_Struct(obj, rubyDuckDBArrowConvertedSchema, &arrow_converted_schema_data_type, ctx);
+    return ctx;
+}
+
 static void raise_error_data(duckdb_error_data error_data) {
     VALUE message;
 
@@ -102,46 +102,6 @@ static VALUE connection__arrow_converted_schema(VALUE self, VALUE address) {
     return obj;
 }
 
-/* :nodoc: */
-static VALUE connection__arrow_next_chunk(VALUE self, VALUE address, VALUE converted) {
-    rubyDuckDBConnection *ctx;
-    rubyDuckDBArrowConvertedSchema *schema_ctx;
-    struct ArrowArrayStream *stream;
-    struct ArrowArray array;
-    duckdb_data_chunk chunk = NULL;
-    duckdb_error_data error_data;
-    int rc;
-
-    ctx = rbduckdb_get_struct_connection(self);
-    TypedData_Get_Struct(converted, rubyDuckDBArrowConvertedSchema, &arrow_converted_schema_data_type, schema_ctx);
-    stream = stream_from_address(address);
-
-    memset(&array, 0, sizeof(array));
-    rc = stream->get_next(stream, &array);
-    if (rc != 0) {
-        const char *err = stream->get_last_error(stream);
-        rb_raise(eDuckDBError, "failed to get next Arrow chunk: %s", err ? err : "unknown error");
-    }
-    /* End of stream: a released array (release == NULL). */
-    if (array.release == NULL) {
-        return Qnil;
-    }
-
-    /* duckdb_data_chunk_from_arrow takes ownership of the array (nulls its
-     * release). On error before that, we still own it and must release it. */
-    error_data = duckdb_data_chunk_from_arrow(ctx->con, &array, schema_ctx->converted_schema, &chunk);
-    if (error_data != NULL && duckdb_error_data_has_error(error_data)) {
-        if (array.release != NULL) {
-            array.release(&array);
-        }
-        raise_error_data(error_data);
-    } else if (error_data != NULL) {
-        duckdb_destroy_error_data(&error_data);
-    }
-
-    return rbduckdb_create_data_chunk(chunk, true);
-}
-
 /* :nodoc: */
 static VALUE connection__arrow_release(VALUE self, VALUE address) {
     struct ArrowArrayStream *stream = stream_from_address(address);
@@ -160,6 +120,5 @@ void rbduckdb_init_arrow_import(void) {
     rb_define_alloc_func(cDuckDBArrowConvertedSchema, allocate);
 
     rb_define_private_method(cDuckDBConnection, "_arrow_converted_schema", connection__arrow_converted_schema, 1);
-    rb_define_private_method(cDuckDBConnection, "_arrow_next_chunk", connection__arrow_next_chunk, 2);
     rb_define_private_method(cDuckDBConnection, "_arrow_release", connection__arrow_release, 1);
 }
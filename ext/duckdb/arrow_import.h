@@ -1,6 +1,13 @@
 #ifndef RUBY_DUCKDB_ARROW_IMPORT_H
 #define RUBY_DUCKDB_ARROW_IMPORT_H
 
+struct _rubyDuckDBArrowConvertedSchema {
+    duckdb_arrow_converted_schema converted_schema;
+};
+
+typedef struct _rubyDuckDBArrowConvertedSchema rubyDuckDBArrowConvertedSchema;
+
+rubyDuckDBArrowConvertedSchema *rbduckdb_get_struct_arrow_converted_schema(VALUE obj);
 void rbduckdb_init_arrow_import(void);
 
 #endif
@@ -0,0 +1,672 @@
+#include "ruby-duckdb.h"
+
+/*
+ * Backing for DuckDB::Connection#register_arrow. A registered Arrow producer
+ * becomes a table function whose callbacks run in C: each scan opens the
+ * producer's struct ArrowArrayStream, converts its record batches with
+ * DuckDB's Arrow C API and hands the converted vectors to DuckDB by
+ * reference, so the data is never appended into a table first. Only opening
+ * a stream (calling the producer's #arrow_c_stream) needs the GVL.
+ *
+ * Projection pushdown is supported: a scan presents DuckDB with record
+ * batches exposing only the projected children, so unread columns are never
+ * converted.
+ */
+
+static VALUE cDuckDBArrowScan;
+static ID id_arrow_c_stream;
+static ID id_to_i;
+
+#define ARROW_SCAN_NO_COLUMN ((idx_t)-1)
+#define ARROW_SCAN_ERROR_SIZE 512
+
+typedef struct {
+    /* Own connection for the Arrow conversions, independent of the caller's. */
+    duckdb_connection con;
+    duckdb_table_function table_function;
+    VALUE producers;
+    long producer_count;
+    idx_t column_count;
+    char **names;
+    duckdb_logical_type *types;
+    /*
+     * The stream and first chunk read at registration to learn the column
+     * types. They are handed over to the first scan instead of being read
+     * twice.
+     */
+    struct ArrowArrayStream *primed_stream;
+    duckdb_data_chunk primed_chunk;
+    long primed_producer;
+} rubyDuckDBArrowScan;
+
+/* Per-scan state; lives in DuckDB's init data and is freed without the GVL. */
+typedef struct {
+    rubyDuckDBArrowScan *scan;
+    long next_producer;
+    struct ArrowArrayStream *stream;
+    duckdb_arrow_converted_schema converted_schema;
+    idx_t column_count;
+    idx_t projection_count;
+    idx_t *projection;    /* Arrow columns read by this scan */
+    idx_t *projected_map; /* output column -> column of a projected chunk */
+    idx_t *full_map;      /* output column -> column of the (unprojected) primed chunk */
+    duckdb_data_chunk chunk;
+    const idx_t *chunk_map;
+    idx_t chunk_offset;
+} arrow_scan_state;
+
+/* A record batch exposing only the projected children of the producer's batch. */
+typedef struct {
+    struct ArrowArray batch;
+    struct ArrowArray **children;
+} projected_batch;
+
+struct open_stream_arg {
+    arrow_scan_state *state;
+    char *error;
+    int ok;
+};
+
+static void mark(void *ctx);
+static void deallocate(void *ctx);
+static VALUE allocate(VALUE klass);
+static size_t memsize(const void *p);
+static void compact(void *ctx);
+static struct ArrowArrayStream *take_stream(VALUE producer);
+static void release_stream(struct ArrowArrayStream **stream);
+static int check_error_data(duckdb_error_data error_data, char *error);
+static void stream_error(struct ArrowArrayStream *stream, const char *what, char *error);
+static void release_projected_schema(struct ArrowSchema *schema);
+static void release_projected_batch(struct ArrowArray *array);
+static int convert_schema(duckdb_connection con, struct ArrowArrayStream *stream, idx_t column_count, const idx_t *projection, idx_t projection_count, duckdb_arrow_converted_schema *out, char *error);
+static int read_next_chunk(arrow_scan_state *state, char *error);
+static void close_stream(arrow_scan_state *state);
+static void read_names(rubyDuckDBArrowScan *ctx);
+static void prime(rubyDuckDBArrowScan *ctx);
+static void arrow_scan_bind(duckdb_bind_info info);
+static void arrow_scan_init(duckdb_init_info info);
+static void arrow_scan_state_destroy(void *data);
+static VALUE open_stream(VALUE varg);
+static void open_stream_protected(void *user_data);
+static int open_next_stream(arrow_scan_state *state, char *error);
+static void emit_chunk(arrow_scan_state *state, duckdb_data_chunk output);
+static void arrow_scan_execute(duckdb_function_info info, duckdb_data_chunk output);
+static VALUE connection__register_arrow(VALUE self, VALUE name, VALUE producers);
+
+static const rb_data_type_t arrow_scan_data_type = {
+    "DuckDB/ArrowScan",
+    {mark, deallocate, memsize, compact},
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static void mark(void *ctx) {
+    rubyDuckDBArrowScan *p = (rubyDuckDBArrowScan *)ctx;
+    rb_gc_mark(p->producers);
+}
+
+static void deallocate(void *ctx) {
+    rubyDuckDBArrowScan *p = (rubyDuckDBArrowScan *)ctx;
+    idx_t i;
+
+    if (p->primed_chunk) {
+        duckdb_destroy_data_chunk(&(p->primed_chunk));
+    }
+    release_stream(&(p->primed_stream));
+    if (p->types) {
+        for (i = 0; i < p->column_count; i++) {
+            if (p->types[i]) {
+                duckdb_destroy_logical_type(&(p->types[i]));
+            }
+        }
+        xfree(p->types);
+    }
+    if (p->names) {
+        for (i = 0; i < p->column_count; i++) {
+            xfree(p->names[i]);
+        }
+        xfree(p->names);
+    }
+    if (p->table_function) {
+        duckdb_destroy_table_function(&(p->table_function));
+    }
+    if (p->con) {
+        duckdb_disconnect(&(p->con));
+    }
+    xfree(p);
+}
+
+static VALUE allocate(VALUE klass) {
+    rubyDuckDBArrowScan *ctx = xcalloc((size_t)1, sizeof(rubyDuckDBArrowScan));
+    ctx->producers = Qnil;
+    return TypedData_Wrap_Struct(klass, &arrow_scan_data_type, ctx);
+}
+
+static size_t memsize(const void *p) {
+    return sizeof(rubyDuckDBArrowScan);
+}
+
+static void compact(void *ctx) {
+    rubyDuckDBArrowScan *p = (rubyDuckDBArrowScan *)ctx;
+    p->producers = rb_gc_location(p->producers);
+}
+
+/*
+ * Calls producer.arrow_c_stream and moves the stream into malloc'd memory
+ * (the Arrow C stream interface allows a bitwise move), so the scan owns it
+ * independently of the producer's Ruby object.
+ */
+static struct ArrowArrayStream *take_stream(VALUE producer) {
+    VALUE capsule;
+    struct ArrowArrayStream *source;
+    struct ArrowArrayStream *stream;
+
+    capsule = rb_funcall(producer, id_arrow_c_stream, 0);
+    source = (struct ArrowArrayStream *)(uintptr_t)NUM2ULL(rb_funcall(capsule, id_to_i, 0));
+    if (source == NULL || source->release == NULL) {
+        rb_raise(eDuckDBError, "Arrow producer returned a released stream");
+    }
+
+    stream = malloc(sizeof(struct ArrowArrayStream));
+    if (stream == NULL) {
+        rb_raise(rb_eNoMemError, "failed to allocate ArrowArrayStream");
+    }
+    *stream = *source;
+    source->release = NULL;
+
+    RB_GC_GUARD(capsule);
+    return stream;
+}
+
+static void release_stream(struct ArrowArrayStream **stream) {
+    if (*stream == NULL) {
+        return;
+    }
+    if ((*stream)->release != NULL) {
+        (*stream)->release(*stream);
+    }
+    free(*stream);
+    *stream = NULL;
+}
+
+/* Returns 1 if error_data holds no error; otherwise copies its message into error. */
+static int check_error_data(duckdb_error_data error_data, char *error) {
+    int ok = 1;
+
+    if (error_data == NULL) {
+        return ok;
+    }
+    if (duckdb_error_data_has_error(error_data)) {
+        snprintf(error, ARROW_SCAN_ERROR_SIZE, "%s", duckdb_error_data_message(error_data));
+        ok = 0;
+    }
+    duckdb_destroy_error_data(&error_data);
+    return ok;
+}
+
+static void stream_error(struct ArrowArrayStream *stream, const char *what, char *error) {
+    const char *message = stream->get_last_error(stream);
+
+    snprintf(error, ARROW_SCAN_ERROR_SIZE, "%s: %s", what, message ? message : "unknown error");
+}
+
+static void release_projected_schema(struct ArrowSchema *schema) {
+    free(schema->children);
+    schema->children = NULL;
+    schema->release = NULL;
+}
+
+static void release_projected_batch(struct ArrowArray *array) {
+    projected_batch *p = (projected_batch *)array->private_data;
+
+    if (p->batch.release != NULL) {
+        p->batch.release(&(p->batch));
+    }
+    free(p->children);
+    free(p);
+    array->release = NULL;
+}
+
+/* Converts the schema of stream, restricted to the projected columns. */
+static int convert_schema(duckdb_connection con, struct ArrowArrayStream *stream, idx_t column_count, const idx_t *projection, idx_t projection_count, duckdb_arrow_converted_schema *out, char *error) {
+    struct ArrowSchema schema;
+    struct ArrowSchema projected;
+    duckdb_error_data error_data;
+    idx_t i;
+
+    memset(&schema, 0, sizeof(schema));
+    if (stream->get_schema(stream, &schema) != 0) {
+        stream_error(stream, "failed to get Arrow schema", error);
+        return 0;
+    }
+    if ((idx_t)schema.n_children != column_count) {
+        snprintf(error, ARROW_SCAN_ERROR_SIZE, "Arrow stream has %lld columns, expected %llu",
+                 (long long)schema.n_children, (unsigned long long)column_count);
+        schema.release(&schema);
+        return 0;
+    }
+
+    projected = schema;
+    projected.n_children = (int64_t)projection_count;
+    projected.children = malloc(sizeof(struct ArrowSchema *) * projection_count);
+    projected.dictionary = NULL;
+    projected.release = release_projected_schema;
+    projected.private_data = NULL;
+    if (projected.children == NULL) {
+        snprintf(error, ARROW_SCAN_ERROR_SIZE, "failed to allocate Arrow schema");
+        schema.release(&schema);
+        return 0;
+    }
+    for (i = 0; i < projection_count; i++) {
+        projected.children[i] = schema.children[projection[i]];
+    }
+
+    error_data = duckdb_schema_from_arrow(con, &projected, out);
+    projected.release(&projected);
+    schema.release(&schema);
+    return check_error_data(error_data, error);
+}
+
+/*
+ * Reads the next record batch of the scan's stream into state->chunk, which
+ * stays NULL at the end of the stream. Returns 0 on error.
+ */
+static int read_next_chunk(arrow_scan_state *state, char *error) {
+    struct ArrowArray batch;
+    struct ArrowArray projected;
+    projected_batch *holder;
+    duckdb_error_data error_data;
+    idx_t i;
+
+    memset(&batch, 0, sizeof(batch));
+    if (state->stream->get_next(state->stream, &batch) != 0) {
+        stream_error(state->stream, "failed to get next Arrow chunk", error);
+        return 0;
+    }
+    /* End of stream: a released array (release == NULL). */
+    if (batch.release == NULL) {
+        return 1;
+    }
+    if ((idx_t)batch.n_children != state->scan->column_count) {
+        snprintf(error, ARROW_SCAN_ERROR_SIZE, "Arrow chunk has %lld columns, expected %llu",
+                 (long long)batch.n_children, (unsigned long long)state->scan->column_count);
+        batch.release(&batch);
+        return 0;
+    }
+
+    holder = malloc(sizeof(projected_batch));
+    if (holder != NULL) {
+        holder->children = malloc(sizeof(struct ArrowArray *) * state->projection_count);
+    }
+    if (holder == NULL || holder->children == NULL) {
+        free(holder);
+        batch.release(&batch);
+        snprintf(error, ARROW_SCAN_ERROR_SIZE, "failed to allocate Arrow chunk");
+        return 0;
+    }
+    holder->batch = batch;
+    for (i = 0; i < state->projection_count; i++) {
+        holder->children[i] = batch.children[state->projection[i]];
+    }
+
+    projected = batch;
+    projected.n_children = (int64_t)state->projection_count;
+    projected.children = holder->children;
+    projected.dictionary = NULL;
+    projected.release = release_projected_batch;
+    projected.private_data = holder;
+
+    /* duckdb_data_chunk_from_arrow takes ownership of the array (nulls its
+     * release). On error before that, we still own it and must release it. */
+    error_data = duckdb_data_chunk_from_arrow(state->scan->con, &projected, state->converted_schema, &(state->chunk));
+    if (projected.release != NULL) {
+        projected.release(&projected);
+    }
+    if (!check_error_data(error_data, error)) {
+        if (state->chunk) {
+            duckdb_destroy_data_chunk(&(state->chunk));
+        }
+        return 0;
+    }
+    state->chunk_map = state->projected_map;
+    state->chunk_offset = 0;
+    return 1;
+}
+
+static void close_stream(arrow_scan_state *state) {
+    if (state->converted_schema) {
+        duckdb_destroy_arrow_converted_schema(&(state->converted_schema));
+    }
+    release_stream(&(state->stream));
+}
+
+static void read_names(rubyDuckDBArrowScan *ctx) {
+    struct ArrowSchema schema;
+    struct ArrowArrayStream *stream = ctx->primed_stream;
+    const char *name;
+    size_t len;
+    idx_t i;
+
+    memset(&schema, 0, sizeof(schema));
+    if (stream->get_schema(stream, &schema) != 0) {
+        const char *err = stream->get_last_error(stream);
+        rb_raise(eDuckDBError, "failed to get Arrow schema: %s", err ? err : "unknown error");
+    }
+    if (schema.n_children <= 0) {
+        schema.release(&schema);
+        rb_raise(eDuckDBError, "Arrow stream has no columns");
+    }
+
+    ctx->names = xcalloc((size_t)schema.n_children, sizeof(char *));
+    ctx->column_count = (idx_t)schema.n_children;
+    for (i = 0; i < ctx->column_count; i++) {
+        name = schema.children[i]->name;
+        if (name == NULL || name[0] == '\0') {
+            name = "column";
+        }
+        len = strlen(name) + 1;
+        ctx->names[i] = ALLOC_N(char, len);
+        memcpy(ctx->names[i], name, len);
+    }
+    schema.release(&schema);
+}
+
+/*
+ * Reads the first non-empty chunk of the producers to learn the column types,
+ * which the Arrow C API only exposes on converted chunks.
+ */
+static void prime(rubyDuckDBArrowScan *ctx) {
+    arrow_scan_state state;
+    char error[ARROW_SCAN_ERROR_SIZE];
+    VALUE guard;
+    idx_t i;
+    long producer;
+    int ok;
+
+    for (producer = 0; producer < ctx->producer_count && ctx->primed_chunk == NULL; producer++) {
+        ctx->primed_stream = take_stream(rb_ary_entry(ctx->producers, producer));
+        if (ctx->names == NULL) {
+            read_names(ctx);
+        }
+
+        memset(&state, 0, sizeof(state));
+        state.scan = ctx;
+        state.stream = ctx->primed_stream;
+        state.projection_count = ctx->column_count;
+        state.projection = ALLOCV_N(idx_t, guard, ctx->column_count);
+        for (i = 0; i < ctx->column_count; i++) {
+            state.projection[i] = i;
+        }
+
+        ok = convert_schema(ctx->con, state.stream, ctx->column_count, state.projection, state.projection_count, &(state.converted_schema), error);
+        while (ok) {
+            ok = read_next_chunk(&state, error);
+            if (!ok || state.chunk == NULL || duckdb_data_chunk_get_size(state.chunk) > 0) {
+                break;
+            }
+            duckdb_destroy_data_chunk(&(state.chunk));
+        }
+        ALLOCV_END(guard);
+        if (state.converted_schema) {
+            duckdb_destroy_arrow_converted_schema(&(state.converted_schema));
+        }
+        if (!ok) {
+            rb_raise(eDuckDBError, "%s", error);
+        }
+
+        if (state.chunk != NULL) {
+            ctx->primed_chunk = state.chunk;
+            ctx->primed_producer = producer;
+        } else {
+            release_stream(&(ctx->primed_stream));
+        }
+    }
+
+    if (ctx->primed_chunk == NULL) {
+        rb_raise(eDuckDBError, "cannot register an empty Arrow stream: its column types are unknown");
+    }
+
+    ctx->types = xcalloc((size_t)ctx->column_count, sizeof(duckdb_logical_type));
+    for (i = 0; i < ctx->column_count; i++) {
+        ctx->types[i] = duckdb_vector_get_column_type(duckdb_data_chunk_get_vector(ctx->primed_chunk, i));
+    }
+}
+
+static void arrow_scan_bind(duckdb_bind_info info) {
+    rubyDuckDBArrowScan *ctx = (rubyDuckDBArrowScan *)duckdb_bind_get_extra_info(info);
+    idx_t i;
+
+    for (i = 0; i < ctx->column_count; i++) {
+        duckdb_bind_add_result_column(info, ctx->names[i], ctx->types[i]);
+    }
+}
+
+static void arrow_scan_init(duckdb_init_info info) {
+    rubyDuckDBArrowScan *ctx = (rubyDuckDBArrowScan *)duckdb_init_get_extra_info(info);
+    arrow_scan_state *state;
+    idx_t count = duckdb_init_get_column_count(info);
+    idx_t column;
+    idx_t i;
+
+    state = calloc((size_t)1, sizeof(arrow_scan_state));
+    if (state != NULL) {
+        state->projection = calloc((size_t)count + 1, sizeof(idx_t));
+        state->projected_map = calloc((size_t)count + 1, sizeof(idx_t));
+        state->full_map = calloc((size_t)count + 1, sizeof(idx_t));
+    }
+    if (state == NULL || !state->projection || !state->projected_map || !state->full_map) {
+        if (state != NULL) {
+            arrow_scan_state_destroy(state);
+        }
+        duckdb_init_set_error(info, "failed to allocate Arrow scan state");
+        return;
+    }
+
+    state->scan = ctx;
+    state->column_count = count;
+    for (i = 0; i < count; i++) {
+        column = duckdb_init_get_column_index(info, i);
+        if (column < ctx->column_count) {
+            state->projection[state->projection_count] = column;
+            state->projected_map[i] = state->projection_count++;
+            state->full_map[i] = column;
+        } else {
+            state->projected_map[i] = ARROW_SCAN_NO_COLUMN;
+            state->full_map[i] = ARROW_SCAN_NO_COLUMN;
+        }
+    }
+    /* Nothing projected (e.g. count(*)): still read one column for the row counts. */
+    if (state->projection_count == 0) {
+        state->projection[0] = 0;
+        state->projection_count = 1;
+    }
+
+    duckdb_init_set_init_data(info, state, arrow_scan_state_destroy);
+}
+
+static void arrow_scan_state_destroy(void *data) {
+    arrow_scan_state *state = (arrow_scan_state *)data;
+
+    if (state->chunk) {
+        duckdb_destroy_data_chunk(&(state->chunk));
+    }
+    close_stream(state);
+    free(state->projection);
+    free(state->projected_map);
+    free(state->full_map);
+    free(state);
+}
+
+static VALUE open_stream(VALUE varg) {
+    struct open_stream_arg *arg = (struct open_stream_arg *)varg;
+    arrow_scan_state *state = arg->state;
+    rubyDuckDBArrowScan *scan = state->scan;
+
+    if (scan->primed_stream != NULL && state->next_producer <= scan->primed_producer) {
+        state->stream = scan->primed_stream;
+        state->chunk = scan->primed_chunk;
+        state->chunk_map = state->full_map;
+        state->chunk_offset = 0;
+        state->next_producer = scan->primed_producer + 1;
+        scan->primed_stream = NULL;
+        scan->primed_chunk = NULL;
+    } else {
+        state->stream = take_stream(rb_ary_entry(scan->producers, state->next_producer));
+        state->next_producer++;
+    }
+    return Qnil;
+}
+
+static void open_stream_protected(void *user_data) {
+    struct open_stream_arg *arg = (struct open_stream_arg *)user_data;
+    int state = 0;
+
+    rb_protect(open_stream, (VALUE)arg, &state);
+    if (state) {
+        VALUE msg = rbduckdb_pending_error_message();
+        snprintf(arg->error, ARROW_SCAN_ERROR_SIZE, "%s", StringValueCStr(msg));
+        RB_GC_GUARD(msg);
+        arg->ok = 0;
+    }
+}
+
+/* Opens the next producer's stream; only calling the producer needs the GVL. */
+static int open_next_stream(arrow_scan_state *state, char *error) {
+    struct open_stream_arg arg;
+
+    arg.state = state;
+    arg.error = error;
+    arg.ok = 1;
+    rbduckdb_function_executor_dispatch(open_stream_protected, &arg);
+    if (!arg.ok) {
+        return 0;
+    }
+    return convert_schema(state->scan->con, state->stream, state->scan->column_count,
+                          state->projection, state->projection_count, &(state->converted_schema), error);
+}
+
+/*
+ * Hands the current chunk's vectors to DuckDB by reference. A record batch
+ * larger than a vector is handed out in vector-sized slices.
+ */
+static void emit_chunk(arrow_scan_state *state, duckdb_data_chunk output) {
+    idx_t size = duckdb_data_chunk_get_size(state->chunk);
+    idx_t count = size - state->chunk_offset;
+    duckdb_selection_vector sel = NULL;
+    duckdb_vector vector;
+    sel_t *sel_data;
+    idx_t i;
+
+    if (count > duckdb_vector_size()) {
+        count = duckdb_vector_size();
+    }
+    if (count < size) {
+        sel = duckdb_create_selection_vector(count);
+        sel_data = duckdb_selection_vector_get_data_ptr(sel);
+        for (i = 0; i < count; i++) {
+            sel_data[i] = (sel_t)(state->chunk_offset + i);
+        }
+    }
+
+    for (i = 0; i < state->column_count; i++) {
+        if (state->chunk_map[i] == ARROW_SCAN_NO_COLUMN) {
+            continue;
+        }
+        vector = duckdb_data_chunk_get_vector(output, i);
+        duckdb_vector_reference_vector(vector, duckdb_data_chunk_get_vector(state->chunk, state->chunk_map[i]));
+        if (sel != NULL) {
+            duckdb_slice_vector(vector, sel, count);
+        }
+    }
+    if (sel != NULL) {
+        duckdb_destroy_selection_vector(sel);
+    }
+    duckdb_data_chunk_set_size(output, count);
+
+    state->chunk_offset += count;
+    if (state->chunk_offset >= size) {
+        duckdb_destroy_data_chunk(&(state->chunk));
+    }
+}
+
+static void arrow_scan_execute(duckdb_function_info info, duckdb_data_chunk output) {
+    arrow_scan_state *state = (arrow_scan_state *)duckdb_function_get_init_data(info);
+    char error[ARROW_SCAN_ERROR_SIZE];
+
+    while (state->chunk == NULL) {
+        if (state->stream == NULL) {
+            if (state->next_producer >= state->scan->producer_count) {
+                duckdb_data_chunk_set_size(output, 0);
+                return;
+            }
+            if (!open_next_stream(state, error)) {
+                duckdb_function_set_error(info, error);
+                return;
+            }
+            continue;
+        }
+        if (!read_next_chunk(state, error)) {
+            duckdb_function_set_error(info, error);
+            return;
+        }
+        if (state->chunk == NULL) {
+            close_stream(state);
+        } else if (duckdb_data_chunk_get_size(state->chunk) == 0) {
+            duckdb_destroy_data_chunk(&(state->chunk));
+        }
+    }
+    emit_chunk(state, output);
+}
+
+/* :nodoc: */
+static VALUE connection__register_arrow(VALUE self, VALUE name, VALUE producers) {
+    rubyDuckDBConnection *ctxcon;
+    rubyDuckDBArrowScan *ctx;
+    VALUE obj;
+
+    Check_Type(producers, T_ARRAY);
+    ctxcon = rbduckdb_get_struct_connection(self);
+    if (NIL_P(ctxcon->database)) {
+        rb_raise(eDuckDBError, "connection is not associated with a database");
+    }
+
+    obj = allocate(cDuckDBArrowScan);
+    TypedData_Get_Struct(obj, rubyDuckDBArrowScan, &arrow_scan_data_type, ctx);
+    ctx->producers = producers;
+    ctx->producer_count = RARRAY_LEN(producers);
+
+    if (rbduckdb_database_connect(ctxcon->database, &(ctx->con)) == DuckDBError) {
+        rb_raise(eDuckDBError, "failed to connect to the database");
+    }
+    prime(ctx);
+
+    ctx->table_function = duckdb_create_table_function();
+    duckdb_table_function_set_name(ctx->table_function, StringValueCStr(name));
+    duckdb_table_function_set_extra_info(ctx->table_function, ctx, NULL);
+    duckdb_table_function_set_bind(ctx->table_function, arrow_scan_bind);
+    duckdb_table_function_set_init(ctx->table_function, arrow_scan_init);
+    duckdb_table_function_set_function(ctx->table_function, arrow_scan_execute);
+    duckdb_table_function_supports_projection_pushdown(ctx->table_function, true);
+
+    if (duckdb_register_table_function(ctxcon->con, ctx->table_function) == DuckDBError) {
+        rb_raise(eDuckDBError, "Failed to register table function");
+    }
+
+    /* Keep the producers alive as long as the database can scan them. */
+    rbduckdb_database_retain(ctxcon->database, obj);
+    rbduckdb_function_executor_ensure_started();
+
+    return self;
+}
+
+void rbduckdb_init_arrow_scan(void) {
+#if 0
+    VALUE mDuckDB = rb_define_module("DuckDB");
+#endif
+    cDuckDBArrowScan = rb_define_class_under(mDuckDB, "ArrowScan", rb_cObject);
+    rb_undef_alloc_func(cDuckDBArrowScan);
+
+    id_arrow_c_stream = rb_intern("arrow_c_stream");
+    id_to_i = rb_intern("to_i");
+
+    rb_define_private_method(cDuckDBConnection, "_register_arrow", connection__register_arrow, 2);
+}
@@ -0,0 +1,6 @@
+#ifndef RUBY_DUCKDB_ARROW_SCAN_H
+#define RUBY_DUCKDB_ARROW_SCAN_H
+
+void rbduckdb_init_arrow_scan(void);
+
+#endif
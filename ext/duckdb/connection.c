@@ -43,7 +43,11 @@ static VALUE allocate(VALUE klass) {
     return TypedData_Wrap_Struct(klass, &connection_data_type, ctx);
 }
 
-/* Anchors obj to this connection's database so it outlives the connection. */
+/*
+ * Anchors obj to this connection's database so it outlives the connection.
+ * Also restarts the callback executor in a forked child, where a function
+ * built before the fork would otherwise dispatch to threads that are gone.
+ */
 static void connection_retain_registered(VALUE self, VALUE obj) {
     rubyDuckDBConnection *ctx;
 
@@ -52,6 +56,7 @@ static void connection_retain_registered(VALUE self, VALUE obj) {
         rb_raise(eDuckDBError, "connection is not associated with a database");
     }
     rbduckdb_database_retain(ctx->database, obj);
+    rbduckdb_function_executor_ensure_started();
 }
 
 static size_t memsize(const void *p) {
@@ -65,16 +70,13 @@ rubyDuckDBConnection *rbduckdb_get_struct_connection(VALUE obj) {
 }
 
 VALUE rbduckdb_create_connection(VALUE oDuckDBDatabase) {
-    rubyDuckDB *ctxdb;
     rubyDuckDBConnection *ctxcon;
     VALUE obj;
 
-    ctxdb = rbduckdb_get_struct_database(oDuckDBDatabase);
-
     obj = allocate(cDuckDBConnection);
     TypedData_Get_Struct(obj, rubyDuckDBConnection, &connection_data_type, ctxcon);
 
-    if (duckdb_connect(ctxdb->db, &(ctxcon->con)) == DuckDBError) {
+    if (rbduckdb_database_connect(oDuckDBDatabase, &(ctxcon->con)) == DuckDBError) {
         rb_raise(eDuckDBError, "connection error");
     }
     ctxcon->database = oDuckDBDatabase;
@@ -150,16 +152,14 @@ static VALUE connection_query_progress(VALUE self) {
 /* :nodoc: */
 static VALUE connection__connect(VALUE self, VALUE oDuckDBDatabase) {
     rubyDuckDBConnection *ctx;
-    rubyDuckDB *ctxdb;
 
     if (!rb_obj_is_kind_of(oDuckDBDatabase, cDuckDBDatabase)) {
         rb_raise(rb_eTypeError, "The first argument must be DuckDB::Database object.");
     }
-    ctxdb = rbduckdb_get_struct_database(oDuckDBDatabase);
     TypedData_Get_Struct(self, rubyDuckDBConnection, &connection_data_type, ctx);
 
     /* Set only on success: a failed connect must not re-anchor registrations to the new database. */
-    if (duckdb_connect(ctxdb->db, &(ctx->con)) == DuckDBError) {
+    if (rbduckdb_database_connect(oDuckDBDatabase, &(ctx->con)) == DuckDBError) {
         rb_raise(eDuckDBError, "connection error");
     }
     ctx->database = oDuckDBDatabase;
@@ -4,9 +4,6 @@
 extern ID id__to_date;
 extern ID id__to_time;
 extern ID id__to_time_from_duckdb_time;
-extern ID id__to_interval_from_vector;
-extern ID id__to_hugeint_from_vector;
-extern ID id__to_decimal_from_hugeint;
 extern ID id__to_time_from_duckdb_timestamp_s;
 extern ID id__to_time_from_duckdb_timestamp_ms;
 extern ID id__to_time_from_duckdb_timestamp_ns;
@@ -16,6 +13,7 @@ extern ID id__to_time_from_duckdb_timestamp_tz;
 extern ID id__to_infinity;
 extern ID id__decimal_to_unscaled;
 
+void rbduckdb_uuid_to_str(uint64_t hi, uint64_t lo, char *buf);
 VALUE rbduckdb_uuid_to_ruby(duckdb_hugeint h);
 VALUE rbduckdb_uuid_uhugeint_to_ruby(duckdb_uhugeint h);
 void rbduckdb_uuid_str_to_hugeint(VALUE uuid_str, duckdb_hugeint *out);
@@ -23,6 +21,7 @@ void rbduckdb_uuid_str_to_uhugeint(VALUE uuid_str, duckdb_uhugeint *out);
 VALUE rbduckdb_interval_to_ruby(duckdb_interval i);
 VALUE rbduckdb_hugeint_to_ruby(duckdb_hugeint h);
 VALUE rbduckdb_uhugeint_to_ruby(duckdb_uhugeint h);
+VALUE rbduckdb_decimal_to_ruby(duckdb_hugeint unscaled, uint8_t scale);
 VALUE rbduckdb_timestamp_s_to_ruby(duckdb_timestamp_s ts);
 VALUE rbduckdb_timestamp_ms_to_ruby(duckdb_timestamp_ms ts);
 VALUE rbduckdb_timestamp_ns_to_ruby(duckdb_timestamp_ns ts);
@@ -1,13 +1,11 @@
 #include "ruby-duckdb.h"
 
 VALUE mDuckDBConverter;
+static VALUE cDuckDBInterval = Qnil;
 
 ID id__to_date;
 ID id__to_time;
 ID id__to_time_from_duckdb_time;
-ID id__to_interval_from_vector;
-ID id__to_hugeint_from_vector;
-ID id__to_decimal_from_hugeint;
 ID id__to_time_from_duckdb_timestamp_s;
 ID id__to_time_from_duckdb_timestamp_ms;
 ID id__to_time_from_duckdb_timestamp_ns;
@@ -16,6 +14,15 @@ ID id__to_time_from_duckdb_time_tz;
 ID id__to_time_from_duckdb_timestamp_tz;
 ID id__to_infinity;
 ID id__decimal_to_unscaled;
+static ID id_BigDecimal;
+static ID id_mul;
+/* BigDecimal 10 ** -scale for each DECIMAL scale (DuckDB allows up to 38), built once at load. */
+#define DECIMAL_MAX_SCALE 38
+static VALUE decimal_scale_factors = Qnil;
+static ID id_Interval;
+static ID id_iv_interval_months;
+static ID id_iv_interval_days;
+static ID id_iv_interval_micros;
 
 static VALUE infinite_date_value(duckdb_date date) {
     if (duckdb_is_finite_date(date) == false) {
@@ -79,7 +86,7 @@ static VALUE infinite_timestamp_ns_value(duckdb_timestamp_ns timestamp_ns) {
  *   xxxxxxxx - xxxx - xxxx - xxxx - xxxxxxxxxxxx
  *   hi[63:32]  hi[31:16] hi[15:0]  lo[63:48]  lo[47:0]
  */
-static void uuid_to_str(uint64_t hi, uint64_t lo, char *buf)
+void rbduckdb_uuid_to_str(uint64_t hi, uint64_t lo, char *buf)
 {
     static const char hex[] = "0123456789abcdef";
 
@@ -132,13 +139,13 @@ VALUE rbduckdb_uuid_to_ruby(duckdb_hugeint h) {
     // Cast to uint64_t first so all bit manipulation stays unsigned.
     uint64_t hi = (uint64_t)h.upper ^ DUCKDB_UUID_SIGN_BIT;
     uint64_t lo = h.lower;
-    uuid_to_str(hi, lo, buf);
+    rbduckdb_uuid_to_str(hi, lo, buf);
     return rb_utf8_str_new(buf, 36);
 }
 
 VALUE rbduckdb_uuid_uhugeint_to_ruby(duckdb_uhugeint h) {
     char buf[36];
-    uuid_to_str(h.upper, h.lower, buf);
+    rbduckdb_uuid_to_str(h.upper, h.lower, buf);
     return rb_utf8_str_new(buf, 36);
 }
 
@@ -233,26 +240,66 @@ void rbduckdb_uuid_str_to_uhugeint(VALUE uuid_str, duckdb_uhugeint *out)
     out->lower = lo;
 }
 
+/*
+ * Builds DuckDB::Interval directly instead of calling Interval.new with
+ * keyword arguments, which dominates the cost of reading INTERVAL columns.
+ */
 VALUE rbduckdb_interval_to_ruby(duckdb_interval i) {
-    return rb_funcall(mDuckDBConverter, id__to_interval_from_vector, 3,
-                      INT2NUM(i.months),
-                      INT2NUM(i.days),
-                      LL2NUM(i.micros)
-                      );
+    VALUE obj;
+
+    if (NIL_P(cDuckDBInterval)) {
+        cDuckDBInterval = rb_const_get(mDuckDB, id_Interval);
+    }
+    obj = rb_obj_alloc(cDuckDBInterval);
+    rb_ivar_set(obj, id_iv_interval_months, INT2NUM(i.months));
+    rb_ivar_set(obj, id_iv_interval_days, INT2NUM(i.days));
+    rb_ivar_set(obj, id_iv_interval_micros, LL2NUM(i.micros));
+    return obj;
+}
+
+static int hugeint_fits_int64(duckdb_hugeint h) {
+    return (h.upper == 0 && h.lower <= INT64_MAX) || (h.upper == -1 && h.lower > INT64_MAX);
 }
 
 VALUE rbduckdb_hugeint_to_ruby(duckdb_hugeint h) {
-    return rb_funcall(mDuckDBConverter, id__to_hugeint_from_vector, 2,
-                      ULL2NUM(h.lower),
-                      LL2NUM(h.upper)
-                      );
+    uint64_t words[2];
+
+    if (hugeint_fits_int64(h)) {
+        return LL2NUM((int64_t)h.lower);
+    }
+    words[0] = h.lower;
+    words[1] = (uint64_t)h.upper;
+    return rb_integer_unpack(words, 2, sizeof(uint64_t), 0,
+                             INTEGER_PACK_LSWORD_FIRST | INTEGER_PACK_NATIVE_BYTE_ORDER | INTEGER_PACK_2COMP);
 }
 
 VALUE rbduckdb_uhugeint_to_ruby(duckdb_uhugeint h) {
-    return rb_funcall(mDuckDBConverter, id__to_hugeint_from_vector, 2,
-                      ULL2NUM(h.lower),
-                      ULL2NUM(h.upper)
-                      );
+    uint64_t words[2];
+
+    if (h.upper == 0) {
+        return ULL2NUM(h.lower);
+    }
+    words[0] = h.lower;
+    words[1] = h.upper;
+    return rb_integer_unpack(words, 2, sizeof(uint64_t), 0,
+                             INTEGER_PACK_LSWORD_FIRST | INTEGER_PACK_NATIVE_BYTE_ORDER);
+}
+
+/*
+ * Returns the BigDecimal of unscaled * 10 ** -scale: BigDecimal(unscaled),
+ * built from the Integer without a string, times the cached factor of the
+ * scale. BigDecimal multiplication is exact, so no digit is lost.
+ */
+VALUE rbduckdb_decimal_to_ruby(duckdb_hugeint unscaled, uint8_t scale) {
+    VALUE value = rb_funcall(rb_mKernel, id_BigDecimal, 1, rbduckdb_hugeint_to_ruby(unscaled));
+
+    if (scale == 0) {
+        return value;
+    }
+    if (scale > DECIMAL_MAX_SCALE) {
+        rb_raise(eDuckDBError, "DECIMAL scale %u is out of range", (unsigned int)scale);
+    }
+    return rb_funcall(value, id_mul, 1, RARRAY_AREF(decimal_scale_factors, scale));
 }
 
 VALUE rbduckdb_timestamp_s_to_ruby(duckdb_timestamp_s ts) {
@@ -351,14 +398,13 @@ VALUE rbduckdb_timestamp_to_ruby(duckdb_timestamp ts) {
 }
 
 void rbduckdb_init_converter(void) {
+    int i;
+
     mDuckDBConverter = rb_define_module_under(mDuckDB, "Converter");
 
     id__to_date = rb_intern("_to_date");
     id__to_time = rb_intern("_to_time");
     id__to_time_from_duckdb_time = rb_intern("_to_time_from_duckdb_time");
-    id__to_interval_from_vector = rb_intern("_to_interval_from_vector");
-    id__to_hugeint_from_vector = rb_intern("_to_hugeint_from_vector");
-    id__to_decimal_from_hugeint = rb_intern("_to_decimal_from_hugeint");
     id__to_time_from_duckdb_timestamp_s = rb_intern("_to_time_from_duckdb_timestamp_s");
     id__to_time_from_duckdb_timestamp_ms = rb_intern("_to_time_from_duckdb_timestamp_ms");
     id__to_time_from_duckdb_timestamp_ns = rb_intern("_to_time_from_duckdb_timestamp_ns");
@@ -367,4 +413,21 @@ void rbduckdb_init_converter(void) {
     id__to_time_from_duckdb_timestamp_tz = rb_intern("_to_time_from_duckdb_timestamp_tz");
     id__to_infinity = rb_intern("_to_infinity");
     id__decimal_to_unscaled = rb_intern("_decimal_to_unscaled");
+    id_BigDecimal = rb_intern("BigDecimal");
+    id_mul = rb_intern("*");
+    id_Interval = rb_intern("Interval");
+    id_iv_interval_months = rb_intern("@interval_months");
+    id_iv_interval_days = rb_intern("@interval_days");
+    id_iv_interval_micros = rb_intern("@interval_micros");
+
+    rb_gc_register_address(&cDuckDBInterval);
+
+    rb_require("bigdecimal");
+    decimal_scale_factors = rb_ary_new_capa(DECIMAL_MAX_SCALE + 1);
+    for (i = 0; i <= DECIMAL_MAX_SCALE; i++) {
+        rb_ary_push(decimal_scale_factors, rb_funcall(rb_mKernel, id_BigDecimal, 1, rb_sprintf("1e-%d", i)));
+    }
+    /* decoded by results in any Ractor */
+    rb_ractor_make_shareable(decimal_scale_factors);
+    rb_gc_register_address(&decimal_scale_factors);
 }
@@ -2,6 +2,7 @@
 
 VALUE cDuckDBDataChunk;
 extern VALUE cDuckDBVector;
+static ID id_rebind_caches;
 
 static void deallocate(void *ctx);
 static VALUE allocate(VALUE klass);
@@ -12,6 +13,7 @@ static VALUE data_chunk_size(VALUE self);
 static VALUE data_chunk_set_size(VALUE self, VALUE size);
 static VALUE data_chunk_get_vector(VALUE self, VALUE col_idx);
 static VALUE data_chunk__reset(VALUE self);
+static VALUE data_chunk__rebind_vector(VALUE self, VALUE vector, VALUE col_idx);
 
 static const rb_data_type_t data_chunk_data_type = {
     "DuckDB/DataChunk",
@@ -54,6 +56,28 @@ VALUE rbduckdb_create_data_chunk(duckdb_data_chunk chunk, bool owned) {
     return obj;
 }
 
+/*
+ * Re-points a borrowed DataChunk at another chunk, such as the output chunk of
+ * the next table function execute call. DataChunk#rebind_caches then updates
+ * the caches DataChunk#set_value keeps in Ruby.
+ */
+void rbduckdb_data_chunk_rebind(VALUE obj, duckdb_data_chunk chunk) {
+    rubyDuckDBDataChunk *ctx;
+
+    TypedData_Get_Struct(obj, rubyDuckDBDataChunk, &data_chunk_data_type, ctx);
+    ctx->data_chunk = chunk;
+    rb_funcall(obj, id_rebind_caches, 0);
+}
+
+/* :nodoc: */
+static VALUE data_chunk__rebind_vector(VALUE self, VALUE vector, VALUE col_idx) {
+    rubyDuckDBDataChunk *ctx;
+
+    TypedData_Get_Struct(self, rubyDuckDBDataChunk, &data_chunk_data_type, ctx);
+    rbduckdb_get_struct_vector(vector)->vector = duckdb_data_chunk_get_vector(ctx->data_chunk, NUM2ULL(col_idx));
+    return self;
+}
+
 static VALUE data_chunk_initialize(int argc, VALUE *argv, VALUE self) {
     rubyDuckDBDataChunk *ctx;
     VALUE logical_types;
@@ -213,4 +237,7 @@ void rbduckdb_init_data_chunk(void) {
     rb_define_method(cDuckDBDataChunk, "size=", data_chunk_set_size, 1);
     rb_define_method(cDuckDBDataChunk, "get_vector", data_chunk_get_vector, 1);
     rb_define_private_method(cDuckDBDataChunk, "_reset", data_chunk__reset, 0);
+    rb_define_private_method(cDuckDBDataChunk, "_rebind_vector", data_chunk__rebind_vector, 2);
+
+    id_rebind_caches = rb_intern("rebind_caches");
 }
@@ -10,6 +10,7 @@ typedef struct _rubyDuckDBDataChunk rubyDuckDBDataChunk;
 
 rubyDuckDBDataChunk *rbduckdb_get_struct_data_chunk(VALUE obj);
 VALUE rbduckdb_create_data_chunk(duckdb_data_chunk chunk, bool owned);
+void rbduckdb_data_chunk_rebind(VALUE obj, duckdb_data_chunk chunk);
 void rbduckdb_init_data_chunk(void);
 
 #endif
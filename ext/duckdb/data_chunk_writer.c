@@ -0,0 +1,507 @@
+#include "ruby-duckdb.h"
+
+/*
+ * Bulk writers of DuckDB::DataChunk: DataChunk#write_column and
+ * DataChunk#write_rows.
+ *
+ * The logical type of each column is resolved once into a column_plan, then
+ * the values are written with one loop per column into the vector's data,
+ * marking nil values invalid in its validity mask. LIST and STRUCT columns
+ * write their elements and fields into the child vectors recursively.
+ */
+
+static ID id_getlocal;
+static ID id_to_i;
+static ID id_usec;
+static ID id_year;
+static ID id_month;
+static ID id_day;
+static ID id_type_to_sym;
+
+struct column_plan {
+    duckdb_logical_type type;
+    duckdb_type type_id;
+    idx_t child_count;
+    struct column_plan *children;
+    VALUE names; /* STRUCT: [[String, Symbol], ...] of the field names */
+};
+
+/*
+ * Where the values of a column come from: values[i], or the field +column+
+ * of the row values[i]. With keys, that field is read from a Hash row by the
+ * key keys[column], and from a Struct or Data row by the member of that name.
+ */
+struct value_source {
+    VALUE values;
+    long column;
+    VALUE keys;
+};
+
+struct chunk_write {
+    duckdb_data_chunk chunk;
+    VALUE values;
+    VALUE column_positions;
+    VALUE keys;
+    long column;
+    idx_t offset;
+    long count;
+    struct column_plan plan;
+    VALUE keep;
+};
+
+static void plan_init(struct column_plan *plan, duckdb_logical_type type, VALUE keep);
+static void plan_free(struct column_plan *plan);
+static VALUE row_field(VALUE row, long column, VALUE keys);
+static VALUE source_at(const struct value_source *src, long i);
+static void set_null(duckdb_vector vector, uint64_t **validity, idx_t row);
+static VALUE struct_field(struct column_plan *plan, VALUE value, idx_t i);
+static void write_list_values(struct column_plan *plan, duckdb_vector vector, idx_t offset, const struct value_source *src, long count);
+static void write_struct_values(struct column_plan *plan, duckdb_vector vector, idx_t offset, const struct value_source *src, long count);
+static void write_values(struct column_plan *plan, duckdb_vector vector, idx_t offset, const struct value_source *src, long count);
+static void write_chunk_column(struct chunk_write *w, idx_t col_idx, const struct value_source *src);
+static VALUE chunk_write_column_body(VALUE arg);
+static VALUE chunk_write_rows_body(VALUE arg);
+static VALUE chunk_write_cleanup(VALUE arg);
+static void check_capacity(idx_t offset, long count);
+static VALUE data_chunk__write_column(VALUE self, VALUE col_idx, VALUE values, VALUE offset);
+static VALUE data_chunk__write_rows(VALUE self, VALUE rows, VALUE column_positions, VALUE keys);
+
+static void plan_init(struct column_plan *plan, duckdb_logical_type type, VALUE keep) {
+    idx_t i;
+    char *name;
+    VALUE str;
+
+    plan->type = type;
+    plan->type_id = duckdb_get_type_id(type);
+    plan->child_count = 0;
+    plan->children = NULL;
+    plan->names = Qnil;
+
+    switch (plan->type_id) {
+    case DUCKDB_TYPE_LIST:
+        plan->children = ZALLOC_N(struct column_plan, 1);
+        plan->child_count = 1;
+        plan_init(&plan->children[0], duckdb_list_type_child_type(type), keep);
+        break;
+    case DUCKDB_TYPE_STRUCT:
+        plan->names = rb_ary_new();
+        rb_ary_push(keep, plan->names);
+        plan->children = ZALLOC_N(struct column_plan, duckdb_struct_type_child_count(type));
+        plan->child_count = duckdb_struct_type_child_count(type);
+        for (i = 0; i < plan->child_count; i++) {
+            name = duckdb_struct_type_child_name(type, i);
+            str = rb_utf8_str_new_cstr(name);
+            duckdb_free(name);
+            rb_ary_push(plan->names, rb_assoc_new(rb_str_freeze(str), rb_str_intern(str)));
+            plan_init(&plan->children[i], duckdb_struct_type_child_type(type, i), keep);
+        }
+        break;
+    default:
+        break;
+    }
+}
+
+static void plan_free(struct column_plan *plan) {
+    idx_t i;
+
+    if (plan->children) {
+        for (i = 0; i < plan->child_count; i++) {
+            plan_free(&plan->children[i]);
+        }
+        xfree(plan->children);
+        plan->children = NULL;
+    }
+    if (plan->type) {
+        duckdb_destroy_logical_type(&plan->type);
+        plan->type = NULL;
+    }
+}
+
+static VALUE row_field(VALUE row, long column, VALUE keys) {
+    if (NIL_P(keys)) {
+        Check_Type(row, T_ARRAY);
+        return rb_ary_entry(row, column);
+    }
+
+    switch (TYPE(row)) {
+    case T_HASH:
+        return rb_hash_lookup(row, rb_ary_entry(keys, column));
+    case T_STRUCT:
+        return rb_struct_getmember(row, rb_to_id(rb_ary_entry(keys, column)));
+    case T_ARRAY:
+        return rb_ary_entry(row, column);
+    default:
+        rb_raise(rb_eTypeError, "Expected Array, Hash or Struct row, got %"PRIsVALUE, rb_obj_class(row));
+    }
+    return Qnil;
+}
+
+static VALUE source_at(const struct value_source *src, long i) {
+    VALUE value = rb_ary_entry(src->values, i);
+
+    if (src->column < 0) {
+        return value;
+    }
+    return row_field(value, src->column, src->keys);
+}
+
+static void set_null(duckdb_vector vector, uint64_t **validity, idx_t row) {
+    if (*validity == NULL) {
+        duckdb_vector_ensure_validity_writable(vector);
+        *validity = duckdb_vector_get_validity(vector);
+    }
+    duckdb_validity_set_row_invalid(*validity, row);
+}
+
+/*
+ * Writes count values of a fixed-width column, converting each non-nil value
+ * with convert(v).
+ */
+#define WRITE_FIXED(ctype, convert) do { \
+    ctype *data = (ctype *)duckdb_vector_get_data(vector); \
+    for (i = 0; i < count; i++) { \
+        VALUE v = source_at(src, i); \
+        if (NIL_P(v)) { \
+            set_null(vector, &validity, offset + i); \
+            continue; \
+        } \
+        if (validity) duckdb_validity_set_row_valid(validity, offset + i); \
+        data[offset + i] = (ctype)(convert); \
+    } \
+} while (0)
+
+static VALUE time_value(VALUE v) {
+    if (!rb_obj_is_kind_of(v, rb_cTime)) {
+        rb_raise(rb_eTypeError, "Expected Time object");
+    }
+    return v;
+}
+
+static int64_t timestamp_tz_micros(VALUE v) {
+    time_value(v);
+    return NUM2LL(rb_funcall(v, id_to_i, 0)) * 1000000LL + NUM2LL(rb_funcall(v, id_usec, 0));
+}
+
+static duckdb_date date_value(VALUE v) {
+    return rbduckdb_to_duckdb_date_from_value(rb_funcall(v, id_year, 0), rb_funcall(v, id_month, 0), rb_funcall(v, id_day, 0));
+}
+
+static void write_list_values(struct column_plan *plan, duckdb_vector vector, idx_t offset, const struct value_source *src, long count) {
+    duckdb_list_entry *entries = (duckdb_list_entry *)duckdb_vector_get_data(vector);
+    uint64_t *validity = duckdb_vector_get_validity(vector);
+    duckdb_vector child = duckdb_list_vector_get_child(vector);
+    idx_t child_offset = duckdb_list_vector_get_size(vector);
+    struct value_source child_src = { Qnil, -1, Qnil };
+    long i, len;
+    VALUE v;
+
+    for (i = 0; i < count; i++) {
+        v = source_at(src, i);
+        entries[offset + i].offset = child_offset;
+        entries[offset + i].length = 0;
+        if (NIL_P(v)) {
+            set_null(vector, &validity, offset + i);
+            continue;
+        }
+        Check_Type(v, T_ARRAY);
+        if (validity) duckdb_validity_set_row_valid(validity, offset + i);
+
+        len = RARRAY_LEN(v);
+        if (duckdb_list_vector_reserve(vector, child_offset + len) == DuckDBError) {
+            rb_raise(eDuckDBError, "failed to reserve LIST elements");
+        }
+        child_src.values = v;
+        write_values(&plan->children[0], child, child_offset, &child_src, len);
+        entries[offset + i].length = len;
+        child_offset += len;
+        duckdb_list_vector_set_size(vector, child_offset);
+    }
+}
+
+static VALUE struct_field(struct column_plan *plan, VALUE value, idx_t i) {
+    VALUE name;
+    VALUE field;
+
+    if (RB_TYPE_P(value, T_HASH)) {
+        name = RARRAY_AREF(plan->names, i);
+        field = rb_hash_lookup2(value, RARRAY_AREF(name, 0), Qundef);
+        return field == Qundef ? rb_hash_lookup(value, RARRAY_AREF(name, 1)) : field;
+    }
+    if (RB_TYPE_P(value, T_ARRAY)) {
+        return rb_ary_entry(value, (long)i);
+    }
+    rb_raise(rb_eTypeError, "Expected Hash or Array for STRUCT, got %"PRIsVALUE, rb_obj_class(value));
+    return Qnil;
+}
+
+static void write_struct_values(struct column_plan *plan, duckdb_vector vector, idx_t offset, const struct value_source *src, long count) {
+    uint64_t *validity = duckdb_vector_get_validity(vector);
+    struct value_source field_src = { Qnil, -1, Qnil };
+    VALUE fields;
+    VALUE v;
+    idx_t c;
+    long i;
+
+    fields = rb_ary_new_capa(count);
+    field_src.values = fields;
+    for (c = 0; c < plan->child_count; c++) {
+        rb_ary_clear(fields);
+        for (i = 0; i < count; i++) {
+            v = source_at(src, i);
+            rb_ary_push(fields, NIL_P(v) ? Qnil : struct_field(plan, v, c));
+        }
+        write_values(&plan->children[c], duckdb_struct_vector_get_child(vector, c), offset, &field_src, count);
+    }
+
+    for (i = 0; i < count; i++) {
+        if (NIL_P(source_at(src, i))) {
+            set_null(vector, &validity, offset + i);
+        } else if (validity) {
+            duckdb_validity_set_row_valid(validity, offset + i);
+        }
+    }
+    RB_GC_GUARD(fields);
+}
+
+static void write_values(struct column_plan *plan, duckdb_vector vector, idx_t offset, const struct value_source *src, long count) {
+    uint64_t *validity = duckdb_vector_get_validity(vector);
+    VALUE v;
+    VALUE str;
+    long i;
+
+    switch (plan->type_id) {
+    case DUCKDB_TYPE_BOOLEAN:
+        WRITE_FIXED(bool, RTEST(v));
+        break;
+    case DUCKDB_TYPE_TINYINT:
+        WRITE_FIXED(int8_t, NUM2INT(v));
+        break;
+    case DUCKDB_TYPE_SMALLINT:
+        WRITE_FIXED(int16_t, NUM2INT(v));
+        break;
+    case DUCKDB_TYPE_INTEGER:
+        WRITE_FIXED(int32_t, NUM2INT(v));
+        break;
+    case DUCKDB_TYPE_BIGINT:
+        WRITE_FIXED(int64_t, NUM2LL(v));
+        break;
+    case DUCKDB_TYPE_UTINYINT:
+        WRITE_FIXED(uint8_t, NUM2UINT(v));
+        break;
+    case DUCKDB_TYPE_USMALLINT:
+        WRITE_FIXED(uint16_t, NUM2UINT(v));
+        break;
+    case DUCKDB_TYPE_UINTEGER:
+        WRITE_FIXED(uint32_t, NUM2ULL(v));
+        break;
+    case DUCKDB_TYPE_UBIGINT:
+        WRITE_FIXED(uint64_t, NUM2ULL(v));
+        break;
+    case DUCKDB_TYPE_FLOAT:
+        WRITE_FIXED(float, NUM2DBL(v));
+        break;
+    case DUCKDB_TYPE_DOUBLE:
+        WRITE_FIXED(double, NUM2DBL(v));
+        break;
+    case DUCKDB_TYPE_TIMESTAMP:
+        WRITE_FIXED(duckdb_timestamp, rbduckdb_to_duckdb_timestamp_from_time_value(rb_funcall(time_value(v), id_getlocal, 0)));
+        break;
+    case DUCKDB_TYPE_TIMESTAMP_TZ:
+        WRITE_FIXED(int64_t, timestamp_tz_micros(v));
+        break;
+    case DUCKDB_TYPE_DATE:
+        WRITE_FIXED(duckdb_date, date_value(v));
+        break;
+    case DUCKDB_TYPE_VARCHAR:
+    case DUCKDB_TYPE_BLOB:
+        for (i = 0; i < count; i++) {
+            v = source_at(src, i);
+            if (NIL_P(v)) {
+                set_null(vector, &validity, offset + i);
+                continue;
+            }
+            if (validity) duckdb_validity_set_row_valid(validity, offset + i);
+            str = rb_obj_as_string(v);
+            duckdb_vector_assign_string_element_len(vector, offset + i, RSTRING_PTR(str), RSTRING_LEN(str));
+            RB_GC_GUARD(str);
+        }
+        break;
+    case DUCKDB_TYPE_LIST:
+        write_list_values(plan, vector, offset, src, count);
+        break;
+    case DUCKDB_TYPE_STRUCT:
+        write_struct_values(plan, vector, offset, src, count);
+        break;
+    case DUCKDB_TYPE_HUGEINT:
+    case DUCKDB_TYPE_UHUGEINT:
+    case DUCKDB_TYPE_DECIMAL:
+    case DUCKDB_TYPE_UUID:
+    case DUCKDB_TYPE_INTERVAL:
+    case DUCKDB_TYPE_TIME:
+    case DUCKDB_TYPE_TIME_NS:
+    case DUCKDB_TYPE_TIME_TZ:
+    case DUCKDB_TYPE_TIMESTAMP_S:
+    case DUCKDB_TYPE_TIMESTAMP_MS:
+    case DUCKDB_TYPE_TIMESTAMP_NS:
+        for (i = 0; i < count; i++) {
+            v = source_at(src, i);
+            if (!NIL_P(v) && validity) duckdb_validity_set_row_valid(validity, offset + i);
+            rbduckdb_vector_set_value_at(vector, plan->type, offset + i, v);
+        }
+        break;
+    default:
+        rb_raise(rb_eArgError, "Unsupported type for DataChunk bulk writes: %"PRIsVALUE,
+                 rb_funcall(rb_path2class("DuckDB::Converter::IntToSym"), id_type_to_sym, 1, INT2FIX(plan->type_id)));
+        break;
+    }
+}
+
+#undef WRITE_FIXED
+
+static void write_chunk_column(struct chunk_write *w, idx_t col_idx, const struct value_source *src) {
+    duckdb_vector vector = duckdb_data_chunk_get_vector(w->chunk, col_idx);
+
+    plan_init(&w->plan, duckdb_vector_get_column_type(vector), w->keep);
+    write_values(&w->plan, vector, w->offset, src, w->count);
+    plan_free(&w->plan);
+}
+
+static VALUE chunk_write_column_body(VALUE arg) {
+    struct chunk_write *w = (struct chunk_write *)arg;
+    struct value_source src = { w->values, -1, Qnil };
+
+    write_chunk_column(w, (idx_t)w->column, &src);
+    return Qnil;
+}
+
+static VALUE chunk_write_rows_body(VALUE arg) {
+    struct chunk_write *w = (struct chunk_write *)arg;
+    struct value_source src = { w->values, -1, w->keys };
+    idx_t column_count = duckdb_data_chunk_get_column_count(w->chunk);
+    long width = NIL_P(w->column_positions) ? (long)column_count : RARRAY_LEN(w->column_positions);
+    VALUE position;
+    long i;
+
+    if (!NIL_P(w->keys)) {
+        if (NIL_P(w->column_positions) && (idx_t)RARRAY_LEN(w->keys) != column_count) {
+            rb_raise(rb_eArgError, "%ld keys given for %llu columns", RARRAY_LEN(w->keys), (unsigned long long)column_count);
+        }
+        if (RARRAY_LEN(w->keys) < width) {
+            width = RARRAY_LEN(w->keys);
+        }
+    }
+
+    for (i = 0; NIL_P(w->keys) && i < w->count; i++) {
+        VALUE row = rb_ary_entry(w->values, i);
+        Check_Type(row, T_ARRAY);
+        /* The positions only cover the declared columns up to the last one read. */
+        if (RARRAY_LEN(row) < width || (NIL_P(w->column_positions) && RARRAY_LEN(row) != width)) {
+            rb_raise(rb_eArgError, "row %ld has %ld values, expected %ld", i, RARRAY_LEN(row), width);
+        }
+    }
+
+    for (src.column = 0; src.column < width; src.column++) {
+        if (NIL_P(w->column_positions)) {
+            write_chunk_column(w, (idx_t)src.column, &src);
+            continue;
+        }
+        position = rb_ary_entry(w->column_positions, src.column);
+        if (!NIL_P(position)) {
+            write_chunk_column(w, NUM2ULL(position), &src);
+        }
+    }
+    duckdb_data_chunk_set_size(w->chunk, (idx_t)w->count);
+    return Qnil;
+}
+
+static VALUE chunk_write_cleanup(VALUE arg) {
+    struct chunk_write *w = (struct chunk_write *)arg;
+
+    plan_free(&w->plan);
+    return Qnil;
+}
+
+static void check_capacity(idx_t offset, long count) {
+    idx_t capacity = duckdb_vector_size();
+
+    if (offset > capacity || (idx_t)count > capacity - offset) {
+        rb_raise(rb_eArgError, "%ld values from offset %llu exceed the data chunk capacity (%llu)",
+                 count, (unsigned long long)offset, (unsigned long long)capacity);
+    }
+}
+
+/* :nodoc: */
+static VALUE data_chunk__write_column(VALUE self, VALUE col_idx, VALUE values, VALUE offset) {
+    rubyDuckDBDataChunk *ctx = rbduckdb_get_struct_data_chunk(self);
+    struct chunk_write w = {0};
+    long idx = NUM2LONG(col_idx);
+    long off = NUM2LONG(offset);
+
+    Check_Type(values, T_ARRAY);
+    if (idx < 0 || (idx_t)idx >= duckdb_data_chunk_get_column_count(ctx->data_chunk)) {
+        rb_raise(rb_eIndexError, "column index %ld out of range", idx);
+    }
+    if (off < 0) {
+        rb_raise(rb_eArgError, "offset must be non-negative");
+    }
+    check_capacity((idx_t)off, RARRAY_LEN(values));
+
+    w.chunk = ctx->data_chunk;
+    w.values = values;
+    w.column_positions = Qnil;
+    w.keys = Qnil;
+    w.column = idx;
+    w.offset = (idx_t)off;
+    w.count = RARRAY_LEN(values);
+    w.keep = rb_ary_new();
+
+    rb_ensure(chunk_write_column_body, (VALUE)&w, chunk_write_cleanup, (VALUE)&w);
+    RB_GC_GUARD(w.keep);
+    return self;
+}
+
+/* :nodoc: */
+static VALUE data_chunk__write_rows(VALUE self, VALUE rows, VALUE column_positions, VALUE keys) {
+    rubyDuckDBDataChunk *ctx = rbduckdb_get_struct_data_chunk(self);
+    struct chunk_write w = {0};
+
+    Check_Type(rows, T_ARRAY);
+    if (!NIL_P(column_positions)) {
+        Check_Type(column_positions, T_ARRAY);
+    }
+    if (!NIL_P(keys)) {
+        Check_Type(keys, T_ARRAY);
+    }
+    check_capacity(0, RARRAY_LEN(rows));
+
+    w.chunk = ctx->data_chunk;
+    w.values = rows;
+    w.column_positions = column_positions;
+    w.keys = keys;
+    w.column = -1;
+    w.offset = 0;
+    w.count = RARRAY_LEN(rows);
+    w.keep = rb_ary_new();
+
+    rb_ensure(chunk_write_rows_body, (VALUE)&w, chunk_write_cleanup, (VALUE)&w);
+    RB_GC_GUARD(w.keep);
+    return self;
+}
+
+void rbduckdb_init_data_chunk_writer(void) {
+#if 0
+    VALUE mDuckDB = rb_define_module("DuckDB");
+#endif
+    VALUE cDataChunk = rb_define_class_under(mDuckDB, "DataChunk", rb_cObject);
+
+    id_getlocal = rb_intern("getlocal");
+    id_to_i = rb_intern("to_i");
+    id_usec = rb_intern("usec");
+    id_year = rb_intern("year");
+    id_month = rb_intern("month");
+    id_day = rb_intern("day");
+    id_type_to_sym = rb_intern("type_to_sym");
+
+    rb_define_private_method(cDataChunk, "_write_column", data_chunk__write_column, 3);
+    rb_define_private_method(cDataChunk, "_write_rows", data_chunk__write_rows, 3);
+}
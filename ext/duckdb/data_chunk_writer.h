@@ -0,0 +1,6 @@
+#ifndef RUBY_DUCKDB_DATA_CHUNK_WRITER_H
+#define RUBY_DUCKDB_DATA_CHUNK_WRITER_H
+
+void rbduckdb_init_data_chunk_writer(void);
+
+#endif
@@ -2,6 +2,13 @@
 
 VALUE cDuckDBDatabase;
 
+/*
+ * The functions registered on each database, as a WeakKeyMap from the
+ * database to an Array. They are kept out of the database's own references
+ * so that Ractor.make_shareable(db) does not try to share them.
+ */
+static VALUE database_registrations = Qnil;
+
 static void close_database(rubyDuckDB *p);
 static void deallocate(void * ctx);
 static void mark(void *ctx);
@@ -15,24 +22,26 @@ static VALUE database_close(VALUE self);
 static const rb_data_type_t database_data_type = {
     "DuckDB/Database",
     {mark, deallocate, memsize,},
-    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY | RUBY_TYPED_FROZEN_SHAREABLE
 };
 
 static void close_database(rubyDuckDB *p) {
+    rb_nativethread_lock_lock(&p->lock);
     duckdb_close(&(p->db));
+    rb_nativethread_lock_unlock(&p->lock);
 }
 
 static void deallocate(void * ctx) {
     rubyDuckDB *p = (rubyDuckDB *)ctx;
 
     close_database(p);
+    rb_nativethread_lock_destroy(&p->lock);
     xfree(p);
 }
 
 static void mark(void *ctx) {
     rubyDuckDB *p = (rubyDuckDB *)ctx;
 
-    rb_gc_mark(p->registered_functions);
     rb_gc_mark(p->cached_path);
     rb_gc_mark(p->cache_wrappers);
 }
@@ -43,12 +52,12 @@ static size_t memsize(const void *p) {
 
 static VALUE allocate(VALUE klass) {
     rubyDuckDB *ctx = xcalloc((size_t)1, sizeof(rubyDuckDB));
-    VALUE obj = TypedData_Wrap_Struct(klass, &database_data_type, ctx);
-    VALUE registered_functions = rb_ary_new();
-    ctx->registered_functions = registered_functions;
+    VALUE obj;
+
+    rb_nativethread_lock_initialize(&ctx->lock);
+    obj = TypedData_Wrap_Struct(klass, &database_data_type, ctx);
     ctx->cached_path = Qnil;
     ctx->cache_wrappers = Qnil;
-    RB_GC_GUARD(registered_functions);
     return obj;
 }
 
@@ -58,10 +67,15 @@ static VALUE allocate(VALUE klass) {
  * unregister API, so releasing them any earlier leaves a dangling extra_info.
  */
 void rbduckdb_database_retain(VALUE database, VALUE obj) {
-    rubyDuckDB *ctx;
+    VALUE registered;
 
-    TypedData_Get_Struct(database, rubyDuckDB, &database_data_type, ctx);
-    rb_ary_push(ctx->registered_functions, obj);
+    /* Only the main Ractor registers functions, so the map is never shared. */
+    registered = rb_funcall(database_registrations, rb_intern("[]"), 1, database);
+    if (NIL_P(registered)) {
+        registered = rb_ary_new();
+        rb_funcall(database_registrations, rb_intern("[]="), 2, database, registered);
+    }
+    rb_ary_push(registered, obj);
 }
 
 /*
@@ -144,6 +158,21 @@ static VALUE database__initialize(VALUE self, VALUE file, VALUE config) {
     return self;
 }
 
+/*
+ * Connects to the database unless it is closed. Called from any Ractor; the
+ * lock keeps #close from freeing the instance in the middle of the connect.
+ */
+duckdb_state rbduckdb_database_connect(VALUE database, duckdb_connection *con) {
+    rubyDuckDB *ctx;
+    duckdb_state state;
+
+    TypedData_Get_Struct(database, rubyDuckDB, &database_data_type, ctx);
+    rb_nativethread_lock_lock(&ctx->lock);
+    state = duckdb_connect(ctx->db, con);
+    rb_nativethread_lock_unlock(&ctx->lock);
+    return state;
+}
+
 /* :nodoc: */
 static VALUE database__connect(VALUE self) {
     return rbduckdb_create_connection(self);
@@ -154,6 +183,9 @@ static VALUE database__connect(VALUE self) {
  *    duckdb.close -> DuckDB::Database
  *
  *  closes DuckDB database.
+ *
+ *  A database shared with Ractors must stay open until every Ractor is done
+ *  connecting to it: #connect raises DuckDB::Error once it is closed.
  */
 static VALUE database_close(VALUE self) {
     rubyDuckDB *ctx;
@@ -188,4 +220,7 @@ void rbduckdb_init_database(void) {
     rb_define_private_method(cDuckDBDatabase, "_initialize", database__initialize, 2);
     rb_define_private_method(cDuckDBDatabase, "_connect", database__connect, 0);
     rb_define_method(cDuckDBDatabase, "close", database_close, 0);
+
+    database_registrations = rb_class_new_instance(0, NULL, rb_path2class("ObjectSpace::WeakKeyMap"));
+    rb_gc_register_address(&database_registrations);
 }
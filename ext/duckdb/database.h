@@ -3,8 +3,11 @@
 
 struct _rubyDuckDB {
     duckdb_database db;
-    /* Functions and logical types registered on any connection to this database */
-    VALUE registered_functions;
+    /*
+     * Serializes #close against connects: a shared database may be connected
+     * from other Ractors while the main Ractor closes it.
+     */
+    rb_nativethread_lock_t lock;
     /*
      * Set only for a database handed out by DuckDB::InstanceCache: the path it
      * was opened under, and the cache's weak set of live wrappers. Together they
@@ -19,6 +22,7 @@ typedef struct _rubyDuckDB rubyDuckDB;
 
 rubyDuckDB *rbduckdb_get_struct_database(VALUE obj);
 VALUE rbduckdb_create_database_obj(duckdb_database db);
+duckdb_state rbduckdb_database_connect(VALUE database, duckdb_connection *con);
 void rbduckdb_database_retain(VALUE database, VALUE obj);
 void rbduckdb_database_set_cache_entry(VALUE database, VALUE path, VALUE wrappers);
 void rbduckdb_init_database(void);
@@ -41,30 +41,43 @@ Init_duckdb_native(void) {
     rb_define_singleton_method(mDuckDB, "library_version", duckdb_s_library_version, 0);
     rb_define_singleton_method(mDuckDB, "vector_size", duckdb_s_vector_size, 0);
 
+    /*
+     * The methods defined from here to rb_ext_ractor_safe(false) may be
+     * called from any Ractor: they only touch the objects they are called
+     * on and the DuckDB C API, which is thread safe per connection.
+     */
+    rb_ext_ractor_safe(true);
     rbduckdb_init_error();
     rbduckdb_init_database();
     rbduckdb_init_connection();
     rbduckdb_init_result();
+    rbduckdb_init_result_writer();
+    rbduckdb_init_result_buffer();
     rbduckdb_init_column();
+    rbduckdb_init_row();
     rbduckdb_init_logical_type();
     rbduckdb_init_prepared_statement();
     rbduckdb_init_pending_result();
     rbduckdb_init_blob();
-    rbduckdb_init_appender();
     rbduckdb_init_config();
     rbduckdb_init_converter();
     rbduckdb_init_extracted_statements();
+    rb_ext_ractor_safe(false);
+
+    rbduckdb_init_appender();
     rbduckdb_init_instance_cache();
     rbduckdb_init_value();
     rbduckdb_init_scalar_function();
     rbduckdb_init_scalar_function_set();
     rbduckdb_init_aggregate_function();
     rbduckdb_init_aggregate_function_set();
+    rbduckdb_init_aggregate_function_state();
     rbduckdb_init_expression();
     rbduckdb_init_client_context();
     rbduckdb_init_scalar_function_bind_info();
     rbduckdb_init_vector();
     rbduckdb_init_data_chunk();
+    rbduckdb_init_data_chunk_writer();
     rbduckdb_init_memory_helper();
     rbduckdb_init_table_function();
     rbduckdb_init_table_function_bind_info();
@@ -75,4 +88,6 @@ Init_duckdb_native(void) {
 #endif
     rbduckdb_init_arrow_array_stream();
     rbduckdb_init_arrow_import();
+    rbduckdb_init_arrow_scan();
+    rbduckdb_init_arrow_append_pipeline();
 }
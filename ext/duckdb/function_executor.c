@@ -10,8 +10,10 @@
  */
 #ifdef _MSC_VER
 #include <windows.h>
+#define RBDUCKDB_THREAD_LOCAL __declspec(thread)
 #else
 #include <pthread.h>
+#define RBDUCKDB_THREAD_LOCAL __thread
 #endif
 
 /*
@@ -76,6 +78,28 @@ static int g_executor_started = 0;
  */
 static VALUE g_proxy_threads = Qnil;
 
+/*
+ * Proxy-thread pool (see "Proxy-thread pool" below). Each native thread takes
+ * the next slot on its first callback; the slot lock serializes the threads
+ * sharing a slot, since a proxy runs one request at a time. It is not held
+ * while the slot's proxy is being created.
+ */
+#define RBDUCKDB_PROXY_POOL_SIZE 16
+
+struct proxy_pool_slot {
+    struct worker_proxy *proxy;
+    int create_failed;
+#ifdef _MSC_VER
+    CRITICAL_SECTION lock;
+#else
+    pthread_mutex_t lock;
+#endif
+};
+
+static struct proxy_pool_slot g_proxy_pool[RBDUCKDB_PROXY_POOL_SIZE];
+static unsigned int g_proxy_pool_next_slot = 0;
+static RBDUCKDB_THREAD_LOCAL int t_proxy_pool_slot = -1;
+
 /*
  * Replace embedded NUL bytes so the message can be handed to a C API.
  * Returns str unchanged when there is nothing to replace.
@@ -241,7 +265,40 @@ static VALUE executor_thread_func(void *data) {
     return Qnil;
 }
 
+/* Empties every pool slot; its proxy is created again on first use. */
+static void proxy_pool_reset(void) {
+    int i;
+
+    for (i = 0; i < RBDUCKDB_PROXY_POOL_SIZE; i++) {
+        g_proxy_pool[i].proxy = NULL;
+        g_proxy_pool[i].create_failed = 0;
+#ifdef _MSC_VER
+        InitializeCriticalSection(&g_proxy_pool[i].lock);
+#else
+        pthread_mutex_init(&g_proxy_pool[i].lock, NULL);
+#endif
+    }
+}
+
+#ifdef HAVE_FORK
+/*
+ * Only the forking thread survives fork(): in the child the executor and every
+ * proxy thread are gone, and a lock one of them held stays locked. Reset the
+ * dispatcher so that the next ensure_started builds it afresh. The parent's
+ * proxies are not freed, as nothing in the child can join their threads.
+ */
+static void function_executor_atfork_child(void) {
+    pthread_mutex_init(&g_executor_mutex, NULL);
+    pthread_cond_init(&g_executor_cond, NULL);
+    g_request_list = NULL;
+    g_executor_started = 0;
+    proxy_pool_reset();
+}
+#endif
+
 void rbduckdb_function_executor_ensure_started(void) {
+    static int registered = 0;
+
     if (g_executor_started) return;
 
 #ifdef _MSC_VER
@@ -252,16 +309,31 @@ void rbduckdb_function_executor_ensure_started(void) {
     }
 #endif
 
-    if (g_proxy_threads == Qnil) {
-        g_proxy_threads = rb_ary_new();
-        rb_global_variable(&g_proxy_threads);
+    /* No DuckDB thread can dispatch before a function is registered, so the
+     * pool is set up before anything reads it. */
+    proxy_pool_reset();
+
+    if (!registered) {
+        if (g_proxy_threads == Qnil) {
+            g_proxy_threads = rb_ary_new();
+            rb_global_variable(&g_proxy_threads);
+        }
+        rb_global_variable(&g_executor_thread);
+#ifdef HAVE_FORK
+        pthread_atfork(NULL, NULL, function_executor_atfork_child);
+#endif
+        registered = 1;
     }
 
     g_executor_thread = rb_thread_create(executor_thread_func, NULL);
-    rb_global_variable(&g_executor_thread);
     g_executor_started = 1;
 }
 
+/* The global executor's Ruby thread, or nil before it is started. */
+VALUE rbduckdb_function_executor_thread(void) {
+    return g_executor_thread;
+}
+
 /*
  * Dispatch a callback to the global executor thread.
  * Called from a DuckDB worker thread (non-Ruby thread).
@@ -639,6 +711,119 @@ void rbduckdb_worker_proxy_destroy(void *data) {
     free(proxy);
 }
 
+/*
+ * ============================================================================
+ * Proxy-thread pool
+ * ============================================================================
+ *
+ * Callbacks without a per-worker proxy of their own (aggregate callbacks,
+ * Arrow scans, destructors, and every callback on DuckDB < 1.5.0) would all
+ * queue on the single global executor, serializing every DuckDB worker thread.
+ * They go to a fixed-size pool of proxies instead: each native thread is
+ * assigned a slot on its first callback and keeps it, and the slot's proxy is
+ * created on first use through the global executor. Up to
+ * RBDUCKDB_PROXY_POOL_SIZE worker threads thus get a Ruby thread each; pool
+ * proxies live for the rest of the process.
+ */
+struct proxy_pool_create_arg {
+    struct worker_proxy *proxy;
+};
+
+static VALUE proxy_pool_create_body(VALUE data) {
+    struct proxy_pool_create_arg *arg = (struct proxy_pool_create_arg *)data;
+    arg->proxy = rbduckdb_worker_proxy_create();
+    return Qnil;
+}
+
+/* Runs on the global executor. A failed create leaves arg->proxy NULL. */
+static void proxy_pool_create(void *data) {
+    int state = 0;
+
+    rb_protect(proxy_pool_create_body, (VALUE)data, &state);
+    if (state) {
+        rb_set_errinfo(Qnil);
+    }
+}
+
+static int proxy_pool_slot_index(void) {
+    if (t_proxy_pool_slot < 0) {
+#ifdef _MSC_VER
+        EnterCriticalSection(&g_executor_lock);
+        t_proxy_pool_slot = (int)(g_proxy_pool_next_slot++ % RBDUCKDB_PROXY_POOL_SIZE);
+        LeaveCriticalSection(&g_executor_lock);
+#else
+        pthread_mutex_lock(&g_executor_mutex);
+        t_proxy_pool_slot = (int)(g_proxy_pool_next_slot++ % RBDUCKDB_PROXY_POOL_SIZE);
+        pthread_mutex_unlock(&g_executor_mutex);
+#endif
+    }
+    return t_proxy_pool_slot;
+}
+
+/*
+ * Run a callback on the calling native thread's pool proxy, falling back to
+ * the global executor when the proxy cannot be created or its Ruby thread has
+ * exited (VM shutdown or Thread#kill).
+ */
+static void dispatch_callback_to_pool(rbduckdb_function_callback_t cb, void *user_data) {
+    struct proxy_pool_slot *slot = &g_proxy_pool[proxy_pool_slot_index()];
+    struct worker_proxy *spare = NULL;
+    int create;
+
+#ifdef _MSC_VER
+    EnterCriticalSection(&slot->lock);
+#else
+    pthread_mutex_lock(&slot->lock);
+#endif
+    create = slot->proxy == NULL && !slot->create_failed;
+#ifdef _MSC_VER
+    LeaveCriticalSection(&slot->lock);
+#else
+    pthread_mutex_unlock(&slot->lock);
+#endif
+
+    /*
+     * Create the proxy without the slot lock, so the threads sharing the slot
+     * do not queue behind the executor; the first to publish its proxy wins.
+     */
+    if (create) {
+        struct proxy_pool_create_arg arg;
+
+        arg.proxy = NULL;
+        dispatch_callback_to_executor(proxy_pool_create, &arg);
+        spare = arg.proxy;
+    }
+
+#ifdef _MSC_VER
+    EnterCriticalSection(&slot->lock);
+#else
+    pthread_mutex_lock(&slot->lock);
+#endif
+
+    if (create && slot->proxy == NULL && !slot->create_failed) {
+        slot->proxy = spare;
+        slot->create_failed = (spare == NULL);
+        spare = NULL;
+    }
+
+    if (slot->proxy != NULL && !slot->proxy->thread_exited) {
+        dispatch_callback_to_proxy(slot->proxy, cb, user_data);
+    } else {
+        dispatch_callback_to_executor(cb, user_data);
+    }
+
+#ifdef _MSC_VER
+    LeaveCriticalSection(&slot->lock);
+#else
+    pthread_mutex_unlock(&slot->lock);
+#endif
+
+    /* Another thread published its proxy first. */
+    if (spare != NULL) {
+        rbduckdb_worker_proxy_destroy(spare);
+    }
+}
+
 void rbduckdb_function_executor_dispatch_via_proxy(rbduckdb_function_callback_t cb, void *user_data, struct worker_proxy *proxy) {
     if (ruby_native_thread_p()) {
         if (ruby_thread_has_gvl_p()) {
@@ -655,8 +840,8 @@ void rbduckdb_function_executor_dispatch_via_proxy(rbduckdb_function_callback_t
         /* Case 3a: Non-Ruby thread with a per-worker proxy */
         dispatch_callback_to_proxy(proxy, cb, user_data);
     } else {
-        /* Case 3b: Non-Ruby thread - dispatch to the global executor */
-        dispatch_callback_to_executor(cb, user_data);
+        /* Case 3b: Non-Ruby thread - dispatch to its pool proxy */
+        dispatch_callback_to_pool(cb, user_data);
     }
 }
 
@@ -699,3 +884,27 @@ void rbduckdb_function_data_destroy(void *data) {
     if (data == NULL) return;
     rbduckdb_function_executor_dispatch(rbduckdb_function_data_release, data);
 }
+
+struct function_data_copy_arg {
+    void *data;
+    void *copy;
+};
+
+static void function_data_copy(void *user_data) {
+    struct function_data_copy_arg *arg = (struct function_data_copy_arg *)user_data;
+    arg->copy = rbduckdb_function_data_register(rbduckdb_function_data_lookup(arg->data));
+}
+
+/*
+ * Registers the object behind +data+ under a new handle, for DuckDB copy
+ * callbacks: each copy of the bind data is destroyed separately.
+ */
+void *rbduckdb_function_data_copy(void *data) {
+    struct function_data_copy_arg arg;
+
+    if (data == NULL) return NULL;
+    arg.data = data;
+    arg.copy = NULL;
+    rbduckdb_function_executor_dispatch(function_data_copy, &arg);
+    return arg.copy;
+}
@@ -7,8 +7,10 @@
  * DuckDB invokes UDF callbacks from its own worker threads, which are NOT
  * Ruby threads. Ruby's GVL cannot be acquired from a non-Ruby thread via
  * rb_thread_call_with_gvl (it crashes with rb_bug). This module provides
- * a dispatcher that routes callbacks to a single global "executor" Ruby
- * thread, so that the GVL can be obtained safely.
+ * a dispatcher that routes callbacks to Ruby proxy threads (a pool keyed by
+ * the calling native thread, or a per-worker proxy), so that the GVL can be
+ * obtained safely. A single global "executor" Ruby thread creates the pool
+ * proxies and is the fallback when one cannot be created.
  *
  * Both ScalarFunction and AggregateFunction (future) share this
  * infrastructure.
@@ -25,20 +27,24 @@
 typedef void (*rbduckdb_function_callback_t)(void *user_data);
 
 /*
- * Start the global executor thread (idempotent).
+ * Start the global executor thread and set up the proxy-thread pool
+ * (idempotent; after fork() the child starts them again).
  *
  * Must be called from a Ruby thread (GVL held). The GVL serializes calls,
  * so the internal check-then-set is safe without an additional mutex.
  */
 void rbduckdb_function_executor_ensure_started(void);
 
+/* The global executor's Ruby thread, or nil before it is started. */
+VALUE rbduckdb_function_executor_thread(void);
+
 /*
  * Dispatch a callback for execution with the GVL held. Automatically
  * selects one of three paths:
  *
  *   1. Called from a Ruby thread with GVL    -> invoke directly
  *   2. Called from a Ruby thread without GVL -> rb_thread_call_with_gvl
- *   3. Called from a non-Ruby thread         -> enqueue to executor thread
+ *   3. Called from a non-Ruby thread         -> hand to the thread's pool proxy
  *
  * Blocks until the callback returns.
  */
@@ -49,14 +55,15 @@ void rbduckdb_function_executor_dispatch(rbduckdb_function_callback_t cb, void *
  * Per-worker proxy threads (DuckDB >= 1.5.0)
  * ============================================================================
  *
- * The global executor above serializes every non-Ruby-thread callback through
- * a single Ruby thread. A per-worker proxy instead gives each DuckDB worker
- * thread its own dedicated Ruby thread, so callbacks from different workers can
- * run concurrently — they compete for the GVL in round-robin fashion, which
- * helps when callbacks release the GVL (e.g. on I/O).
+ * A per-worker proxy gives each DuckDB worker thread its own dedicated Ruby
+ * thread, so callbacks from different workers can run concurrently — they
+ * compete for the GVL in round-robin fashion, which helps when callbacks
+ * release the GVL (e.g. on I/O). The proxy-thread pool behind
+ * rbduckdb_function_executor_dispatch does the same for callbacks that have no
+ * per-worker hook, with a fixed number of proxies shared by all functions.
  *
  * Proxies are created lazily from DuckDB's per-worker init hook and stored in
- * DuckDB's thread-local state; the global executor remains the fallback.
+ * DuckDB's thread-local state; the proxy-thread pool remains the fallback.
  */
 
 /* Opaque per-worker proxy handle. */
@@ -82,7 +89,7 @@ void rbduckdb_worker_proxy_destroy(void *proxy);
 /*
  * Like rbduckdb_function_executor_dispatch, but on the non-Ruby-thread path
  * (Case 3) it routes through the given per-worker proxy when non-NULL, falling
- * back to the global executor when NULL. Cases 1 and 2 are unchanged.
+ * back to the proxy-thread pool when NULL. Cases 1 and 2 are unchanged.
  */
 void rbduckdb_function_executor_dispatch_via_proxy(rbduckdb_function_callback_t cb, void *user_data, struct worker_proxy *proxy);
 
@@ -98,5 +105,6 @@ void *rbduckdb_function_data_register(VALUE value);
 VALUE rbduckdb_function_data_lookup(void *data);
 void rbduckdb_function_data_release(void *data);
 void rbduckdb_function_data_destroy(void *data);
+void *rbduckdb_function_data_copy(void *data);
 
 #endif
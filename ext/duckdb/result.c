@@ -1,10 +1,102 @@
 #include "ruby-duckdb.h"
+#include "ruby/encoding.h"
 
+enum decimal_conversion {
+    DECIMAL_AS_BIGDECIMAL,
+    DECIMAL_AS_FLOAT,
+    DECIMAL_AS_RATIONAL,
+    DECIMAL_AS_INTEGER_CENTS
+};
+
+/* Options read from DuckDB.enum_as and DuckDB.decimal_as once per stream. */
+struct decode_options {
+    bool enum_as_symbol;
+    enum decimal_conversion decimal_as;
+    VALUE constants;
+};
+
+/*
+ * Decoder of a column, built once per result stream. Nested types hold one
+ * child decoder per child type (LIST/ARRAY: the element, MAP: key and
+ * value, STRUCT/UNION: each member), and ENUM dictionaries, STRUCT keys and
+ * DECIMAL denominators are converted to Ruby objects up front. The vector
+ * fields are resolved once per chunk by column_decoder_set_vector.
+ */
+struct column_decoder {
+    duckdb_logical_type type;
+    duckdb_type type_id;
+    duckdb_type enum_internal_type;
+    VALUE enum_values;
+    duckdb_type decimal_internal_type;
+    uint8_t decimal_width;
+    uint8_t decimal_scale;
+    enum decimal_conversion decimal_as;
+    VALUE decimal_denominator;
+    VALUE keys;
+    idx_t array_size;
+    idx_t child_count;
+    struct column_decoder *children;
+    duckdb_vector vector;
+    void *data;
+    uint64_t *validity;
+    uint8_t *union_tags;
+    uint64_t bound_serial;
+};
+
+/*
+ * The decoders of all columns of a result stream. It is a hidden Ruby
+ * object so that lazily decoded DuckDB::Row objects can keep it alive.
+ */
+struct decode_plan {
+    idx_t col_count;
+    struct column_decoder *decoders;
+    VALUE constants;
+    VALUE names;
+    uint64_t next_chunk_serial;
+};
+
+/*
+ * A data chunk fetched for DuckDB::Row. Rows reference the chunk, so a row
+ * that outlives the iteration keeps its chunk (not a copy) alive.
+ */
+struct result_chunk {
+    VALUE plan;
+    duckdb_data_chunk chunk;
+    idx_t size;
+    uint64_t serial;
+    size_t memsize;
+};
+
+/*
+ * The position of Result#fetch. The partially read chunk is kept between
+ * calls, so paging through a result reads each chunk once.
+ */
+struct result_cursor {
+    VALUE plan;
+    VALUE chunk;
+    idx_t row_idx;
+};
+
+/*
+ * keys: nil to build Array rows, or the Hash keys of the columns.
+ * rows: nil to yield each row, or the Array collecting the rows.
+ */
 struct chunk_arg {
+    rubyDuckDBResult *ctx;
+    struct decode_plan *plan;
     duckdb_data_chunk chunk;
-    idx_t col_count;
+    VALUE keys;
+    VALUE rows;
 };
 
+static ID id_enum_as;
+static ID id_symbol;
+static ID id_decimal_as;
+static ID id_float;
+static ID id_rational;
+static ID id_integer_cents;
+static ID id_cursor;
+
 static VALUE cDuckDBResult;
 
 static void deallocate(void *ctx);
@@ -16,8 +108,53 @@ static VALUE result_columns(VALUE oDuckDBResult);
 static VALUE destroy_data_chunk(VALUE arg);
 
 static VALUE result__chunk_stream(VALUE oDuckDBResult);
+static VALUE result__hash_stream(VALUE oDuckDBResult, VALUE symbolize);
+static VALUE result__to_hashes(VALUE oDuckDBResult, VALUE symbolize);
+static VALUE stream_rows(VALUE oDuckDBResult, bool as_hash, bool symbolize, VALUE rows);
 static VALUE result_arrow_c_stream(VALUE oDuckDBResult);
 static VALUE yield_rows(VALUE arg);
+static VALUE decode_row(struct decode_plan *plan, idx_t row_idx, VALUE keys);
+static void result_chunk_bind(struct result_chunk *c);
+static void result_cursor_mark(void *p);
+static size_t result_cursor_memsize(const void *p);
+static struct result_cursor *result_cursor_of(VALUE oDuckDBResult, bool create);
+static VALUE result_cursor_chunk(rubyDuckDBResult *ctx, struct result_cursor *cursor);
+static void drain_cursor(VALUE oDuckDBResult, VALUE keys, VALUE rows, bool as_row);
+static bool cursor_pending(VALUE oDuckDBResult);
+static VALUE result_fetch(VALUE oDuckDBResult, VALUE count);
+static VALUE result_fetch_chunk(VALUE oDuckDBResult);
+static VALUE result_rewind_p(VALUE oDuckDBResult);
+static VALUE stream_chunks(VALUE arg);
+static VALUE release_decode_plan(VALUE arg);
+static VALUE result__row_stream(VALUE oDuckDBResult);
+static void decode_plan_mark(void *p);
+static void decode_plan_free(void *p);
+static size_t decode_plan_memsize(const void *p);
+static void decode_plan_release(struct decode_plan *plan);
+static VALUE decode_plan_new(rubyDuckDBResult *ctx);
+static struct decode_plan *get_struct_decode_plan(VALUE obj);
+static void result_chunk_mark(void *p);
+static void result_chunk_free(void *p);
+static size_t result_chunk_memsize(const void *p);
+static VALUE result_chunk_new(VALUE plan, duckdb_data_chunk chunk);
+static struct result_chunk *get_struct_result_chunk(VALUE obj);
+static void decode_options_init(struct decode_options *options, VALUE constants);
+static void column_decoder_init(struct column_decoder *decoder, duckdb_logical_type ty, struct decode_options *options);
+static void column_decoder_init_decimal(struct column_decoder *decoder, struct decode_options *options);
+static void column_decoder_init_children(struct column_decoder *decoder, struct decode_options *options);
+static void column_decoder_destroy(struct column_decoder *decoder);
+static void column_decoder_set_vector(struct column_decoder *decoder, duckdb_vector vector);
+static VALUE column_decoder_value(struct column_decoder *decoder, idx_t row_idx);
+static VALUE decode_list(struct column_decoder *decoder, idx_t row_idx);
+static VALUE decode_array(struct column_decoder *decoder, idx_t row_idx);
+static VALUE decode_map(struct column_decoder *decoder, idx_t row_idx);
+static VALUE decode_struct(struct column_decoder *decoder, idx_t row_idx);
+static VALUE decode_decimal(struct column_decoder *decoder, idx_t row_idx);
+static duckdb_hugeint decimal_unscaled_at(duckdb_type internal_type, void *vector_data, idx_t row_idx);
+static VALUE struct_keys(duckdb_logical_type ty, idx_t child_count);
+static VALUE enum_dictionary(duckdb_logical_type ty, bool symbolize);
+static uint32_t enum_code_at(duckdb_type internal_type, void *vector_data, idx_t row_idx);
+static VALUE vector_value_of_type(duckdb_type type_id, duckdb_logical_type ty, duckdb_vector vector, void *vector_data, idx_t index);
 static VALUE result__return_type(VALUE oDuckDBResult);
 static VALUE result__statement_type(VALUE oDuckDBResult);
 static VALUE result__enum_internal_type(VALUE oDuckDBResult, VALUE col_idx);
@@ -46,7 +183,6 @@ static VALUE vector_bit(void* vector_data, idx_t row_idx);
 static VALUE vector_time_tz(void* vector_data, idx_t row_idx);
 static VALUE vector_timestamp_tz(void* vector_data, idx_t row_idx);
 static VALUE vector_uuid(void* vector_data, idx_t row_idx);
-static VALUE vector_value(duckdb_vector vector, idx_t row_idx);
 
 static const rb_data_type_t result_data_type = {
     "DuckDB/Result",
@@ -54,6 +190,24 @@ static const rb_data_type_t result_data_type = {
     0, 0, RUBY_TYPED_FREE_IMMEDIATELY
 };
 
+static const rb_data_type_t decode_plan_data_type = {
+    "DuckDB/Result/DecodePlan",
+    {decode_plan_mark, decode_plan_free, decode_plan_memsize,},
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static const rb_data_type_t result_chunk_data_type = {
+    "DuckDB/Result/Chunk",
+    {result_chunk_mark, result_chunk_free, result_chunk_memsize,},
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static const rb_data_type_t result_cursor_data_type = {
+    "DuckDB/Result/Cursor",
+    {result_cursor_mark, RUBY_TYPED_DEFAULT_FREE, result_cursor_memsize,},
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
 static void deallocate(void *ctx) {
     rubyDuckDBResult *p = (rubyDuckDBResult *)ctx;
 
@@ -91,6 +245,16 @@ rubyDuckDBResult *rbduckdb_get_struct_result(VALUE obj) {
     return ctx;
 }
 
+/*
+ * Fetches the next chunk of the result, or NULL at the end. Every reader
+ * of the result fetches through here so that #rewind? knows whether a row
+ * has been read. It calls no Ruby API and may run without the GVL.
+ */
+duckdb_data_chunk rbduckdb_result_fetch_chunk(rubyDuckDBResult *ctx) {
+    ctx->fetched = true;
+    return duckdb_fetch_chunk(ctx->result);
+}
+
 /*
  *  call-seq:
  *    result.rows_changed -> integer
@@ -173,44 +337,843 @@ static VALUE destroy_data_chunk(VALUE arg) {
 
 /* :nodoc: */
 static VALUE result__chunk_stream(VALUE oDuckDBResult) {
+    RETURN_ENUMERATOR(oDuckDBResult, 0, 0);
+
+    return stream_rows(oDuckDBResult, false, false, Qnil);
+}
+
+/* :nodoc: */
+static VALUE result__hash_stream(VALUE oDuckDBResult, VALUE symbolize) {
+    return stream_rows(oDuckDBResult, true, RTEST(symbolize), Qnil);
+}
+
+/* :nodoc: */
+static VALUE result__to_hashes(VALUE oDuckDBResult, VALUE symbolize) {
+    return stream_rows(oDuckDBResult, true, RTEST(symbolize), rb_ary_new());
+}
+
+static VALUE stream_rows(VALUE oDuckDBResult, bool as_hash, bool symbolize, VALUE rows) {
     rubyDuckDBResult *ctx;
     struct chunk_arg arg;
+    struct decode_plan *p;
+    VALUE plan;
+    VALUE keys = Qnil;
+    idx_t col_idx;
+
+    TypedData_Get_Struct(oDuckDBResult, rubyDuckDBResult, &result_data_type, ctx);
+
+    plan = decode_plan_new(ctx);
+    p = get_struct_decode_plan(plan);
+
+    if (as_hash) {
+        keys = p->names;
+        if (symbolize) {
+            keys = rb_ary_new_capa(p->col_count);
+            for (col_idx = 0; col_idx < p->col_count; col_idx++) {
+                rb_ary_push(keys, rb_str_intern(RARRAY_AREF(p->names, col_idx)));
+            }
+        }
+    }
+
+    arg.ctx = ctx;
+    arg.plan = p;
+    arg.chunk = NULL;
+    arg.keys = keys;
+    arg.rows = rows;
+
+    drain_cursor(oDuckDBResult, keys, rows, false);
+    rb_ensure(stream_chunks, (VALUE)&arg, release_decode_plan, (VALUE)&arg);
+
+    RB_GC_GUARD(plan);
+    RB_GC_GUARD(keys);
+    RB_GC_GUARD(oDuckDBResult);
+    return NIL_P(rows) ? Qnil : rows;
+}
+
+static VALUE stream_chunks(VALUE arg) {
+    struct chunk_arg *p = (struct chunk_arg *)arg;
+
+    while((p->chunk = rbduckdb_result_fetch_chunk(p->ctx)) != NULL) {
+        rb_ensure(yield_rows, arg, destroy_data_chunk, arg);
+    }
+    return Qnil;
+}
+
+static VALUE release_decode_plan(VALUE arg) {
+    struct chunk_arg *p = (struct chunk_arg *)arg;
+
+    decode_plan_release(p->plan);
+    return Qnil;
+}
+
+/* :nodoc: */
+static VALUE result__row_stream(VALUE oDuckDBResult) {
+    rubyDuckDBResult *ctx;
+    duckdb_data_chunk chunk;
+    idx_t row_idx;
+    VALUE plan;
+    VALUE result_chunk;
 
     TypedData_Get_Struct(oDuckDBResult, rubyDuckDBResult, &result_data_type, ctx);
 
     RETURN_ENUMERATOR(oDuckDBResult, 0, 0);
 
-    arg.col_count = duckdb_column_count(&(ctx->result));
+    plan = decode_plan_new(ctx);
 
-    while((arg.chunk = duckdb_fetch_chunk(ctx->result)) != NULL) {
-        rb_ensure(yield_rows, (VALUE)&arg, destroy_data_chunk, (VALUE)&arg);
+    drain_cursor(oDuckDBResult, Qnil, Qnil, true);
+    while((chunk = rbduckdb_result_fetch_chunk(ctx)) != NULL) {
+        result_chunk = result_chunk_new(plan, chunk);
+        for (row_idx = 0; row_idx < get_struct_result_chunk(result_chunk)->size; row_idx++) {
+            rb_yield(rbduckdb_create_row(result_chunk, row_idx));
+        }
     }
+
+    RB_GC_GUARD(plan);
+    RB_GC_GUARD(oDuckDBResult);
     return Qnil;
 }
 
+static void decode_plan_mark(void *p) {
+    struct decode_plan *plan = (struct decode_plan *)p;
+
+    rb_gc_mark(plan->constants);
+    rb_gc_mark(plan->names);
+}
+
+static void decode_plan_free(void *p) {
+    struct decode_plan *plan = (struct decode_plan *)p;
+
+    decode_plan_release(plan);
+    xfree(plan);
+}
+
+static size_t decode_plan_memsize(const void *p) {
+    const struct decode_plan *plan = (const struct decode_plan *)p;
+
+    return sizeof(struct decode_plan) + plan->col_count * sizeof(struct column_decoder);
+}
+
+static void decode_plan_release(struct decode_plan *plan) {
+    idx_t col_idx;
+
+    if (plan->decoders == NULL) {
+        return;
+    }
+    for (col_idx = 0; col_idx < plan->col_count; col_idx++) {
+        column_decoder_destroy(&plan->decoders[col_idx]);
+    }
+    xfree(plan->decoders);
+    plan->decoders = NULL;
+}
+
+static VALUE decode_plan_new(rubyDuckDBResult *ctx) {
+    struct decode_plan *plan;
+    struct decode_options options;
+    idx_t col_idx;
+    idx_t col_count = duckdb_column_count(&(ctx->result));
+    VALUE obj = TypedData_Make_Struct(0, struct decode_plan, &decode_plan_data_type, plan);
+    VALUE names = rb_ary_new_capa(col_count);
+
+    plan->constants = rb_ary_new();
+    plan->names = names;
+    plan->decoders = ZALLOC_N(struct column_decoder, col_count);
+    plan->col_count = col_count;
+
+    decode_options_init(&options, plan->constants);
+
+    for (col_idx = 0; col_idx < col_count; col_idx++) {
+        column_decoder_init(&plan->decoders[col_idx], duckdb_column_logical_type(&(ctx->result), col_idx), &options);
+        rb_ary_push(names, rb_enc_interned_str_cstr(duckdb_column_name(&(ctx->result), col_idx), rb_utf8_encoding()));
+    }
+    rb_obj_freeze(names);
+    return obj;
+}
+
+static struct decode_plan *get_struct_decode_plan(VALUE obj) {
+    struct decode_plan *plan;
+    TypedData_Get_Struct(obj, struct decode_plan, &decode_plan_data_type, plan);
+    return plan;
+}
+
+static void result_chunk_mark(void *p) {
+    struct result_chunk *c = (struct result_chunk *)p;
+
+    rb_gc_mark(c->plan);
+}
+
+static void result_chunk_free(void *p) {
+    struct result_chunk *c = (struct result_chunk *)p;
+
+    if (c->chunk) {
+        duckdb_destroy_data_chunk(&(c->chunk));
+    }
+    rb_gc_adjust_memory_usage(-(ssize_t)c->memsize);
+    xfree(c);
+}
+
+static size_t result_chunk_memsize(const void *p) {
+    const struct result_chunk *c = (const struct result_chunk *)p;
+
+    return sizeof(struct result_chunk) + c->memsize;
+}
+
+/*
+ * Takes the ownership of chunk. The memory held by DuckDB is reported to
+ * the GC so that chunks of finished iterations are collected promptly.
+ */
+static VALUE result_chunk_new(VALUE plan, duckdb_data_chunk chunk) {
+    struct result_chunk *c;
+    struct decode_plan *p = get_struct_decode_plan(plan);
+    VALUE obj = rb_data_typed_object_wrap(0, NULL, &result_chunk_data_type);
+
+    c = ZALLOC(struct result_chunk);
+    c->chunk = chunk;
+    c->plan = plan;
+    c->size = duckdb_data_chunk_get_size(chunk);
+    c->serial = ++p->next_chunk_serial;
+    c->memsize = c->size * p->col_count * sizeof(duckdb_hugeint);
+    DATA_PTR(obj) = c;
+
+    rb_gc_adjust_memory_usage((ssize_t)c->memsize);
+    return obj;
+}
+
+static struct result_chunk *get_struct_result_chunk(VALUE obj) {
+    struct result_chunk *c;
+    TypedData_Get_Struct(obj, struct result_chunk, &result_chunk_data_type, c);
+    return c;
+}
+
+idx_t rbduckdb_result_chunk_column_count(VALUE chunk) {
+    return get_struct_decode_plan(get_struct_result_chunk(chunk)->plan)->col_count;
+}
+
+VALUE rbduckdb_result_chunk_column_names(VALUE chunk) {
+    return get_struct_decode_plan(get_struct_result_chunk(chunk)->plan)->names;
+}
+
+/*
+ * Decodes one cell of the chunk. The column decoder is rebound when the
+ * previous cell of the column was read from another chunk.
+ */
+VALUE rbduckdb_result_chunk_value(VALUE chunk, idx_t col_idx, idx_t row_idx) {
+    struct result_chunk *c = get_struct_result_chunk(chunk);
+    struct decode_plan *plan = get_struct_decode_plan(c->plan);
+    struct column_decoder *decoder;
+
+    if (plan->decoders == NULL || col_idx >= plan->col_count || row_idx >= c->size) {
+        return Qnil;
+    }
+    decoder = &plan->decoders[col_idx];
+    if (decoder->bound_serial != c->serial) {
+        column_decoder_set_vector(decoder, duckdb_data_chunk_get_vector(c->chunk, col_idx));
+        decoder->bound_serial = c->serial;
+    }
+    return column_decoder_value(decoder, row_idx);
+}
+
+static void decode_options_init(struct decode_options *options, VALUE constants) {
+    VALUE decimal_as = rb_funcall(mDuckDB, id_decimal_as, 0);
+
+    options->enum_as_symbol = rb_funcall(mDuckDB, id_enum_as, 0) == ID2SYM(id_symbol);
+    options->constants = constants;
+
+    if (decimal_as == ID2SYM(id_float)) {
+        options->decimal_as = DECIMAL_AS_FLOAT;
+    } else if (decimal_as == ID2SYM(id_rational)) {
+        options->decimal_as = DECIMAL_AS_RATIONAL;
+    } else if (decimal_as == ID2SYM(id_integer_cents)) {
+        options->decimal_as = DECIMAL_AS_INTEGER_CENTS;
+    } else {
+        options->decimal_as = DECIMAL_AS_BIGDECIMAL;
+    }
+}
+
+/*
+ * Takes the ownership of ty. The Ruby objects of the plan are pushed into
+ * options->constants, which the caller keeps alive while the plan is in use.
+ */
+static void column_decoder_init(struct column_decoder *decoder, duckdb_logical_type ty, struct decode_options *options) {
+    decoder->type = ty;
+    decoder->type_id = duckdb_get_type_id(ty);
+    decoder->enum_internal_type = DUCKDB_TYPE_INVALID;
+    decoder->enum_values = Qnil;
+    decoder->decimal_denominator = Qnil;
+    decoder->keys = Qnil;
+
+    switch(decoder->type_id) {
+        case DUCKDB_TYPE_ENUM:
+            decoder->enum_values = enum_dictionary(ty, options->enum_as_symbol);
+            rb_ary_push(options->constants, decoder->enum_values);
+            decoder->enum_internal_type = duckdb_enum_internal_type(ty);
+            break;
+        case DUCKDB_TYPE_DECIMAL:
+            column_decoder_init_decimal(decoder, options);
+            break;
+        case DUCKDB_TYPE_LIST:
+        case DUCKDB_TYPE_ARRAY:
+        case DUCKDB_TYPE_MAP:
+        case DUCKDB_TYPE_STRUCT:
+        case DUCKDB_TYPE_UNION:
+            column_decoder_init_children(decoder, options);
+            break;
+        default:
+            break;
+    }
+}
+
+static void column_decoder_init_decimal(struct column_decoder *decoder, struct decode_options *options) {
+    decoder->decimal_internal_type = duckdb_decimal_internal_type(decoder->type);
+    decoder->decimal_width = duckdb_decimal_width(decoder->type);
+    decoder->decimal_scale = duckdb_decimal_scale(decoder->type);
+    decoder->decimal_as = options->decimal_as;
+
+    if (decoder->decimal_as == DECIMAL_AS_RATIONAL) {
+        decoder->decimal_denominator = rb_int_positive_pow(10, decoder->decimal_scale);
+        rb_ary_push(options->constants, decoder->decimal_denominator);
+    }
+}
+
+static void column_decoder_init_children(struct column_decoder *decoder, struct decode_options *options) {
+    duckdb_logical_type ty = decoder->type;
+    idx_t i;
+
+    switch(decoder->type_id) {
+        case DUCKDB_TYPE_LIST:
+        case DUCKDB_TYPE_ARRAY:
+            decoder->child_count = 1;
+            break;
+        case DUCKDB_TYPE_MAP:
+            decoder->child_count = 2;
+            break;
+        case DUCKDB_TYPE_STRUCT:
+            decoder->child_count = duckdb_struct_type_child_count(ty);
+            decoder->keys = struct_keys(ty, decoder->child_count);
+            rb_ary_push(options->constants, decoder->keys);
+            break;
+        default:
+            decoder->child_count = duckdb_union_type_member_count(ty);
+            break;
+    }
+    decoder->children = ZALLOC_N(struct column_decoder, decoder->child_count);
+
+    for (i = 0; i < decoder->child_count; i++) {
+        duckdb_logical_type child_type;
+
+        switch(decoder->type_id) {
+            case DUCKDB_TYPE_LIST:
+                child_type = duckdb_list_type_child_type(ty);
+                break;
+            case DUCKDB_TYPE_ARRAY:
+                child_type = duckdb_array_type_child_type(ty);
+                decoder->array_size = duckdb_array_type_array_size(ty);
+                break;
+            case DUCKDB_TYPE_MAP:
+                child_type = i == 0 ? duckdb_map_type_key_type(ty) : duckdb_map_type_value_type(ty);
+                break;
+            case DUCKDB_TYPE_STRUCT:
+                child_type = duckdb_struct_type_child_type(ty, i);
+                break;
+            default:
+                child_type = duckdb_union_type_member_type(ty, i);
+                break;
+        }
+        column_decoder_init(&decoder->children[i], child_type, options);
+    }
+}
+
+static void column_decoder_destroy(struct column_decoder *decoder) {
+    idx_t i;
+
+    if (decoder->children) {
+        for (i = 0; i < decoder->child_count; i++) {
+            column_decoder_destroy(&decoder->children[i]);
+        }
+        xfree(decoder->children);
+        decoder->children = NULL;
+    }
+    if (decoder->type) {
+        duckdb_destroy_logical_type(&(decoder->type));
+    }
+}
+
+static void column_decoder_set_vector(struct column_decoder *decoder, duckdb_vector vector) {
+    duckdb_vector child;
+    idx_t i;
+
+    decoder->vector = vector;
+    decoder->data = duckdb_vector_get_data(vector);
+    decoder->validity = duckdb_vector_get_validity(vector);
+
+    switch(decoder->type_id) {
+        case DUCKDB_TYPE_LIST:
+            column_decoder_set_vector(&decoder->children[0], duckdb_list_vector_get_child(vector));
+            break;
+        case DUCKDB_TYPE_ARRAY:
+            column_decoder_set_vector(&decoder->children[0], duckdb_array_vector_get_child(vector));
+            break;
+        case DUCKDB_TYPE_MAP:
+            child = duckdb_list_vector_get_child(vector);
+            column_decoder_set_vector(&decoder->children[0], duckdb_struct_vector_get_child(child, 0));
+            column_decoder_set_vector(&decoder->children[1], duckdb_struct_vector_get_child(child, 1));
+            break;
+        case DUCKDB_TYPE_STRUCT:
+            for (i = 0; i < decoder->child_count; i++) {
+                column_decoder_set_vector(&decoder->children[i], duckdb_struct_vector_get_child(vector, i));
+            }
+            break;
+        case DUCKDB_TYPE_UNION:
+            decoder->union_tags = duckdb_vector_get_data(duckdb_struct_vector_get_child(vector, 0));
+            for (i = 0; i < decoder->child_count; i++) {
+                column_decoder_set_vector(&decoder->children[i], duckdb_struct_vector_get_child(vector, i + 1));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+static VALUE column_decoder_value(struct column_decoder *decoder, idx_t row_idx) {
+    uint8_t tag;
+
+    if (decoder->validity && !duckdb_validity_row_is_valid(decoder->validity, row_idx)) {
+        return Qnil;
+    }
+
+    switch(decoder->type_id) {
+        case DUCKDB_TYPE_ENUM:
+            return rb_ary_entry(decoder->enum_values,
+                                enum_code_at(decoder->enum_internal_type, decoder->data, row_idx));
+        case DUCKDB_TYPE_LIST:
+            return decode_list(decoder, row_idx);
+        case DUCKDB_TYPE_ARRAY:
+            return decode_array(decoder, row_idx);
+        case DUCKDB_TYPE_MAP:
+            return decode_map(decoder, row_idx);
+        case DUCKDB_TYPE_STRUCT:
+            return decode_struct(decoder, row_idx);
+        case DUCKDB_TYPE_DECIMAL:
+            return decode_decimal(decoder, row_idx);
+        case DUCKDB_TYPE_UNION:
+            tag = decoder->union_tags[row_idx];
+            if (tag >= decoder->child_count) {
+                return Qnil;
+            }
+            return column_decoder_value(&decoder->children[tag], row_idx);
+        default:
+            return vector_value_of_type(decoder->type_id, decoder->type, decoder->vector, decoder->data, row_idx);
+    }
+}
+
+static VALUE decode_list(struct column_decoder *decoder, idx_t row_idx) {
+    duckdb_list_entry list_entry = ((duckdb_list_entry *)decoder->data)[row_idx];
+    VALUE ary = rb_ary_new2(list_entry.length);
+    idx_t i;
+
+    for (i = 0; i < list_entry.length; i++) {
+        rb_ary_store(ary, i, column_decoder_value(&decoder->children[0], list_entry.offset + i));
+    }
+    return ary;
+}
+
+static VALUE decode_array(struct column_decoder *decoder, idx_t row_idx) {
+    idx_t bgn = row_idx * decoder->array_size;
+    VALUE ary = rb_ary_new2(decoder->array_size);
+    idx_t i;
+
+    for (i = 0; i < decoder->array_size; i++) {
+        rb_ary_store(ary, i, column_decoder_value(&decoder->children[0], bgn + i));
+    }
+    return ary;
+}
+
+static VALUE decode_map(struct column_decoder *decoder, idx_t row_idx) {
+    duckdb_list_entry list_entry = ((duckdb_list_entry *)decoder->data)[row_idx];
+    idx_t end = list_entry.offset + list_entry.length;
+    VALUE hash = rb_hash_new_capa(list_entry.length);
+    idx_t i;
+
+    for (i = list_entry.offset; i < end; i++) {
+        rb_hash_aset(hash,
+                     column_decoder_value(&decoder->children[0], i),
+                     column_decoder_value(&decoder->children[1], i));
+    }
+    return hash;
+}
+
+static VALUE decode_struct(struct column_decoder *decoder, idx_t row_idx) {
+    VALUE hash = rb_hash_new_capa(decoder->child_count);
+    VALUE key;
+    idx_t i;
+
+    for (i = 0; i < decoder->child_count; i++) {
+        key = RARRAY_AREF(decoder->keys, i);
+        if (!NIL_P(key)) {
+            rb_hash_aset(hash, key, column_decoder_value(&decoder->children[i], row_idx));
+        }
+    }
+    return hash;
+}
+
+static VALUE decode_decimal(struct column_decoder *decoder, idx_t row_idx) {
+    duckdb_decimal decimal;
+
+    decimal.width = decoder->decimal_width;
+    decimal.scale = decoder->decimal_scale;
+    decimal.value = decimal_unscaled_at(decoder->decimal_internal_type, decoder->data, row_idx);
+
+    switch(decoder->decimal_as) {
+        case DECIMAL_AS_FLOAT:
+            return DBL2NUM(duckdb_decimal_to_double(decimal));
+        case DECIMAL_AS_RATIONAL:
+            return rb_rational_new(rbduckdb_hugeint_to_ruby(decimal.value), decoder->decimal_denominator);
+        case DECIMAL_AS_INTEGER_CENTS:
+            return rbduckdb_hugeint_to_ruby(decimal.value);
+        default:
+            return rbduckdb_decimal_to_ruby(decimal.value, decimal.scale);
+    }
+}
+
+static duckdb_hugeint decimal_unscaled_at(duckdb_type internal_type, void *vector_data, idx_t row_idx) {
+    duckdb_hugeint value;
+    int64_t v;
+
+    switch(internal_type) {
+        case DUCKDB_TYPE_HUGEINT:
+            return ((duckdb_hugeint *) vector_data)[row_idx];
+        case DUCKDB_TYPE_SMALLINT:
+            v = ((int16_t *) vector_data)[row_idx];
+            break;
+        case DUCKDB_TYPE_INTEGER:
+            v = ((int32_t *) vector_data)[row_idx];
+            break;
+        case DUCKDB_TYPE_BIGINT:
+            v = ((int64_t *) vector_data)[row_idx];
+            break;
+        default:
+            rb_raise(eDuckDBError, "Unknown decimal internal type %d", internal_type);
+    }
+    value.lower = (uint64_t)v;
+    value.upper = v < 0 ? -1 : 0;
+    return value;
+}
+
+static VALUE struct_keys(duckdb_logical_type ty, idx_t child_count) {
+    VALUE keys = rb_ary_new_capa(child_count);
+    idx_t i;
+    char *p;
+
+    for (i = 0; i < child_count; i++) {
+        p = duckdb_struct_type_child_name(ty, i);
+        if (p) {
+            rb_ary_push(keys, ID2SYM(rb_intern_const(p)));
+            duckdb_free(p);
+        } else {
+            rb_ary_push(keys, Qnil);
+        }
+    }
+    return rb_obj_freeze(keys);
+}
+
+/*
+ * Decodes the whole ENUM dictionary into a frozen Array indexed by the
+ * physical code. The entries are interned frozen Strings (or Symbols), so
+ * every row holding the same ENUM value shares one Ruby object.
+ */
+static VALUE enum_dictionary(duckdb_logical_type ty, bool symbolize) {
+    uint32_t size = duckdb_enum_dictionary_size(ty);
+    uint32_t index;
+    char *p;
+    VALUE value;
+    VALUE ary = rb_ary_new_capa(size);
+
+    for (index = 0; index < size; index++) {
+        value = Qnil;
+        p = duckdb_enum_dictionary_value(ty, index);
+        if (p) {
+            value = rb_enc_interned_str_cstr(p, rb_utf8_encoding());
+            duckdb_free(p);
+            if (symbolize) {
+                value = rb_str_intern(value);
+            }
+        }
+        rb_ary_push(ary, value);
+    }
+    return rb_obj_freeze(ary);
+}
+
+static uint32_t enum_code_at(duckdb_type internal_type, void *vector_data, idx_t row_idx) {
+    switch(internal_type) {
+        case DUCKDB_TYPE_UTINYINT:
+            return ((uint8_t *) vector_data)[row_idx];
+        case DUCKDB_TYPE_USMALLINT:
+            return ((uint16_t *) vector_data)[row_idx];
+        case DUCKDB_TYPE_UINTEGER:
+            return ((uint32_t *) vector_data)[row_idx];
+        default:
+            rb_raise(eDuckDBError, "Unknown enum internal type %d", internal_type);
+    }
+    return 0;
+}
+
 static VALUE yield_rows(VALUE arg) {
     idx_t row_count;
     idx_t row_idx;
     idx_t col_idx;
-    duckdb_vector vector;
     VALUE row;
-    VALUE val;
 
     struct chunk_arg *p = (struct chunk_arg *)arg;
+    struct decode_plan *plan = p->plan;
+
+    for (col_idx = 0; col_idx < plan->col_count; col_idx++) {
+        column_decoder_set_vector(&plan->decoders[col_idx], duckdb_data_chunk_get_vector(p->chunk, col_idx));
+    }
 
     row_count = duckdb_data_chunk_get_size(p->chunk);
     for (row_idx = 0; row_idx < row_count; row_idx++) {
-        row = rb_ary_new2(p->col_count);
-        for (col_idx = 0; col_idx < p->col_count; col_idx++) {
-            vector = duckdb_data_chunk_get_vector(p->chunk, col_idx);
-            val = vector_value(vector, row_idx);
-            rb_ary_store(row, col_idx, val);
+        row = decode_row(plan, row_idx, p->keys);
+        if (NIL_P(p->rows)) {
+            rb_yield(row);
+        } else {
+            rb_ary_push(p->rows, row);
         }
-        rb_yield(row);
     }
     return Qnil;
 }
 
+/* Builds an Array row, or a Hash row when keys are given, from the bound decoders. */
+static VALUE decode_row(struct decode_plan *plan, idx_t row_idx, VALUE keys) {
+    idx_t col_idx;
+    VALUE row;
+    VALUE val;
+
+    if (NIL_P(keys)) {
+        row = rb_ary_new2(plan->col_count);
+        for (col_idx = 0; col_idx < plan->col_count; col_idx++) {
+            val = column_decoder_value(&plan->decoders[col_idx], row_idx);
+            rb_ary_store(row, col_idx, val);
+        }
+    } else {
+        row = rb_hash_new_capa(plan->col_count);
+        for (col_idx = 0; col_idx < plan->col_count; col_idx++) {
+            val = column_decoder_value(&plan->decoders[col_idx], row_idx);
+            rb_hash_aset(row, RARRAY_AREF(keys, col_idx), val);
+        }
+    }
+    return row;
+}
+
+static void result_chunk_bind(struct result_chunk *c) {
+    struct decode_plan *plan = get_struct_decode_plan(c->plan);
+    idx_t col_idx;
+
+    for (col_idx = 0; col_idx < plan->col_count; col_idx++) {
+        if (plan->decoders[col_idx].bound_serial != c->serial) {
+            column_decoder_set_vector(&plan->decoders[col_idx], duckdb_data_chunk_get_vector(c->chunk, col_idx));
+            plan->decoders[col_idx].bound_serial = c->serial;
+        }
+    }
+}
+
+static void result_cursor_mark(void *p) {
+    struct result_cursor *cursor = (struct result_cursor *)p;
+
+    rb_gc_mark(cursor->plan);
+    rb_gc_mark(cursor->chunk);
+}
+
+static size_t result_cursor_memsize(const void *p) {
+    return sizeof(struct result_cursor);
+}
+
+/* The cursor is kept in a hidden instance variable of the result. */
+static struct result_cursor *result_cursor_of(VALUE oDuckDBResult, bool create) {
+    struct result_cursor *cursor;
+    VALUE obj = rb_attr_get(oDuckDBResult, id_cursor);
+
+    if (NIL_P(obj)) {
+        if (!create) {
+            return NULL;
+        }
+        obj = TypedData_Make_Struct(0, struct result_cursor, &result_cursor_data_type, cursor);
+        cursor->plan = Qnil;
+        cursor->chunk = Qnil;
+        cursor->plan = decode_plan_new(rbduckdb_get_struct_result(oDuckDBResult));
+        rb_ivar_set(oDuckDBResult, id_cursor, obj);
+        return cursor;
+    }
+    TypedData_Get_Struct(obj, struct result_cursor, &result_cursor_data_type, cursor);
+    return cursor;
+}
+
+/* Returns the chunk holding the next row of the cursor, or nil at the end. */
+static VALUE result_cursor_chunk(rubyDuckDBResult *ctx, struct result_cursor *cursor) {
+    duckdb_data_chunk chunk;
+
+    while (NIL_P(cursor->chunk) || cursor->row_idx >= get_struct_result_chunk(cursor->chunk)->size) {
+        cursor->chunk = Qnil;
+        cursor->row_idx = 0;
+        chunk = rbduckdb_result_fetch_chunk(ctx);
+        if (chunk == NULL) {
+            return Qnil;
+        }
+        cursor->chunk = result_chunk_new(cursor->plan, chunk);
+    }
+    result_chunk_bind(get_struct_result_chunk(cursor->chunk));
+    return cursor->chunk;
+}
+
+/*
+ * Hands the rows left in the cursor's chunk to an iteration over the rest
+ * of the result, which then continues with the next chunk.
+ */
+static void drain_cursor(VALUE oDuckDBResult, VALUE keys, VALUE rows, bool as_row) {
+    struct result_cursor *cursor = result_cursor_of(oDuckDBResult, false);
+    struct result_chunk *c;
+    VALUE chunk;
+    VALUE row;
+
+    if (cursor == NULL || NIL_P(cursor->chunk)) {
+        return;
+    }
+    chunk = cursor->chunk;
+    c = get_struct_result_chunk(chunk);
+    cursor->chunk = Qnil;
+    result_chunk_bind(c);
+    for (; cursor->row_idx < c->size; cursor->row_idx++) {
+        if (as_row) {
+            row = rbduckdb_create_row(chunk, cursor->row_idx);
+        } else {
+            row = decode_row(get_struct_decode_plan(c->plan), cursor->row_idx, keys);
+        }
+        if (NIL_P(rows)) {
+            rb_yield(row);
+        } else {
+            rb_ary_push(rows, row);
+        }
+    }
+    RB_GC_GUARD(chunk);
+}
+
+/* Returns true while #fetch has left rows unread in the cursor's chunk. */
+static bool cursor_pending(VALUE oDuckDBResult) {
+    struct result_cursor *cursor = result_cursor_of(oDuckDBResult, false);
+
+    return cursor != NULL && !NIL_P(cursor->chunk) &&
+           cursor->row_idx < get_struct_result_chunk(cursor->chunk)->size;
+}
+
+/*
+ * Hands the chunk left by #fetch to a reader that continues with
+ * rbduckdb_result_fetch_chunk(): the caller owns the returned chunk and
+ * reads it from *row_idx. Returns NULL when no row of it is left.
+ */
+duckdb_data_chunk rbduckdb_result_take_pending_chunk(VALUE oDuckDBResult, idx_t *row_idx) {
+    struct result_cursor *cursor = result_cursor_of(oDuckDBResult, false);
+    struct result_chunk *c;
+    duckdb_data_chunk chunk;
+
+    *row_idx = 0;
+    if (!cursor_pending(oDuckDBResult)) {
+        return NULL;
+    }
+    c = get_struct_result_chunk(cursor->chunk);
+    chunk = c->chunk;
+    *row_idx = cursor->row_idx;
+    c->chunk = NULL;
+    rb_gc_adjust_memory_usage(-(ssize_t)c->memsize);
+    c->memsize = 0;
+    cursor->chunk = Qnil;
+    cursor->row_idx = 0;
+    return chunk;
+}
+
+/*
+ *  call-seq:
+ *    result.fetch(count) -> Array
+ *
+ *  Returns the next count rows (or fewer, at the end of the result) as an
+ *  Array of Arrays, and an empty Array when all the rows have been read.
+ *  The position is kept between calls, including inside a partially read
+ *  chunk, so paging through a (streaming) result reads it only once.
+ *  #each, #each_row, #write_json, #write_csv, #column_buffer and
+ *  #each_chunk_buffers continue after the fetched rows.
+ *
+ *    result = con.query('SELECT * FROM users ORDER BY id')
+ *    result.fetch(2) # => [[1, 'Alice'], [2, 'Bob']]
+ *    result.fetch(2) # => [[3, 'Cathy']]
+ *    result.fetch(2) # => []
+ */
+static VALUE result_fetch(VALUE oDuckDBResult, VALUE count) {
+    rubyDuckDBResult *ctx = rbduckdb_get_struct_result(oDuckDBResult);
+    struct result_cursor *cursor;
+    struct result_chunk *c;
+    struct decode_plan *plan;
+    long n = NUM2LONG(count);
+    VALUE rows;
+
+    if (n < 0) {
+        rb_raise(rb_eArgError, "negative count: %ld", n);
+    }
+    cursor = result_cursor_of(oDuckDBResult, true);
+    plan = get_struct_decode_plan(cursor->plan);
+    rows = rb_ary_new_capa(n < 2048 ? n : 2048);
+
+    while (RARRAY_LEN(rows) < n && !NIL_P(result_cursor_chunk(ctx, cursor))) {
+        c = get_struct_result_chunk(cursor->chunk);
+        while (cursor->row_idx < c->size && RARRAY_LEN(rows) < n) {
+            rb_ary_push(rows, decode_row(plan, cursor->row_idx++, Qnil));
+        }
+    }
+    return rows;
+}
+
+/*
+ *  call-seq:
+ *    result.fetch_chunk -> Array or nil
+ *
+ *  Returns the rows left in the current chunk, or the rows of the next
+ *  chunk, as an Array of Arrays. Returns nil when all the rows have been
+ *  read.
+ *
+ *    result = con.query('SELECT * FROM range(10000)')
+ *    while (rows = result.fetch_chunk)
+ *      rows.size # => 2048, ..., 1808
+ *    end
+ */
+static VALUE result_fetch_chunk(VALUE oDuckDBResult) {
+    rubyDuckDBResult *ctx = rbduckdb_get_struct_result(oDuckDBResult);
+    struct result_cursor *cursor = result_cursor_of(oDuckDBResult, true);
+    struct decode_plan *plan = get_struct_decode_plan(cursor->plan);
+    struct result_chunk *c;
+    VALUE rows;
+
+    if (NIL_P(result_cursor_chunk(ctx, cursor))) {
+        return Qnil;
+    }
+    c = get_struct_result_chunk(cursor->chunk);
+    rows = rb_ary_new_capa(c->size - cursor->row_idx);
+    while (cursor->row_idx < c->size) {
+        rb_ary_push(rows, decode_row(plan, cursor->row_idx++, Qnil));
+    }
+    return rows;
+}
+
+/*
+ *  call-seq:
+ *    result.rewind? -> true or false
+ *
+ *  Returns true while no row of the result has been read. DuckDB reads a
+ *  result forward only: once #fetch, #each or an export has read a chunk,
+ *  the rows before the current position cannot be read again, and the
+ *  query must be run again to start over.
+ */
+static VALUE result_rewind_p(VALUE oDuckDBResult) {
+    rubyDuckDBResult *ctx = rbduckdb_get_struct_result(oDuckDBResult);
+
+    return (ctx->fetched || ctx->arrow_exported) ? Qfalse : Qtrue;
+}
+
 /* :nodoc: */
 static VALUE result__return_type(VALUE oDuckDBResult) {
     rubyDuckDBResult *ctx;
@@ -287,41 +1250,9 @@ static VALUE vector_uhugeint(void* vector_data, idx_t row_idx) {
 }
 
 static VALUE vector_decimal(duckdb_logical_type ty, void* vector_data, idx_t row_idx) {
-    VALUE width = INT2FIX(duckdb_decimal_width(ty));
-    VALUE scale = INT2FIX(duckdb_decimal_scale(ty));
-    duckdb_type type = duckdb_decimal_internal_type(ty);
-    duckdb_hugeint value;
-    VALUE upper = Qnil;
-    VALUE lower = Qnil;
-
-    value.upper = 0;
-    value.lower = 0;
-
-    switch(type) {
-        case DUCKDB_TYPE_HUGEINT:
-            value = ((duckdb_hugeint *) vector_data)[row_idx];
-            upper = LL2NUM(value.upper);
-            lower = ULL2NUM(value.lower);
-            break;
-        case DUCKDB_TYPE_SMALLINT:
-            upper = INT2FIX(((int16_t *) vector_data)[row_idx]);
-            break;
-        case DUCKDB_TYPE_INTEGER:
-            upper = INT2NUM(((int32_t *) vector_data)[row_idx]);
-            break;
-        case DUCKDB_TYPE_BIGINT:
-            upper = LL2NUM(((int64_t *) vector_data)[row_idx]);
-            break;
-        default:
-            rb_warn("Unknown decimal internal type %d", type);
-    }
+    duckdb_hugeint value = decimal_unscaled_at(duckdb_decimal_internal_type(ty), vector_data, row_idx);
 
-    return rb_funcall(mDuckDBConverter, id__to_decimal_from_hugeint, 4,
-                      width,
-                      scale,
-                      upper,
-                      lower
-                      );
+    return rbduckdb_decimal_to_ruby(value, duckdb_decimal_scale(ty));
 }
 
 
@@ -345,22 +1276,14 @@ static VALUE vector_time_ns(void* vector_data, idx_t row_idx) {
 }
 
 static VALUE vector_enum(duckdb_logical_type ty, void* vector_data, idx_t row_idx) {
-    duckdb_type type = duckdb_enum_internal_type(ty);
-    uint8_t index;
+    uint32_t index = enum_code_at(duckdb_enum_internal_type(ty), vector_data, row_idx);
     char *p;
     VALUE value = Qnil;
 
-    switch(type) {
-        case DUCKDB_TYPE_UTINYINT:
-            index = ((uint8_t *) vector_data)[row_idx];
-            p = duckdb_enum_dictionary_value(ty, index);
-            if (p) {
-                value = rb_utf8_str_new_cstr(p);
-                duckdb_free(p);
-            }
-            break;
-        default:
-            rb_warn("Unknown enum internal type %d", type);
+    p = duckdb_enum_dictionary_value(ty, index);
+    if (p) {
+        value = rb_enc_interned_str_cstr(p, rb_utf8_encoding());
+        duckdb_free(p);
     }
     return value;
 }
@@ -387,17 +1310,17 @@ static VALUE vector_array(duckdb_logical_type ty, duckdb_vector vector, idx_t ro
 
 VALUE rbduckdb_vector_value_at(duckdb_vector vector, duckdb_logical_type element_type, idx_t index) {
     uint64_t *validity;
-    duckdb_type type_id;
-    void* vector_data;
-    VALUE obj = Qnil;
 
     validity = duckdb_vector_get_validity(vector);
     if (!duckdb_validity_row_is_valid(validity, index)) {
         return Qnil;
     }
 
-    type_id = duckdb_get_type_id(element_type);
-    vector_data = duckdb_vector_get_data(vector);
+    return vector_value_of_type(duckdb_get_type_id(element_type), element_type, vector, duckdb_vector_get_data(vector), index);
+}
+
+static VALUE vector_value_of_type(duckdb_type type_id, duckdb_logical_type element_type, duckdb_vector vector, void *vector_data, idx_t index) {
+    VALUE obj = Qnil;
 
     switch(type_id) {
         case DUCKDB_TYPE_INVALID:
@@ -676,7 +1599,7 @@ static VALUE vector_uuid(void* vector_data, idx_t row_idx) {
  *    df = Polars::DataFrame.new(result)
  *
  *  The stream consumes the result's chunks; a result can be exported
- *  only once. This API is built on DuckDB's unstable Arrow C API and
+ *  only once, and not after #fetch has read part of a chunk. This API is built on DuckDB's unstable Arrow C API and
  *  may change in any minor release.
  */
 static VALUE result_arrow_c_stream(VALUE oDuckDBResult) {
@@ -687,23 +1610,14 @@ static VALUE result_arrow_c_stream(VALUE oDuckDBResult) {
     if (ctx->arrow_exported) {
         rb_raise(eDuckDBError, "result is already exported as an Arrow stream");
     }
+    if (cursor_pending(oDuckDBResult)) {
+        rb_raise(eDuckDBError, "cannot export a result partially read by #fetch as an Arrow stream");
+    }
     stream = rbduckdb_create_arrow_array_stream(oDuckDBResult);
     ctx->arrow_exported = true;
     return stream;
 }
 
-static VALUE vector_value(duckdb_vector vector, idx_t row_idx) {
-    duckdb_logical_type ty;
-    VALUE obj = Qnil;
-
-    ty = duckdb_vector_get_column_type(vector);
-
-    obj = rbduckdb_vector_value_at(vector, ty, row_idx);
-
-    duckdb_destroy_logical_type(&ty);
-    return obj;
-}
-
 void rbduckdb_init_result(void) {
 #if 0
     VALUE mDuckDB = rb_define_module("DuckDB");
@@ -716,9 +1630,23 @@ void rbduckdb_init_result(void) {
     rb_define_method(cDuckDBResult, "rows_changed", result_rows_changed, 0);
     rb_define_method(cDuckDBResult, "columns", result_columns, 0);
     rb_define_private_method(cDuckDBResult, "_chunk_stream", result__chunk_stream, 0);
+    rb_define_private_method(cDuckDBResult, "_row_stream", result__row_stream, 0);
+    rb_define_private_method(cDuckDBResult, "_hash_stream", result__hash_stream, 1);
+    rb_define_private_method(cDuckDBResult, "_to_hashes", result__to_hashes, 1);
+    rb_define_method(cDuckDBResult, "fetch", result_fetch, 1);
+    rb_define_method(cDuckDBResult, "fetch_chunk", result_fetch_chunk, 0);
+    rb_define_method(cDuckDBResult, "rewind?", result_rewind_p, 0);
     rb_define_method(cDuckDBResult, "arrow_c_stream", result_arrow_c_stream, 0);
     rb_define_private_method(cDuckDBResult, "_return_type", result__return_type, 0);
     rb_define_private_method(cDuckDBResult, "_statement_type", result__statement_type, 0);
 
     rb_define_private_method(cDuckDBResult, "_enum_internal_type", result__enum_internal_type, 1);
+
+    id_enum_as = rb_intern("enum_as");
+    id_symbol = rb_intern("symbol");
+    id_decimal_as = rb_intern("decimal_as");
+    id_float = rb_intern("float");
+    id_rational = rb_intern("rational");
+    id_integer_cents = rb_intern("integer_cents");
+    id_cursor = rb_intern("cursor");
 }
@@ -11,16 +11,22 @@
 struct _rubyDuckDBResult {
     duckdb_result result;
     bool arrow_exported;
+    bool fetched;
     rb_atomic_t refcount;
 };
 
 typedef struct _rubyDuckDBResult rubyDuckDBResult;
 
 rubyDuckDBResult *rbduckdb_get_struct_result(VALUE obj);
+duckdb_data_chunk rbduckdb_result_fetch_chunk(rubyDuckDBResult *ctx);
+duckdb_data_chunk rbduckdb_result_take_pending_chunk(VALUE oDuckDBResult, idx_t *row_idx);
 void rbduckdb_result_ref(rubyDuckDBResult *ctx);
 void rbduckdb_result_unref(rubyDuckDBResult *ctx);
 void rbduckdb_init_result(void);
 VALUE rbduckdb_create_result(void);
 VALUE rbduckdb_vector_value_at(duckdb_vector vector, duckdb_logical_type element_type, idx_t index);
+idx_t rbduckdb_result_chunk_column_count(VALUE chunk);
+VALUE rbduckdb_result_chunk_column_names(VALUE chunk);
+VALUE rbduckdb_result_chunk_value(VALUE chunk, idx_t col_idx, idx_t row_idx);
 
 #endif
@@ -0,0 +1,250 @@
+#include "ruby-duckdb.h"
+
+/*
+ * Exports fixed-width columns of a result as packed binary Strings: the
+ * vector data of each chunk is copied with one memcpy, and NULLs are
+ * reported in a separate validity bitmap (bit i set when row i is valid,
+ * least significant bit first), as Arrow and Numo expect.
+ */
+
+struct column_buffer_arg {
+    VALUE result;
+    rubyDuckDBResult *ctx;
+    duckdb_data_chunk chunk;
+    idx_t col_idx;
+    VALUE col_indices;
+};
+
+static size_t fixed_width_of(duckdb_type type_id);
+static size_t column_fixed_width(rubyDuckDBResult *ctx, idx_t col_idx, duckdb_type *type_id);
+static idx_t column_index_of(rubyDuckDBResult *ctx, VALUE col_idx);
+static void validity_append(VALUE validity, idx_t offset, uint64_t *mask, idx_t start, idx_t count);
+static VALUE collect_column(VALUE arg);
+static VALUE yield_chunk_buffers(VALUE arg);
+static VALUE destroy_chunk(VALUE arg);
+static VALUE result__column_buffer(VALUE oDuckDBResult, VALUE col_idx);
+static VALUE result__chunk_buffers(VALUE oDuckDBResult, VALUE col_indices);
+
+static size_t fixed_width_of(duckdb_type type_id) {
+    switch(type_id) {
+        case DUCKDB_TYPE_BOOLEAN:
+        case DUCKDB_TYPE_TINYINT:
+        case DUCKDB_TYPE_UTINYINT:
+            return 1;
+        case DUCKDB_TYPE_SMALLINT:
+        case DUCKDB_TYPE_USMALLINT:
+            return 2;
+        case DUCKDB_TYPE_INTEGER:
+        case DUCKDB_TYPE_UINTEGER:
+        case DUCKDB_TYPE_FLOAT:
+        case DUCKDB_TYPE_DATE:
+            return 4;
+        case DUCKDB_TYPE_BIGINT:
+        case DUCKDB_TYPE_UBIGINT:
+        case DUCKDB_TYPE_DOUBLE:
+        case DUCKDB_TYPE_TIME:
+        case DUCKDB_TYPE_TIME_NS:
+        case DUCKDB_TYPE_TIMESTAMP:
+        case DUCKDB_TYPE_TIMESTAMP_S:
+        case DUCKDB_TYPE_TIMESTAMP_MS:
+        case DUCKDB_TYPE_TIMESTAMP_NS:
+        case DUCKDB_TYPE_TIMESTAMP_TZ:
+            return 8;
+        case DUCKDB_TYPE_HUGEINT:
+        case DUCKDB_TYPE_UHUGEINT:
+            return 16;
+        default:
+            return 0;
+    }
+}
+
+static idx_t column_index_of(rubyDuckDBResult *ctx, VALUE col_idx) {
+    long idx = NUM2LONG(col_idx);
+    idx_t col_count = duckdb_column_count(&(ctx->result));
+
+    if (idx < 0) {
+        idx += (long)col_count;
+    }
+    if (idx < 0 || (idx_t)idx >= col_count) {
+        rb_raise(rb_eIndexError, "column index %ld out of range", NUM2LONG(col_idx));
+    }
+    return (idx_t)idx;
+}
+
+static size_t column_fixed_width(rubyDuckDBResult *ctx, idx_t col_idx, duckdb_type *type_id) {
+    size_t width;
+
+    *type_id = duckdb_column_type(&(ctx->result), col_idx);
+    width = fixed_width_of(*type_id);
+    if (width == 0) {
+        rb_raise(eDuckDBError, "column %llu (%s) is not a fixed-width numeric or temporal column",
+                 (unsigned long long)col_idx, duckdb_column_name(&(ctx->result), col_idx));
+    }
+    return width;
+}
+
+/*
+ * Appends count validity bits of mask, from row start, at bit offset. A
+ * NULL mask means all valid. The bits past the end of the last byte are
+ * kept zero.
+ */
+static void validity_append(VALUE validity, idx_t offset, uint64_t *mask, idx_t start, idx_t count) {
+    idx_t end = offset + count;
+    long old_len = RSTRING_LEN(validity);
+    long new_len = (long)((end + 7) / 8);
+    unsigned char *bytes;
+    idx_t i;
+
+    rb_str_resize(validity, new_len);
+    bytes = (unsigned char *)RSTRING_PTR(validity);
+    memset(bytes + old_len, 0, new_len - old_len);
+
+    /* the shifts take the mask's bytes least significant first on any host byte order */
+    if (offset % 8 == 0 && start == 0) {
+        for (i = 0; i < (count + 7) / 8; i++) {
+            bytes[offset / 8 + i] = mask ? (unsigned char)(mask[i / 8] >> ((i % 8) * 8)) : 0xFF;
+        }
+    } else {
+        for (i = 0; i < count; i++) {
+            if (mask == NULL || duckdb_validity_row_is_valid(mask, start + i)) {
+                bytes[(offset + i) / 8] |= (unsigned char)(1 << ((offset + i) % 8));
+            }
+        }
+    }
+    if (end % 8 != 0) {
+        bytes[new_len - 1] &= (unsigned char)((1 << (end % 8)) - 1);
+    }
+}
+
+static VALUE collect_column(VALUE arg) {
+    struct column_buffer_arg *p = (struct column_buffer_arg *)arg;
+    duckdb_type type_id;
+    size_t width = column_fixed_width(p->ctx, p->col_idx, &type_id);
+    VALUE data = rb_str_new(NULL, 0);
+    VALUE validity = Qnil;
+    duckdb_vector vector;
+    uint64_t *mask;
+    idx_t size = 0;
+    idx_t start;
+    idx_t count;
+
+    /* start with the rows #fetch left in its chunk */
+    p->chunk = rbduckdb_result_take_pending_chunk(p->result, &start);
+    if (p->chunk == NULL) {
+        p->chunk = rbduckdb_result_fetch_chunk(p->ctx);
+    }
+    while (p->chunk != NULL) {
+        count = duckdb_data_chunk_get_size(p->chunk) - start;
+        vector = duckdb_data_chunk_get_vector(p->chunk, p->col_idx);
+        rb_str_cat(data, (const char *)duckdb_vector_get_data(vector) + start * width, (long)(count * width));
+
+        mask = duckdb_vector_get_validity(vector);
+        if (mask != NULL && NIL_P(validity)) {
+            /* the rows before the first chunk with a NULL were all valid */
+            validity = rb_str_new(NULL, 0);
+            validity_append(validity, 0, NULL, 0, size);
+        }
+        if (!NIL_P(validity)) {
+            validity_append(validity, size, mask, start, count);
+        }
+        size += count;
+        duckdb_destroy_data_chunk(&(p->chunk));
+        start = 0;
+        /* nothing here yields to Ruby: let Ctrl-C and Thread#raise stop a large result */
+        rb_thread_check_ints();
+        p->chunk = rbduckdb_result_fetch_chunk(p->ctx);
+    }
+
+    return rb_ary_new_from_args(4, INT2FIX(type_id), ULL2NUM(size), data, validity);
+}
+
+static VALUE yield_chunk_buffers(VALUE arg) {
+    struct column_buffer_arg *p = (struct column_buffer_arg *)arg;
+    long n = RARRAY_LEN(p->col_indices);
+    duckdb_type *types = ALLOCA_N(duckdb_type, n);
+    size_t *widths = ALLOCA_N(size_t, n);
+    idx_t *indices = ALLOCA_N(idx_t, n);
+    duckdb_vector vector;
+    uint64_t *mask;
+    VALUE buffers;
+    VALUE validity;
+    idx_t start;
+    idx_t count;
+    long i;
+
+    for (i = 0; i < n; i++) {
+        indices[i] = column_index_of(p->ctx, RARRAY_AREF(p->col_indices, i));
+        widths[i] = column_fixed_width(p->ctx, indices[i], &types[i]);
+    }
+
+    p->chunk = rbduckdb_result_take_pending_chunk(p->result, &start);
+    if (p->chunk == NULL) {
+        p->chunk = rbduckdb_result_fetch_chunk(p->ctx);
+    }
+    while (p->chunk != NULL) {
+        count = duckdb_data_chunk_get_size(p->chunk) - start;
+        buffers = rb_ary_new_capa(n);
+        for (i = 0; i < n; i++) {
+            vector = duckdb_data_chunk_get_vector(p->chunk, indices[i]);
+            mask = duckdb_vector_get_validity(vector);
+            validity = Qnil;
+            if (mask != NULL) {
+                validity = rb_str_new(NULL, 0);
+                validity_append(validity, 0, mask, start, count);
+            }
+            rb_ary_push(buffers, rb_ary_new_from_args(4, INT2FIX(types[i]), ULL2NUM(count),
+                                                      rb_str_new((const char *)duckdb_vector_get_data(vector) + start * widths[i],
+                                                                 (long)(count * widths[i])),
+                                                      validity));
+        }
+        duckdb_destroy_data_chunk(&(p->chunk));
+        rb_yield(buffers);
+        start = 0;
+        p->chunk = rbduckdb_result_fetch_chunk(p->ctx);
+    }
+    return Qnil;
+}
+
+static VALUE destroy_chunk(VALUE arg) {
+    struct column_buffer_arg *p = (struct column_buffer_arg *)arg;
+
+    if (p->chunk) {
+        duckdb_destroy_data_chunk(&(p->chunk));
+    }
+    return Qnil;
+}
+
+/* :nodoc: */
+static VALUE result__column_buffer(VALUE oDuckDBResult, VALUE col_idx) {
+    struct column_buffer_arg arg;
+
+    arg.result = oDuckDBResult;
+    arg.ctx = rbduckdb_get_struct_result(oDuckDBResult);
+    arg.chunk = NULL;
+    arg.col_idx = column_index_of(arg.ctx, col_idx);
+    arg.col_indices = Qnil;
+    return rb_ensure(collect_column, (VALUE)&arg, destroy_chunk, (VALUE)&arg);
+}
+
+/* :nodoc: */
+static VALUE result__chunk_buffers(VALUE oDuckDBResult, VALUE col_indices) {
+    struct column_buffer_arg arg;
+
+    Check_Type(col_indices, T_ARRAY);
+    arg.result = oDuckDBResult;
+    arg.ctx = rbduckdb_get_struct_result(oDuckDBResult);
+    arg.chunk = NULL;
+    arg.col_idx = 0;
+    arg.col_indices = col_indices;
+    return rb_ensure(yield_chunk_buffers, (VALUE)&arg, destroy_chunk, (VALUE)&arg);
+}
+
+void rbduckdb_init_result_buffer(void) {
+#if 0
+    VALUE mDuckDB = rb_define_module("DuckDB");
+#endif
+    VALUE cDuckDBResult = rb_define_class_under(mDuckDB, "Result", rb_cObject);
+
+    rb_define_private_method(cDuckDBResult, "_column_buffer", result__column_buffer, 1);
+    rb_define_private_method(cDuckDBResult, "_chunk_buffers", result__chunk_buffers, 1);
+}
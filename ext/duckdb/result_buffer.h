@@ -0,0 +1,6 @@
+#ifndef RUBY_DUCKDB_RESULT_BUFFER_H
+#define RUBY_DUCKDB_RESULT_BUFFER_H
+
+void rbduckdb_init_result_buffer(void);
+
+#endif
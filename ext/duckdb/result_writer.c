@@ -0,0 +1,1288 @@
+#include "ruby-duckdb.h"
+
+/*
+ * Serializes a result straight from its data chunks. Chunks are fetched and
+ * encoded into a malloc'd byte buffer without the GVL; the buffer is handed
+ * to the Ruby IO in large writes. No Ruby object is created per row.
+ */
+
+#define WRITER_FLUSH_SIZE (1024 * 1024)
+
+enum writer_format {
+    WRITE_JSON_RECORDS,
+    WRITE_JSON_COLUMNS,
+    WRITE_NDJSON,
+    WRITE_CSV
+};
+
+enum encode_mode {
+    ENCODE_JSON,
+    ENCODE_TEXT
+};
+
+struct text_buffer {
+    char *ptr;
+    size_t len;
+    size_t capa;
+    bool failed;
+};
+
+/* C-only counterpart of the Result decode plan, usable without the GVL. */
+struct text_encoder {
+    duckdb_logical_type type;
+    duckdb_type type_id;
+    duckdb_type enum_internal_type;
+    uint32_t enum_size;
+    char **enum_values;
+    duckdb_type decimal_internal_type;
+    uint8_t decimal_scale;
+    struct text_buffer *keys;
+    idx_t array_size;
+    idx_t child_count;
+    struct text_encoder *children;
+    void *data;
+    uint64_t *validity;
+    uint8_t *union_tags;
+};
+
+struct result_writer {
+    VALUE result;
+    rubyDuckDBResult *ctx;
+    VALUE io;
+    enum writer_format format;
+    idx_t col_count;
+    struct text_encoder *encoders;
+    struct text_buffer *keys;
+    /* :columns only: the values of each column, held until the last row (O(result)) */
+    struct text_buffer *columns;
+    struct text_buffer out;
+    struct text_buffer field;
+    struct text_buffer delimiter;
+    struct text_buffer null_text;
+    bool header;
+    duckdb_data_chunk chunk;
+    idx_t chunk_size;
+    idx_t row_idx;
+    idx_t rows;
+    bool done;
+    volatile bool interrupted;
+};
+
+static void buf_grow(struct text_buffer *b, size_t extra);
+static void buf_cat(struct text_buffer *b, const char *p, size_t len);
+static void buf_putc(struct text_buffer *b, char c);
+static void buf_free(struct text_buffer *b);
+static void buf_cat_json_string(struct text_buffer *b, const char *p, size_t len);
+static void buf_cat_u64(struct text_buffer *b, uint64_t v);
+static void buf_cat_i64(struct text_buffer *b, int64_t v);
+static void buf_cat_hugeint(struct text_buffer *b, duckdb_hugeint v);
+static void buf_cat_uhugeint(struct text_buffer *b, duckdb_uhugeint v);
+static void buf_cat_decimal(struct text_buffer *b, duckdb_hugeint v, uint8_t scale);
+static void buf_cat_double(struct text_buffer *b, double d, bool is_float, enum encode_mode mode);
+static void buf_cat_fraction(struct text_buffer *b, uint64_t value, int digits);
+static void buf_cat_date(struct text_buffer *b, duckdb_date date);
+static void buf_cat_time(struct text_buffer *b, int hour, int min, int sec, uint64_t fraction, int digits);
+static void buf_cat_timestamp(struct text_buffer *b, int64_t micros, uint64_t nanos, int digits);
+static void buf_cat_time_tz(struct text_buffer *b, duckdb_time_tz tz);
+static void buf_cat_interval(struct text_buffer *b, duckdb_interval interval);
+static void buf_cat_blob(struct text_buffer *b, const char *p, size_t len);
+static void buf_cat_bit(struct text_buffer *b, const char *p, size_t len);
+static size_t u128_to_digits(uint64_t hi, uint64_t lo, char *out);
+
+static void text_encoder_init(struct text_encoder *e, duckdb_logical_type ty);
+static void text_encoder_destroy(struct text_encoder *e);
+static void text_encoder_set_vector(struct text_encoder *e, duckdb_vector vector);
+static bool encode_value(struct text_encoder *e, idx_t row_idx, struct text_buffer *b, enum encode_mode mode);
+static void encode_string(struct text_encoder *e, idx_t row_idx, struct text_buffer *b, enum encode_mode mode);
+static void encode_nested(struct text_encoder *e, idx_t row_idx, struct text_buffer *b);
+static void encode_json_key(struct text_encoder *e, idx_t row_idx, struct text_buffer *b);
+
+static void buf_cat_csv_field(struct result_writer *w, struct text_buffer *b, const char *p, size_t len);
+
+static void writer_init(struct result_writer *w);
+static VALUE writer_run(VALUE arg);
+static VALUE writer_cleanup(VALUE arg);
+static void *writer_encode_without_gvl(void *arg);
+static void writer_stop(void *arg);
+static void writer_encode_row(struct result_writer *w);
+static void writer_set_chunk(struct result_writer *w);
+static void writer_flush(struct result_writer *w);
+static VALUE result__write_json(VALUE oDuckDBResult, VALUE io, VALUE format);
+static VALUE result__write_csv(VALUE oDuckDBResult, VALUE io, VALUE delimiter, VALUE header, VALUE null_text);
+
+static void buf_grow(struct text_buffer *b, size_t extra) {
+    size_t capa;
+    char *p;
+
+    if (b->failed || b->len + extra <= b->capa) {
+        return;
+    }
+    capa = b->capa ? b->capa : 4096;
+    while (capa < b->len + extra) {
+        capa *= 2;
+    }
+    p = realloc(b->ptr, capa);
+    if (p == NULL) {
+        b->failed = true;
+        return;
+    }
+    b->ptr = p;
+    b->capa = capa;
+}
+
+static void buf_cat(struct text_buffer *b, const char *p, size_t len) {
+    buf_grow(b, len);
+    if (b->failed || len == 0) {
+        return;
+    }
+    memcpy(b->ptr + b->len, p, len);
+    b->len += len;
+}
+
+static void buf_putc(struct text_buffer *b, char c) {
+    buf_grow(b, 1);
+    if (b->failed) {
+        return;
+    }
+    b->ptr[b->len++] = c;
+}
+
+#define BUF_CAT_LITERAL(b, s) buf_cat((b), (s), sizeof(s) - 1)
+
+static void buf_free(struct text_buffer *b) {
+    free(b->ptr);
+    b->ptr = NULL;
+    b->len = 0;
+    b->capa = 0;
+}
+
+static void buf_cat_json_string(struct text_buffer *b, const char *p, size_t len) {
+    static const char hex[] = "0123456789abcdef";
+    size_t i;
+    size_t run = 0;
+    unsigned char c;
+    char esc[6];
+
+    buf_putc(b, '"');
+    for (i = 0; i < len; i++) {
+        c = (unsigned char)p[i];
+        if (c >= 0x20 && c != '"' && c != '\\') {
+            continue;
+        }
+        buf_cat(b, p + run, i - run);
+        run = i + 1;
+        switch(c) {
+            case '"':
+                BUF_CAT_LITERAL(b, "\\\"");
+                break;
+            case '\\':
+                BUF_CAT_LITERAL(b, "\\\\");
+                break;
+            case '\n':
+                BUF_CAT_LITERAL(b, "\\n");
+                break;
+            case '\r':
+                BUF_CAT_LITERAL(b, "\\r");
+                break;
+            case '\t':
+                BUF_CAT_LITERAL(b, "\\t");
+                break;
+            default:
+                esc[0] = '\\';
+                esc[1] = 'u';
+                esc[2] = '0';
+                esc[3] = '0';
+                esc[4] = hex[c >> 4];
+                esc[5] = hex[c & 0xf];
+                buf_cat(b, esc, 6);
+        }
+    }
+    buf_cat(b, p + run, len - run);
+    buf_putc(b, '"');
+}
+
+static void buf_cat_u64(struct text_buffer *b, uint64_t v) {
+    char digits[40];
+
+    buf_cat(b, digits, u128_to_digits(0, v, digits));
+}
+
+static void buf_cat_i64(struct text_buffer *b, int64_t v) {
+    if (v < 0) {
+        buf_putc(b, '-');
+        buf_cat_u64(b, (uint64_t)0 - (uint64_t)v);
+    } else {
+        buf_cat_u64(b, (uint64_t)v);
+    }
+}
+
+/* Writes the decimal digits of the unsigned 128-bit value hi:lo to out[40]. */
+static size_t u128_to_digits(uint64_t hi, uint64_t lo, char *out) {
+    uint32_t limbs[4];
+    char tmp[40];
+    size_t n = 0;
+    size_t i;
+    uint64_t rem;
+    uint64_t cur;
+    int k;
+    bool more;
+
+    limbs[0] = (uint32_t)(hi >> 32);
+    limbs[1] = (uint32_t)hi;
+    limbs[2] = (uint32_t)(lo >> 32);
+    limbs[3] = (uint32_t)lo;
+
+    do {
+        rem = 0;
+        for (i = 0; i < 4; i++) {
+            cur = (rem << 32) | limbs[i];
+            limbs[i] = (uint32_t)(cur / 1000000000);
+            rem = cur % 1000000000;
+        }
+        more = (limbs[0] | limbs[1] | limbs[2] | limbs[3]) != 0;
+        for (k = 0; k < 9; k++) {
+            if (!more && rem == 0 && n > 0) {
+                break;
+            }
+            tmp[n++] = (char)('0' + rem % 10);
+            rem /= 10;
+        }
+    } while (more);
+
+    for (i = 0; i < n; i++) {
+        out[i] = tmp[n - 1 - i];
+    }
+    return n;
+}
+
+static void buf_cat_hugeint(struct text_buffer *b, duckdb_hugeint v) {
+    char digits[40];
+    uint64_t hi = (uint64_t)v.upper;
+    uint64_t lo = v.lower;
+
+    if (v.upper < 0) {
+        buf_putc(b, '-');
+        lo = ~lo + 1;
+        hi = ~hi + (lo == 0 ? 1 : 0);
+    }
+    buf_cat(b, digits, u128_to_digits(hi, lo, digits));
+}
+
+static void buf_cat_uhugeint(struct text_buffer *b, duckdb_uhugeint v) {
+    char digits[40];
+
+    buf_cat(b, digits, u128_to_digits(v.upper, v.lower, digits));
+}
+
+static void buf_cat_decimal(struct text_buffer *b, duckdb_hugeint v, uint8_t scale) {
+    char digits[40];
+    size_t n;
+    uint64_t hi = (uint64_t)v.upper;
+    uint64_t lo = v.lower;
+
+    if (v.upper < 0) {
+        buf_putc(b, '-');
+        lo = ~lo + 1;
+        hi = ~hi + (lo == 0 ? 1 : 0);
+    }
+    n = u128_to_digits(hi, lo, digits);
+    if (scale == 0) {
+        buf_cat(b, digits, n);
+    } else if (n <= scale) {
+        BUF_CAT_LITERAL(b, "0.");
+        for (; n < scale; scale--) {
+            buf_putc(b, '0');
+        }
+        buf_cat(b, digits, n);
+    } else {
+        buf_cat(b, digits, n - scale);
+        buf_putc(b, '.');
+        buf_cat(b, digits + n - scale, scale);
+    }
+}
+
+/* Writes the shortest representation that reads back as the same value. */
+static void buf_cat_double(struct text_buffer *b, double d, bool is_float, enum encode_mode mode) {
+    char tmp[32];
+    int prec;
+    int len = 0;
+
+    if (isnan(d) || isinf(d)) {
+        if (mode == ENCODE_JSON) {
+            BUF_CAT_LITERAL(b, "null");
+        } else if (isnan(d)) {
+            BUF_CAT_LITERAL(b, "nan");
+        } else {
+            buf_cat(b, d < 0 ? "-inf" : "inf", d < 0 ? 4 : 3);
+        }
+        return;
+    }
+    for (prec = is_float ? 6 : 15; prec <= 17; prec++) {
+        len = snprintf(tmp, sizeof(tmp), "%.*g", prec, d);
+        if (is_float ? (float)strtod(tmp, NULL) == (float)d : strtod(tmp, NULL) == d) {
+            break;
+        }
+    }
+    buf_cat(b, tmp, (size_t)len);
+}
+
+/* Writes "." and the digits of value, without the trailing zeros. */
+static void buf_cat_fraction(struct text_buffer *b, uint64_t value, int digits) {
+    char tmp[16];
+    int i;
+
+    if (value == 0) {
+        return;
+    }
+    for (i = digits - 1; i >= 0; i--) {
+        tmp[i] = (char)('0' + value % 10);
+        value /= 10;
+    }
+    while (digits > 0 && tmp[digits - 1] == '0') {
+        digits--;
+    }
+    buf_putc(b, '.');
+    buf_cat(b, tmp, (size_t)digits);
+}
+
+static void buf_cat_date(struct text_buffer *b, duckdb_date date) {
+    duckdb_date_struct d;
+    char tmp[32];
+    int len;
+    int32_t year;
+
+    if (!duckdb_is_finite_date(date)) {
+        if (date.days > 0) {
+            BUF_CAT_LITERAL(b, "infinity");
+        } else {
+            BUF_CAT_LITERAL(b, "-infinity");
+        }
+        return;
+    }
+    d = duckdb_from_date(date);
+    year = d.year > 0 ? d.year : 1 - d.year;
+    len = snprintf(tmp, sizeof(tmp), "%04d-%02d-%02d", (int)year, (int)d.month, (int)d.day);
+    buf_cat(b, tmp, (size_t)len);
+    if (d.year <= 0) {
+        BUF_CAT_LITERAL(b, " (BC)");
+    }
+}
+
+static void buf_cat_time(struct text_buffer *b, int hour, int min, int sec, uint64_t fraction, int digits) {
+    char tmp[16];
+    int len = snprintf(tmp, sizeof(tmp), "%02d:%02d:%02d", hour, min, sec);
+
+    buf_cat(b, tmp, (size_t)len);
+    buf_cat_fraction(b, fraction, digits);
+}
+
+/* nanos is the sub-microsecond part (0-999) used when digits is 9. */
+static void buf_cat_timestamp(struct text_buffer *b, int64_t micros, uint64_t nanos, int digits) {
+    duckdb_timestamp ts;
+    duckdb_timestamp_struct t;
+
+    ts.micros = micros;
+    if (!duckdb_is_finite_timestamp(ts)) {
+        if (micros > 0) {
+            BUF_CAT_LITERAL(b, "infinity");
+        } else {
+            BUF_CAT_LITERAL(b, "-infinity");
+        }
+        return;
+    }
+    t = duckdb_from_timestamp(ts);
+    buf_cat_date(b, duckdb_to_date(t.date));
+    buf_putc(b, ' ');
+    buf_cat_time(b, t.time.hour, t.time.min, t.time.sec,
+                 digits == 9 ? (uint64_t)t.time.micros * 1000 + nanos : (uint64_t)t.time.micros, digits);
+}
+
+static void buf_cat_time_tz(struct text_buffer *b, duckdb_time_tz tz) {
+    duckdb_time_tz_struct t = duckdb_from_time_tz(tz);
+    int32_t offset = t.offset;
+    char tmp[16];
+    int len;
+
+    buf_cat_time(b, t.time.hour, t.time.min, t.time.sec, (uint64_t)t.time.micros, 6);
+    buf_putc(b, offset < 0 ? '-' : '+');
+    if (offset < 0) {
+        offset = -offset;
+    }
+    len = snprintf(tmp, sizeof(tmp), "%02d", (int)(offset / 3600));
+    buf_cat(b, tmp, (size_t)len);
+    if (offset % 3600 != 0) {
+        len = snprintf(tmp, sizeof(tmp), ":%02d", (int)(offset % 3600 / 60));
+        buf_cat(b, tmp, (size_t)len);
+    }
+    if (offset % 60 != 0) {
+        len = snprintf(tmp, sizeof(tmp), ":%02d", (int)(offset % 60));
+        buf_cat(b, tmp, (size_t)len);
+    }
+}
+
+/* Writes the interval in DuckDB's text format, e.g. "1 year 2 days 03:00:00". */
+static void buf_cat_interval(struct text_buffer *b, duckdb_interval interval) {
+    int32_t parts[3];
+    static const char *const units[3] = {"year", "month", "day"};
+    uint64_t micros;
+    uint64_t hours;
+    bool written = false;
+    char tmp[16];
+    int len;
+    int i;
+
+    parts[0] = interval.months / 12;
+    parts[1] = interval.months % 12;
+    parts[2] = interval.days;
+
+    for (i = 0; i < 3; i++) {
+        if (parts[i] == 0) {
+            continue;
+        }
+        if (written) {
+            buf_putc(b, ' ');
+        }
+        buf_cat_i64(b, parts[i]);
+        buf_putc(b, ' ');
+        buf_cat(b, units[i], strlen(units[i]));
+        if (parts[i] != 1 && parts[i] != -1) {
+            buf_putc(b, 's');
+        }
+        written = true;
+    }
+    if (interval.micros == 0 && written) {
+        return;
+    }
+    if (written) {
+        buf_putc(b, ' ');
+    }
+    if (interval.micros < 0) {
+        buf_putc(b, '-');
+    }
+    micros = interval.micros < 0 ? (uint64_t)0 - (uint64_t)interval.micros : (uint64_t)interval.micros;
+    hours = micros / 3600000000ULL;
+    if (hours < 10) {
+        buf_putc(b, '0');
+    }
+    buf_cat_u64(b, hours);
+    len = snprintf(tmp, sizeof(tmp), ":%02d:%02d", (int)(micros / 60000000ULL % 60), (int)(micros / 1000000ULL % 60));
+    buf_cat(b, tmp, (size_t)len);
+    buf_cat_fraction(b, micros % 1000000ULL, 6);
+}
+
+/* Writes the blob in DuckDB's text format: printable ASCII as is, other bytes as \xNN. */
+static void buf_cat_blob(struct text_buffer *b, const char *p, size_t len) {
+    static const char hex[] = "0123456789ABCDEF";
+    unsigned char c;
+    char esc[4];
+    size_t i;
+
+    for (i = 0; i < len; i++) {
+        c = (unsigned char)p[i];
+        if (c >= 32 && c <= 126 && c != '\\' && c != '\'' && c != '"') {
+            buf_putc(b, (char)c);
+        } else {
+            esc[0] = '\\';
+            esc[1] = 'x';
+            esc[2] = hex[c >> 4];
+            esc[3] = hex[c & 0xf];
+            buf_cat(b, esc, 4);
+        }
+    }
+}
+
+/* The first byte of a BIT value is the number of padding bits of the second. */
+static void buf_cat_bit(struct text_buffer *b, const char *p, size_t len) {
+    size_t i;
+    int bit;
+    int offset;
+
+    if (len == 0) {
+        return;
+    }
+    offset = (unsigned char)p[0];
+    for (i = 1; i < len; i++) {
+        for (bit = 7; bit >= 0; bit--) {
+            if (i == 1 && 7 - bit < offset) {
+                continue;
+            }
+            buf_putc(b, (((unsigned char)p[i] >> bit) & 1) ? '1' : '0');
+        }
+    }
+}
+
+/* Takes the ownership of ty. Raises for the types that cannot be encoded. */
+static void text_encoder_init(struct text_encoder *e, duckdb_logical_type ty) {
+    duckdb_logical_type child_type;
+    char *name;
+    idx_t i;
+
+    e->type = ty;
+    e->type_id = duckdb_get_type_id(ty);
+
+    /* Only the types encode_value handles; anything else is rejected up front. */
+    switch(e->type_id) {
+        case DUCKDB_TYPE_SQLNULL:
+        case DUCKDB_TYPE_BOOLEAN:
+        case DUCKDB_TYPE_TINYINT:
+        case DUCKDB_TYPE_SMALLINT:
+        case DUCKDB_TYPE_INTEGER:
+        case DUCKDB_TYPE_BIGINT:
+        case DUCKDB_TYPE_UTINYINT:
+        case DUCKDB_TYPE_USMALLINT:
+        case DUCKDB_TYPE_UINTEGER:
+        case DUCKDB_TYPE_UBIGINT:
+        case DUCKDB_TYPE_HUGEINT:
+        case DUCKDB_TYPE_UHUGEINT:
+        case DUCKDB_TYPE_FLOAT:
+        case DUCKDB_TYPE_DOUBLE:
+        case DUCKDB_TYPE_VARCHAR:
+        case DUCKDB_TYPE_BLOB:
+        case DUCKDB_TYPE_BIT:
+        case DUCKDB_TYPE_DATE:
+        case DUCKDB_TYPE_TIME:
+        case DUCKDB_TYPE_TIME_NS:
+        case DUCKDB_TYPE_TIME_TZ:
+        case DUCKDB_TYPE_TIMESTAMP:
+        case DUCKDB_TYPE_TIMESTAMP_TZ:
+        case DUCKDB_TYPE_TIMESTAMP_S:
+        case DUCKDB_TYPE_TIMESTAMP_MS:
+        case DUCKDB_TYPE_TIMESTAMP_NS:
+        case DUCKDB_TYPE_INTERVAL:
+        case DUCKDB_TYPE_UUID:
+            break;
+        case DUCKDB_TYPE_ENUM:
+            e->enum_internal_type = duckdb_enum_internal_type(ty);
+            e->enum_size = duckdb_enum_dictionary_size(ty);
+            e->enum_values = ZALLOC_N(char *, e->enum_size);
+            for (i = 0; i < e->enum_size; i++) {
+                e->enum_values[i] = duckdb_enum_dictionary_value(ty, i);
+            }
+            break;
+        case DUCKDB_TYPE_DECIMAL:
+            e->decimal_internal_type = duckdb_decimal_internal_type(ty);
+            e->decimal_scale = duckdb_decimal_scale(ty);
+            break;
+        case DUCKDB_TYPE_LIST:
+        case DUCKDB_TYPE_ARRAY:
+            e->child_count = 1;
+            e->children = ZALLOC_N(struct text_encoder, 1);
+            if (e->type_id == DUCKDB_TYPE_LIST) {
+                child_type = duckdb_list_type_child_type(ty);
+            } else {
+                child_type = duckdb_array_type_child_type(ty);
+                e->array_size = duckdb_array_type_array_size(ty);
+            }
+            text_encoder_init(&e->children[0], child_type);
+            break;
+        case DUCKDB_TYPE_MAP:
+            e->child_count = 2;
+            e->children = ZALLOC_N(struct text_encoder, 2);
+            text_encoder_init(&e->children[0], duckdb_map_type_key_type(ty));
+            text_encoder_init(&e->children[1], duckdb_map_type_value_type(ty));
+            break;
+        case DUCKDB_TYPE_STRUCT:
+            e->child_count = duckdb_struct_type_child_count(ty);
+            e->children = ZALLOC_N(struct text_encoder, e->child_count);
+            e->keys = ZALLOC_N(struct text_buffer, e->child_count);
+            for (i = 0; i < e->child_count; i++) {
+                name = duckdb_struct_type_child_name(ty, i);
+                buf_cat_json_string(&e->keys[i], name ? name : "", name ? strlen(name) : 0);
+                buf_putc(&e->keys[i], ':');
+                duckdb_free(name);
+                text_encoder_init(&e->children[i], duckdb_struct_type_child_type(ty, i));
+            }
+            break;
+        case DUCKDB_TYPE_UNION:
+            e->child_count = duckdb_union_type_member_count(ty);
+            e->children = ZALLOC_N(struct text_encoder, e->child_count);
+            for (i = 0; i < e->child_count; i++) {
+                text_encoder_init(&e->children[i], duckdb_union_type_member_type(ty, i));
+            }
+            break;
+        default:
+            rb_raise(eDuckDBError, "cannot serialize a column of type %d", (int)e->type_id);
+    }
+}
+
+static void text_encoder_destroy(struct text_encoder *e) {
+    idx_t i;
+
+    if (e->enum_values) {
+        for (i = 0; i < e->enum_size; i++) {
+            if (e->enum_values[i]) {
+                duckdb_free(e->enum_values[i]);
+            }
+        }
+        xfree(e->enum_values);
+        e->enum_values = NULL;
+    }
+    if (e->keys) {
+        for (i = 0; i < e->child_count; i++) {
+            buf_free(&e->keys[i]);
+        }
+        xfree(e->keys);
+        e->keys = NULL;
+    }
+    if (e->children) {
+        for (i = 0; i < e->child_count; i++) {
+            text_encoder_destroy(&e->children[i]);
+        }
+        xfree(e->children);
+        e->children = NULL;
+    }
+    if (e->type) {
+        duckdb_destroy_logical_type(&(e->type));
+    }
+}
+
+static void text_encoder_set_vector(struct text_encoder *e, duckdb_vector vector) {
+    duckdb_vector child;
+    idx_t i;
+
+    e->data = duckdb_vector_get_data(vector);
+    e->validity = duckdb_vector_get_validity(vector);
+
+    switch(e->type_id) {
+        case DUCKDB_TYPE_LIST:
+            text_encoder_set_vector(&e->children[0], duckdb_list_vector_get_child(vector));
+            break;
+        case DUCKDB_TYPE_ARRAY:
+            text_encoder_set_vector(&e->children[0], duckdb_array_vector_get_child(vector));
+            break;
+        case DUCKDB_TYPE_MAP:
+            child = duckdb_list_vector_get_child(vector);
+            text_encoder_set_vector(&e->children[0], duckdb_struct_vector_get_child(child, 0));
+            text_encoder_set_vector(&e->children[1], duckdb_struct_vector_get_child(child, 1));
+            break;
+        case DUCKDB_TYPE_STRUCT:
+            for (i = 0; i < e->child_count; i++) {
+                text_encoder_set_vector(&e->children[i], duckdb_struct_vector_get_child(vector, i));
+            }
+            break;
+        case DUCKDB_TYPE_UNION:
+            e->union_tags = duckdb_vector_get_data(duckdb_struct_vector_get_child(vector, 0));
+            for (i = 0; i < e->child_count; i++) {
+                text_encoder_set_vector(&e->children[i], duckdb_struct_vector_get_child(vector, i + 1));
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+/*
+ * Appends the value at row_idx. ENCODE_JSON writes a JSON value; ENCODE_TEXT
+ * writes strings and temporal values unquoted, and nested values as JSON.
+ * Returns false, writing nothing, when the value is NULL.
+ */
+static bool encode_value(struct text_encoder *e, idx_t row_idx, struct text_buffer *b, enum encode_mode mode) {
+    void *data = e->data;
+    bool quote = mode == ENCODE_JSON;
+    duckdb_hugeint h;
+    int64_t v;
+    char uuid[36];
+    uint8_t tag;
+
+    if (e->type_id == DUCKDB_TYPE_SQLNULL || (e->validity && !duckdb_validity_row_is_valid(e->validity, row_idx))) {
+        return false;
+    }
+
+    switch(e->type_id) {
+        case DUCKDB_TYPE_BOOLEAN:
+            if (((bool *)data)[row_idx]) {
+                BUF_CAT_LITERAL(b, "true");
+            } else {
+                BUF_CAT_LITERAL(b, "false");
+            }
+            return true;
+        case DUCKDB_TYPE_TINYINT:
+            buf_cat_i64(b, ((int8_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_SMALLINT:
+            buf_cat_i64(b, ((int16_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_INTEGER:
+            buf_cat_i64(b, ((int32_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_BIGINT:
+            buf_cat_i64(b, ((int64_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_UTINYINT:
+            buf_cat_u64(b, ((uint8_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_USMALLINT:
+            buf_cat_u64(b, ((uint16_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_UINTEGER:
+            buf_cat_u64(b, ((uint32_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_UBIGINT:
+            buf_cat_u64(b, ((uint64_t *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_HUGEINT:
+            buf_cat_hugeint(b, ((duckdb_hugeint *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_UHUGEINT:
+            buf_cat_uhugeint(b, ((duckdb_uhugeint *)data)[row_idx]);
+            return true;
+        case DUCKDB_TYPE_FLOAT:
+            buf_cat_double(b, ((float *)data)[row_idx], true, mode);
+            return true;
+        case DUCKDB_TYPE_DOUBLE:
+            buf_cat_double(b, ((double *)data)[row_idx], false, mode);
+            return true;
+        case DUCKDB_TYPE_DECIMAL:
+            switch(e->decimal_internal_type) {
+                case DUCKDB_TYPE_SMALLINT:
+                    v = ((int16_t *)data)[row_idx];
+                    break;
+                case DUCKDB_TYPE_INTEGER:
+                    v = ((int32_t *)data)[row_idx];
+                    break;
+                case DUCKDB_TYPE_BIGINT:
+                    v = ((int64_t *)data)[row_idx];
+                    break;
+                default:
+                    buf_cat_decimal(b, ((duckdb_hugeint *)data)[row_idx], e->decimal_scale);
+                    return true;
+            }
+            h.lower = (uint64_t)v;
+            h.upper = v < 0 ? -1 : 0;
+            buf_cat_decimal(b, h, e->decimal_scale);
+            return true;
+        case DUCKDB_TYPE_VARCHAR:
+        case DUCKDB_TYPE_BLOB:
+        case DUCKDB_TYPE_BIT:
+        case DUCKDB_TYPE_ENUM:
+            encode_string(e, row_idx, b, mode);
+            return true;
+        case DUCKDB_TYPE_LIST:
+        case DUCKDB_TYPE_ARRAY:
+        case DUCKDB_TYPE_MAP:
+        case DUCKDB_TYPE_STRUCT:
+            encode_nested(e, row_idx, b);
+            return true;
+        case DUCKDB_TYPE_UNION:
+            tag = e->union_tags[row_idx];
+            if (tag >= e->child_count || !encode_value(&e->children[tag], row_idx, b, mode)) {
+                return false;
+            }
+            return true;
+        default:
+            break;
+    }
+
+    if (quote) {
+        buf_putc(b, '"');
+    }
+    switch(e->type_id) {
+        case DUCKDB_TYPE_DATE:
+            buf_cat_date(b, ((duckdb_date *)data)[row_idx]);
+            break;
+        case DUCKDB_TYPE_TIME:
+            {
+                duckdb_time_struct t = duckdb_from_time(((duckdb_time *)data)[row_idx]);
+                buf_cat_time(b, t.hour, t.min, t.sec, (uint64_t)t.micros, 6);
+            }
+            break;
+        case DUCKDB_TYPE_TIME_NS:
+            {
+                int64_t nanos = ((duckdb_time_ns *)data)[row_idx].nanos;
+                buf_cat_time(b, (int)(nanos / 3600000000000LL), (int)(nanos / 60000000000LL % 60),
+                             (int)(nanos / 1000000000LL % 60), (uint64_t)(nanos % 1000000000LL), 9);
+            }
+            break;
+        case DUCKDB_TYPE_TIME_TZ:
+            buf_cat_time_tz(b, ((duckdb_time_tz *)data)[row_idx]);
+            break;
+        case DUCKDB_TYPE_TIMESTAMP:
+            buf_cat_timestamp(b, ((duckdb_timestamp *)data)[row_idx].micros, 0, 6);
+            break;
+        case DUCKDB_TYPE_TIMESTAMP_TZ:
+            buf_cat_timestamp(b, ((duckdb_timestamp *)data)[row_idx].micros, 0, 6);
+            BUF_CAT_LITERAL(b, "+00");
+            break;
+        case DUCKDB_TYPE_TIMESTAMP_S:
+            v = ((duckdb_timestamp_s *)data)[row_idx].seconds;
+            if (duckdb_is_finite_timestamp_s(((duckdb_timestamp_s *)data)[row_idx])) {
+                buf_cat_timestamp(b, v * 1000000, 0, 6);
+            } else {
+                buf_cat_timestamp(b, v > 0 ? INT64_MAX : -INT64_MAX, 0, 6);
+            }
+            break;
+        case DUCKDB_TYPE_TIMESTAMP_MS:
+            v = ((duckdb_timestamp_ms *)data)[row_idx].millis;
+            if (duckdb_is_finite_timestamp_ms(((duckdb_timestamp_ms *)data)[row_idx])) {
+                buf_cat_timestamp(b, v * 1000, 0, 6);
+            } else {
+                buf_cat_timestamp(b, v > 0 ? INT64_MAX : -INT64_MAX, 0, 6);
+            }
+            break;
+        case DUCKDB_TYPE_TIMESTAMP_NS:
+            v = ((duckdb_timestamp_ns *)data)[row_idx].nanos;
+            if (duckdb_is_finite_timestamp_ns(((duckdb_timestamp_ns *)data)[row_idx])) {
+                int64_t micros = v / 1000 - (v % 1000 < 0 ? 1 : 0);
+                buf_cat_timestamp(b, micros, (uint64_t)(v - micros * 1000), 9);
+            } else {
+                buf_cat_timestamp(b, v > 0 ? INT64_MAX : -INT64_MAX, 0, 6);
+            }
+            break;
+        case DUCKDB_TYPE_INTERVAL:
+            buf_cat_interval(b, ((duckdb_interval *)data)[row_idx]);
+            break;
+        case DUCKDB_TYPE_UUID:
+            h = ((duckdb_hugeint *)data)[row_idx];
+            rbduckdb_uuid_to_str((uint64_t)h.upper ^ 0x8000000000000000ULL, h.lower, uuid);
+            buf_cat(b, uuid, sizeof(uuid));
+            break;
+        default:
+            break;
+    }
+    if (quote) {
+        buf_putc(b, '"');
+    }
+    return true;
+}
+
+static void encode_string(struct text_encoder *e, idx_t row_idx, struct text_buffer *b, enum encode_mode mode) {
+    duckdb_string_t *s;
+    const char *p;
+    size_t len;
+    size_t start;
+    uint32_t code;
+    char *copy;
+
+    if (e->type_id == DUCKDB_TYPE_ENUM) {
+        switch(e->enum_internal_type) {
+            case DUCKDB_TYPE_UTINYINT:
+                code = ((uint8_t *)e->data)[row_idx];
+                break;
+            case DUCKDB_TYPE_USMALLINT:
+                code = ((uint16_t *)e->data)[row_idx];
+                break;
+            default:
+                code = ((uint32_t *)e->data)[row_idx];
+                break;
+        }
+        p = code < e->enum_size && e->enum_values[code] ? e->enum_values[code] : "";
+        len = strlen(p);
+    } else {
+        s = &((duckdb_string_t *)e->data)[row_idx];
+        p = duckdb_string_t_data(s);
+        len = duckdb_string_t_length(*s);
+    }
+
+    if (e->type_id == DUCKDB_TYPE_VARCHAR || e->type_id == DUCKDB_TYPE_ENUM) {
+        if (mode == ENCODE_JSON) {
+            buf_cat_json_string(b, p, len);
+        } else {
+            buf_cat(b, p, len);
+        }
+        return;
+    }
+
+    start = b->len;
+    if (e->type_id == DUCKDB_TYPE_BLOB) {
+        buf_cat_blob(b, p, len);
+    } else {
+        buf_cat_bit(b, p, len);
+    }
+    if (mode == ENCODE_JSON && !b->failed) {
+        /* the text of BLOB and BIT needs no escape but backslashes */
+        len = b->len - start;
+        copy = malloc(len);
+        if (copy == NULL) {
+            b->failed = true;
+            return;
+        }
+        memcpy(copy, b->ptr + start, len);
+        b->len = start;
+        buf_cat_json_string(b, copy, len);
+        free(copy);
+    }
+}
+
+static void encode_nested(struct text_encoder *e, idx_t row_idx, struct text_buffer *b) {
+    duckdb_list_entry entry;
+    idx_t i;
+    idx_t bgn;
+    idx_t end;
+
+    if (e->type_id == DUCKDB_TYPE_STRUCT) {
+        buf_putc(b, '{');
+        for (i = 0; i < e->child_count; i++) {
+            if (i > 0) {
+                buf_putc(b, ',');
+            }
+            buf_cat(b, e->keys[i].ptr, e->keys[i].len);
+            if (!encode_value(&e->children[i], row_idx, b, ENCODE_JSON)) {
+                BUF_CAT_LITERAL(b, "null");
+            }
+        }
+        buf_putc(b, '}');
+        return;
+    }
+
+    if (e->type_id == DUCKDB_TYPE_ARRAY) {
+        bgn = row_idx * e->array_size;
+        end = bgn + e->array_size;
+    } else {
+        entry = ((duckdb_list_entry *)e->data)[row_idx];
+        bgn = entry.offset;
+        end = entry.offset + entry.length;
+    }
+
+    buf_putc(b, e->type_id == DUCKDB_TYPE_MAP ? '{' : '[');
+    for (i = bgn; i < end; i++) {
+        if (i > bgn) {
+            buf_putc(b, ',');
+        }
+        if (e->type_id == DUCKDB_TYPE_MAP) {
+            encode_json_key(&e->children[0], i, b);
+            buf_putc(b, ':');
+            if (!encode_value(&e->children[1], i, b, ENCODE_JSON)) {
+                BUF_CAT_LITERAL(b, "null");
+            }
+        } else if (!encode_value(&e->children[0], i, b, ENCODE_JSON)) {
+            BUF_CAT_LITERAL(b, "null");
+        }
+    }
+    buf_putc(b, e->type_id == DUCKDB_TYPE_MAP ? '}' : ']');
+}
+
+/* JSON object keys must be strings: MAP keys are written as their quoted text. */
+static void encode_json_key(struct text_encoder *e, idx_t row_idx, struct text_buffer *b) {
+    size_t start;
+    size_t len;
+    char *copy;
+
+    if (e->type_id == DUCKDB_TYPE_VARCHAR || e->type_id == DUCKDB_TYPE_ENUM) {
+        encode_value(e, row_idx, b, ENCODE_JSON);
+        return;
+    }
+    start = b->len;
+    if (!encode_value(e, row_idx, b, ENCODE_TEXT)) {
+        BUF_CAT_LITERAL(b, "\"\"");
+        return;
+    }
+    if (b->failed) {
+        return;
+    }
+    len = b->len - start;
+    copy = malloc(len);
+    if (copy == NULL) {
+        b->failed = true;
+        return;
+    }
+    memcpy(copy, b->ptr + start, len);
+    b->len = start;
+    buf_cat_json_string(b, copy, len);
+    free(copy);
+}
+
+/*
+ * Quotes the field when it contains the delimiter, a double quote or a line
+ * break, or when it would read back as NULL. Quotes are escaped by doubling.
+ */
+static void buf_cat_csv_field(struct result_writer *w, struct text_buffer *b, const char *p, size_t len) {
+    const char *delimiter = w->delimiter.ptr;
+    size_t delimiter_len = w->delimiter.len;
+    bool quote = len == w->null_text.len && (len == 0 || memcmp(p, w->null_text.ptr, len) == 0);
+    size_t i;
+
+    for (i = 0; i < len && !quote; i++) {
+        if (p[i] == '"' || p[i] == '\n' || p[i] == '\r' ||
+            (p[i] == delimiter[0] && len - i >= delimiter_len && memcmp(p + i, delimiter, delimiter_len) == 0)) {
+            quote = true;
+        }
+    }
+    if (!quote) {
+        buf_cat(b, p, len);
+        return;
+    }
+
+    buf_grow(b, len + 2);
+    buf_putc(b, '"');
+    for (i = 0; i < len; i++) {
+        if (p[i] == '"') {
+            buf_putc(b, '"');
+        }
+        buf_putc(b, p[i]);
+    }
+    buf_putc(b, '"');
+}
+
+static void writer_init(struct result_writer *w) {
+    const char *name;
+    idx_t col_idx;
+
+    w->col_count = duckdb_column_count(&(w->ctx->result));
+    w->encoders = ZALLOC_N(struct text_encoder, w->col_count);
+    w->keys = ZALLOC_N(struct text_buffer, w->col_count);
+    if (w->format == WRITE_JSON_COLUMNS) {
+        w->columns = ZALLOC_N(struct text_buffer, w->col_count);
+    }
+
+    for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+        name = duckdb_column_name(&(w->ctx->result), col_idx);
+        if (w->format == WRITE_CSV) {
+            buf_cat_csv_field(w, &w->keys[col_idx], name, strlen(name));
+        } else {
+            buf_cat_json_string(&w->keys[col_idx], name, strlen(name));
+            buf_putc(&w->keys[col_idx], ':');
+        }
+        text_encoder_init(&w->encoders[col_idx], duckdb_column_logical_type(&(w->ctx->result), col_idx));
+    }
+}
+
+static VALUE writer_cleanup(VALUE arg) {
+    struct result_writer *w = (struct result_writer *)arg;
+    idx_t col_idx;
+
+    if (w->chunk) {
+        duckdb_destroy_data_chunk(&(w->chunk));
+    }
+    for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+        if (w->encoders) {
+            text_encoder_destroy(&w->encoders[col_idx]);
+        }
+        if (w->keys) {
+            buf_free(&w->keys[col_idx]);
+        }
+        if (w->columns) {
+            buf_free(&w->columns[col_idx]);
+        }
+    }
+    xfree(w->encoders);
+    xfree(w->keys);
+    xfree(w->columns);
+    w->encoders = NULL;
+    w->keys = NULL;
+    w->columns = NULL;
+    buf_free(&w->out);
+    buf_free(&w->field);
+    buf_free(&w->delimiter);
+    buf_free(&w->null_text);
+    return Qnil;
+}
+
+static void writer_encode_row(struct result_writer *w) {
+    struct text_buffer *b = &w->out;
+    idx_t col_idx;
+
+    if (w->format == WRITE_JSON_COLUMNS) {
+        for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+            b = &w->columns[col_idx];
+            if (w->rows > 0) {
+                buf_putc(b, ',');
+            }
+            if (!encode_value(&w->encoders[col_idx], w->row_idx, b, ENCODE_JSON)) {
+                BUF_CAT_LITERAL(b, "null");
+            }
+        }
+        return;
+    }
+
+    if (w->format == WRITE_CSV) {
+        for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+            if (col_idx > 0) {
+                buf_cat(b, w->delimiter.ptr, w->delimiter.len);
+            }
+            w->field.len = 0;
+            if (encode_value(&w->encoders[col_idx], w->row_idx, &w->field, ENCODE_TEXT)) {
+                buf_cat_csv_field(w, b, w->field.ptr, w->field.len);
+            } else {
+                buf_cat(b, w->null_text.ptr, w->null_text.len);
+            }
+        }
+        buf_putc(b, '\n');
+        return;
+    }
+
+    if (w->format == WRITE_JSON_RECORDS && w->rows > 0) {
+        buf_putc(b, ',');
+    }
+    buf_putc(b, '{');
+    for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+        if (col_idx > 0) {
+            buf_putc(b, ',');
+        }
+        buf_cat(b, w->keys[col_idx].ptr, w->keys[col_idx].len);
+        if (!encode_value(&w->encoders[col_idx], w->row_idx, b, ENCODE_JSON)) {
+            BUF_CAT_LITERAL(b, "null");
+        }
+    }
+    buf_putc(b, '}');
+    if (w->format == WRITE_NDJSON) {
+        buf_putc(b, '\n');
+    }
+}
+
+static void writer_set_chunk(struct result_writer *w) {
+    idx_t col_idx;
+
+    w->chunk_size = duckdb_data_chunk_get_size(w->chunk);
+    for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+        text_encoder_set_vector(&w->encoders[col_idx], duckdb_data_chunk_get_vector(w->chunk, col_idx));
+    }
+}
+
+/* Fetches and encodes chunks until the buffer is large enough to be flushed. */
+static void *writer_encode_without_gvl(void *arg) {
+    struct result_writer *w = (struct result_writer *)arg;
+
+    while (!w->interrupted && !w->out.failed && !w->field.failed && w->out.len < WRITER_FLUSH_SIZE) {
+        if (w->chunk == NULL) {
+            w->chunk = rbduckdb_result_fetch_chunk(w->ctx);
+            if (w->chunk == NULL) {
+                w->done = true;
+                break;
+            }
+            w->row_idx = 0;
+            writer_set_chunk(w);
+        }
+        while (w->row_idx < w->chunk_size && !w->interrupted) {
+            writer_encode_row(w);
+            w->row_idx++;
+            w->rows++;
+        }
+        if (w->row_idx == w->chunk_size) {
+            duckdb_destroy_data_chunk(&(w->chunk));
+            w->chunk = NULL;
+        }
+    }
+    return NULL;
+}
+
+static void writer_stop(void *arg) {
+    struct result_writer *w = (struct result_writer *)arg;
+
+    w->interrupted = true;
+}
+
+static void writer_flush(struct result_writer *w) {
+    VALUE str;
+
+    if (w->out.len == 0) {
+        return;
+    }
+    if (RB_TYPE_P(w->io, T_STRING)) {
+        rb_str_cat(w->io, w->out.ptr, (long)w->out.len);
+    } else {
+        str = rb_utf8_str_new(w->out.ptr, (long)w->out.len);
+        rb_io_write(w->io, str);
+    }
+    w->out.len = 0;
+}
+
+static VALUE writer_run(VALUE arg) {
+    struct result_writer *w = (struct result_writer *)arg;
+    idx_t col_idx;
+    size_t i;
+
+    writer_init(w);
+    /* start with the rows #fetch left in its chunk */
+    w->chunk = rbduckdb_result_take_pending_chunk(w->result, &w->row_idx);
+    if (w->chunk) {
+        writer_set_chunk(w);
+    }
+    if (w->format == WRITE_JSON_RECORDS) {
+        buf_putc(&w->out, '[');
+    } else if (w->format == WRITE_CSV && w->header) {
+        for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+            if (col_idx > 0) {
+                buf_cat(&w->out, w->delimiter.ptr, w->delimiter.len);
+            }
+            buf_cat(&w->out, w->keys[col_idx].ptr, w->keys[col_idx].len);
+        }
+        buf_putc(&w->out, '\n');
+    }
+
+    while (!w->done) {
+        w->interrupted = false;
+        rb_thread_call_without_gvl(writer_encode_without_gvl, w, writer_stop, w);
+        if (w->out.failed || w->field.failed) {
+            rb_raise(rb_eNoMemError, "failed to allocate the output buffer");
+        }
+        if (w->interrupted) {
+            rb_thread_check_ints();
+        }
+        if (w->out.len >= WRITER_FLUSH_SIZE) {
+            writer_flush(w);
+        }
+    }
+
+    if (w->format == WRITE_JSON_RECORDS) {
+        buf_putc(&w->out, ']');
+    } else if (w->format == WRITE_JSON_COLUMNS) {
+        buf_putc(&w->out, '{');
+        for (col_idx = 0; col_idx < w->col_count; col_idx++) {
+            if (col_idx > 0) {
+                buf_putc(&w->out, ',');
+            }
+            buf_cat(&w->out, w->keys[col_idx].ptr, w->keys[col_idx].len);
+            buf_putc(&w->out, '[');
+            /* hand each column over in flush-sized pieces */
+            for (i = 0; i < w->columns[col_idx].len; i += WRITER_FLUSH_SIZE) {
+                buf_cat(&w->out, w->columns[col_idx].ptr + i,
+                        w->columns[col_idx].len - i < WRITER_FLUSH_SIZE ? w->columns[col_idx].len - i : WRITER_FLUSH_SIZE);
+                if (w->out.len >= WRITER_FLUSH_SIZE) {
+                    writer_flush(w);
+                }
+            }
+            buf_free(&w->columns[col_idx]);
+            buf_putc(&w->out, ']');
+        }
+        buf_putc(&w->out, '}');
+    }
+    if (w->out.failed) {
+        rb_raise(rb_eNoMemError, "failed to allocate the output buffer");
+    }
+    writer_flush(w);
+    return ULL2NUM(w->rows);
+}
+
+/* :nodoc: */
+static VALUE result__write_json(VALUE oDuckDBResult, VALUE io, VALUE format) {
+    struct result_writer w;
+
+    memset(&w, 0, sizeof(w));
+    w.result = oDuckDBResult;
+    w.ctx = rbduckdb_get_struct_result(oDuckDBResult);
+    w.io = io;
+    w.format = (enum writer_format)NUM2INT(format);
+    return rb_ensure(writer_run, (VALUE)&w, writer_cleanup, (VALUE)&w);
+}
+
+/* :nodoc: */
+static VALUE result__write_csv(VALUE oDuckDBResult, VALUE io, VALUE delimiter, VALUE header, VALUE null_text) {
+    struct result_writer w;
+
+    StringValue(delimiter);
+    StringValue(null_text);
+    if (RSTRING_LEN(delimiter) == 0) {
+        rb_raise(rb_eArgError, "delimiter must not be empty");
+    }
+
+    memset(&w, 0, sizeof(w));
+    w.result = oDuckDBResult;
+    w.ctx = rbduckdb_get_struct_result(oDuckDBResult);
+    w.io = io;
+    w.format = WRITE_CSV;
+    w.header = RTEST(header);
+    /* copied because the encoding runs without the GVL, where GC may move the strings */
+    buf_cat(&w.delimiter, RSTRING_PTR(delimiter), RSTRING_LEN(delimiter));
+    buf_cat(&w.null_text, RSTRING_PTR(null_text), RSTRING_LEN(null_text));
+    return rb_ensure(writer_run, (VALUE)&w, writer_cleanup, (VALUE)&w);
+}
+
+void rbduckdb_init_result_writer(void) {
+#if 0
+    VALUE mDuckDB = rb_define_module("DuckDB");
+#endif
+    VALUE cDuckDBResult = rb_define_class_under(mDuckDB, "Result", rb_cObject);
+
+    rb_define_private_method(cDuckDBResult, "_write_json", result__write_json, 2);
+    rb_define_private_method(cDuckDBResult, "_write_csv", result__write_csv, 4);
+}
@@ -0,0 +1,6 @@
+#ifndef RUBY_DUCKDB_RESULT_WRITER_H
+#define RUBY_DUCKDB_RESULT_WRITER_H
+
+void rbduckdb_init_result_writer(void);
+
+#endif
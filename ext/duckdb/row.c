@@ -0,0 +1,183 @@
+#include "ruby-duckdb.h"
+
+static VALUE cDuckDBRow;
+
+static void mark(void *ctx);
+static void deallocate(void *ctx);
+static size_t memsize(const void *p);
+static void compact(void *ctx);
+static rubyDuckDBRow *get_struct_row(VALUE obj);
+static long column_index(rubyDuckDBRow *ctx, VALUE index);
+static VALUE row_aref(VALUE self, VALUE index);
+static VALUE row_size(VALUE self);
+static VALUE row_columns(VALUE self);
+static VALUE row_to_a(VALUE self);
+static VALUE row_to_h(VALUE self);
+
+static const rb_data_type_t row_data_type = {
+    "DuckDB/Row",
+    {mark, deallocate, memsize, compact},
+    0, 0, RUBY_TYPED_FREE_IMMEDIATELY
+};
+
+static void mark(void *ctx) {
+    rubyDuckDBRow *p = (rubyDuckDBRow *)ctx;
+
+    rb_gc_mark_movable(p->chunk);
+}
+
+static void deallocate(void *ctx) {
+    xfree(ctx);
+}
+
+static size_t memsize(const void *p) {
+    return sizeof(rubyDuckDBRow);
+}
+
+static void compact(void *ctx) {
+    rubyDuckDBRow *p = (rubyDuckDBRow *)ctx;
+
+    p->chunk = rb_gc_location(p->chunk);
+}
+
+VALUE rbduckdb_create_row(VALUE chunk, idx_t row_idx) {
+    rubyDuckDBRow *ctx;
+    VALUE obj = TypedData_Make_Struct(cDuckDBRow, rubyDuckDBRow, &row_data_type, ctx);
+
+    ctx->chunk = chunk;
+    ctx->row_idx = row_idx;
+    return obj;
+}
+
+static rubyDuckDBRow *get_struct_row(VALUE obj) {
+    rubyDuckDBRow *ctx;
+    TypedData_Get_Struct(obj, rubyDuckDBRow, &row_data_type, ctx);
+    return ctx;
+}
+
+/* Returns the column index of index (Integer, String or Symbol), or -1. */
+static long column_index(rubyDuckDBRow *ctx, VALUE index) {
+    long col_count = (long)rbduckdb_result_chunk_column_count(ctx->chunk);
+    VALUE names;
+    long i;
+
+    if (SYMBOL_P(index)) {
+        index = rb_sym2str(index);
+    }
+    if (RB_TYPE_P(index, T_STRING)) {
+        names = rbduckdb_result_chunk_column_names(ctx->chunk);
+        for (i = 0; i < col_count; i++) {
+            if (rb_str_equal(RARRAY_AREF(names, i), index) == Qtrue) {
+                return i;
+            }
+        }
+        return -1;
+    }
+
+    i = NUM2LONG(index);
+    if (i < 0) {
+        i += col_count;
+    }
+    if (i < 0 || i >= col_count) {
+        return -1;
+    }
+    return i;
+}
+
+/*
+ *  call-seq:
+ *    row[index] -> value
+ *    row[name] -> value
+ *
+ *  Decodes and returns the value of the column at index, or of the column
+ *  named name (String or Symbol). Returns nil if there is no such column.
+ *
+ *    result.each_row { |row| ids << row[0] }
+ *    result.each_row { |row| names << row[:name] }
+ */
+static VALUE row_aref(VALUE self, VALUE index) {
+    rubyDuckDBRow *ctx = get_struct_row(self);
+    long col_idx = column_index(ctx, index);
+
+    if (col_idx < 0) {
+        return Qnil;
+    }
+    return rbduckdb_result_chunk_value(ctx->chunk, (idx_t)col_idx, ctx->row_idx);
+}
+
+/*
+ *  call-seq:
+ *    row.size -> Integer
+ *
+ *  Returns the number of columns.
+ */
+static VALUE row_size(VALUE self) {
+    rubyDuckDBRow *ctx = get_struct_row(self);
+
+    return ULL2NUM(rbduckdb_result_chunk_column_count(ctx->chunk));
+}
+
+/*
+ *  call-seq:
+ *    row.columns -> Array
+ *
+ *  Returns the frozen column names.
+ */
+static VALUE row_columns(VALUE self) {
+    rubyDuckDBRow *ctx = get_struct_row(self);
+
+    return rbduckdb_result_chunk_column_names(ctx->chunk);
+}
+
+/*
+ *  call-seq:
+ *    row.to_a -> Array
+ *
+ *  Decodes all the columns and returns them as an Array.
+ */
+static VALUE row_to_a(VALUE self) {
+    rubyDuckDBRow *ctx = get_struct_row(self);
+    idx_t col_count = rbduckdb_result_chunk_column_count(ctx->chunk);
+    VALUE ary = rb_ary_new_capa(col_count);
+    idx_t col_idx;
+
+    for (col_idx = 0; col_idx < col_count; col_idx++) {
+        rb_ary_push(ary, rbduckdb_result_chunk_value(ctx->chunk, col_idx, ctx->row_idx));
+    }
+    return ary;
+}
+
+/*
+ *  call-seq:
+ *    row.to_h -> Hash
+ *
+ *  Decodes all the columns and returns them as a Hash keyed by the column
+ *  names.
+ */
+static VALUE row_to_h(VALUE self) {
+    rubyDuckDBRow *ctx = get_struct_row(self);
+    idx_t col_count = rbduckdb_result_chunk_column_count(ctx->chunk);
+    VALUE names = rbduckdb_result_chunk_column_names(ctx->chunk);
+    VALUE hash = rb_hash_new_capa(col_count);
+    idx_t col_idx;
+
+    for (col_idx = 0; col_idx < col_count; col_idx++) {
+        rb_hash_aset(hash, RARRAY_AREF(names, col_idx),
+                     rbduckdb_result_chunk_value(ctx->chunk, col_idx, ctx->row_idx));
+    }
+    return hash;
+}
+
+void rbduckdb_init_row(void) {
+#if 0
+    VALUE mDuckDB = rb_define_module("DuckDB");
+#endif
+    cDuckDBRow = rb_define_class_under(mDuckDB, "Row", rb_cObject);
+    rb_undef_alloc_func(cDuckDBRow);
+
+    rb_define_method(cDuckDBRow, "[]", row_aref, 1);
+    rb_define_method(cDuckDBRow, "size", row_size, 0);
+    rb_define_method(cDuckDBRow, "columns", row_columns, 0);
+    rb_define_method(cDuckDBRow, "to_a", row_to_a, 0);
+    rb_define_method(cDuckDBRow, "to_h", row_to_h, 0);
+}
@@ -0,0 +1,14 @@
+#ifndef RUBY_DUCKDB_ROW_H
+#define RUBY_DUCKDB_ROW_H
+
+struct _rubyDuckDBRow {
+    VALUE chunk;
+    idx_t row_idx;
+};
+
+typedef struct _rubyDuckDBRow rubyDuckDBRow;
+
+void rbduckdb_init_row(void);
+VALUE rbduckdb_create_row(VALUE chunk, idx_t row_idx);
+
+#endif
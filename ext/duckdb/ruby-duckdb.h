@@ -7,6 +7,8 @@
 #include "ruby.h"
 #include "ruby/thread.h"
 #include "ruby/atomic.h"
+#include "ruby/ractor.h"
+#include "ruby/thread_native.h"
 #include <duckdb.h>
 
 #ifdef HAVE_DUCKDB_UNSAFE_VECTOR_ASSIGN_STRING_ELEMENT_LEN
@@ -21,7 +23,10 @@
 #include "./database.h"
 #include "./connection.h"
 #include "./result.h"
+#include "./result_writer.h"
+#include "./result_buffer.h"
 #include "./column.h"
+#include "./row.h"
 #include "./logical_type.h"
 #include "./prepared_statement.h"
 #include "./extracted_statements.h"
@@ -40,6 +45,7 @@
 #include "./scalar_function_set.h"
 #include "./aggregate_function.h"
 #include "./aggregate_function_set.h"
+#include "./aggregate_function_state.h"
 #include "./expression.h"
 #include "./client_context.h"
 #include "./scalar_function_bind_info.h"
@@ -48,11 +54,14 @@
 #include "./table_function_function_info.h"
 #include "./vector.h"
 #include "./data_chunk.h"
+#include "./data_chunk_writer.h"
 #include "./memory_helper.h"
 #include "./table_function.h"
 #include "./table_description.h"
 #include "./arrow_array_stream.h"
 #include "./arrow_import.h"
+#include "./arrow_scan.h"
+#include "./arrow_append_pipeline.h"
 
 extern VALUE mDuckDB;
 extern VALUE cDuckDBDatabase;
@@ -15,6 +15,9 @@ static VALUE scalar_function__add_parameter(VALUE self, VALUE logical_type);
 static VALUE scalar_function__set_special_handling(VALUE self);
 static VALUE scalar_function_set_function(VALUE self);
 static VALUE scalar_function__set_bind(VALUE self);
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
+static VALUE scalar_function__set_init(VALUE self);
+#endif
 static void scalar_function_callback(duckdb_function_info info, duckdb_data_chunk input, duckdb_vector output);
 static void scalar_function_bind_callback(duckdb_bind_info info);
 #ifdef HAVE_DUCKDB_H_GE_V1_5_0
@@ -24,11 +27,14 @@ static void scalar_function_bind_callback(duckdb_bind_info info);
  */
 extern int ruby_native_thread_p(void);
 static void scalar_function_init_callback(duckdb_init_info info);
+static void scalar_function_local_state_destroy(void *data);
 #endif
 
 
 struct callback_arg {
     rubyDuckDBScalarFunction *ctx;
+    VALUE proc;
+    void *state_handle;
     duckdb_function_info info;
     duckdb_data_chunk input;
     duckdb_vector output;
@@ -43,11 +49,26 @@ static VALUE process_rows(VALUE arg);
 static VALUE process_no_param_rows(VALUE arg);
 static VALUE cleanup_callback(VALUE arg);
 
+/*
+ * The callable for this call site: the one the bind block returned, if any,
+ * otherwise the function's block.
+ */
+static VALUE callback_proc(struct callback_arg *arg) {
+    VALUE proc = Qnil;
+
+    if (arg->ctx->bind_proc != Qnil) {
+        proc = rbduckdb_function_data_lookup(duckdb_scalar_function_get_bind_data(arg->info));
+    }
+    return NIL_P(proc) ? arg->ctx->function_proc : proc;
+}
+
 /* Execute a callback (called with GVL held) */
 static VALUE execute_callback(VALUE varg) {
     struct callback_arg *arg = (struct callback_arg *)varg;
 
-    if (arg->col_count == 0) {
+    arg->proc = callback_proc(arg);
+
+    if (arg->col_count == 0 && arg->ctx->init_proc == Qnil) {
         rb_ensure(process_no_param_rows, (VALUE)arg, cleanup_callback, (VALUE)arg);
     } else {
         rb_ensure(process_rows, (VALUE)arg, cleanup_callback, (VALUE)arg);
@@ -86,6 +107,7 @@ static void mark(void *ctx) {
     rubyDuckDBScalarFunction *p = (rubyDuckDBScalarFunction *)ctx;
     rb_gc_mark(p->function_proc);
     rb_gc_mark(p->bind_proc);
+    rb_gc_mark(p->init_proc);
 }
 
 static void deallocate(void * ctx) {
@@ -108,6 +130,9 @@ static void compact(void *ctx) {
     if (p->bind_proc != Qnil) {
         p->bind_proc = rb_gc_location(p->bind_proc);
     }
+    if (p->init_proc != Qnil) {
+        p->init_proc = rb_gc_location(p->init_proc);
+    }
 }
 
 static VALUE allocate(VALUE klass) {
@@ -125,6 +150,7 @@ static VALUE scalar_function_initialize(VALUE self) {
     p->scalar_function = duckdb_create_scalar_function();
     p->function_proc = Qnil;
     p->bind_proc = Qnil;
+    p->init_proc = Qnil;
     return self;
 }
 
@@ -196,6 +222,9 @@ static void scalar_function_callback(duckdb_function_info info, duckdb_data_chun
     idx_t i;
     struct callback_arg arg;
     struct worker_proxy *proxy = NULL;
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
+    rubyDuckDBScalarFunctionLocalState *local;
+#endif
 
     ctx = (rubyDuckDBScalarFunction *)duckdb_scalar_function_get_extra_info(info);
 
@@ -213,6 +242,8 @@ static void scalar_function_callback(duckdb_function_info info, duckdb_data_chun
 
     /* Initialize callback argument structure */
     arg.ctx = ctx;
+    arg.proc = Qnil;
+    arg.state_handle = NULL;
     arg.info = info;
     arg.input = input;
     arg.output = output;
@@ -223,8 +254,12 @@ static void scalar_function_callback(duckdb_function_info info, duckdb_data_chun
     arg.col_count = duckdb_data_chunk_get_column_count(input);
 
 #ifdef HAVE_DUCKDB_H_GE_V1_5_0
-    /* On DuckDB >= 1.5.0 each worker thread carries its own proxy (see init). */
-    proxy = (struct worker_proxy *)duckdb_scalar_function_get_state(info);
+    /* On DuckDB >= 1.5.0 each worker thread carries its own proxy and init state (see init). */
+    local = (rubyDuckDBScalarFunctionLocalState *)duckdb_scalar_function_get_state(info);
+    if (local != NULL) {
+        proxy = local->proxy;
+        arg.state_handle = local->state_handle;
+    }
 #endif
     rbduckdb_function_executor_dispatch_via_proxy(execute_callback_protected, &arg, proxy);
 }
@@ -234,7 +269,7 @@ static VALUE process_no_param_rows(VALUE varg) {
     idx_t i;
     VALUE result;
 
-    result = rb_funcall(arg->ctx->function_proc, rb_intern("call"), 0);
+    result = rb_funcall(arg->proc, rb_intern("call"), 0);
 
     for (i = 0; i < arg->row_count; i++) {
         rbduckdb_vector_set_value_at(arg->output, arg->output_type, i, result);
@@ -243,13 +278,22 @@ static VALUE process_no_param_rows(VALUE varg) {
     return Qnil;
 }
 
+/*
+ * For functions with an init block, the worker's init state is passed to the
+ * callable ahead of the row's arguments.
+ */
 static VALUE process_rows(VALUE varg) {
     struct callback_arg *arg = (struct callback_arg *)varg;
     idx_t i, j;
     VALUE result;
+    long offset = arg->ctx->init_proc != Qnil ? 1 : 0;
     /* A Ruby Array, not a plain buffer: converting a later column can trigger
      * a GC, and the earlier columns' objects must stay reachable. */
-    VALUE args = rb_ary_new_capa((long)arg->col_count);
+    VALUE args = rb_ary_new_capa((long)arg->col_count + offset);
+
+    if (offset) {
+        rb_ary_store(args, 0, rbduckdb_function_data_lookup(arg->state_handle));
+    }
 
     /* Allocate arrays to hold input vectors and their types */
     arg->input_vectors = ALLOC_N(duckdb_vector, arg->col_count);
@@ -265,11 +309,11 @@ static VALUE process_rows(VALUE varg) {
     for (i = 0; i < arg->row_count; i++) {
         /* Build arguments array for this row using vector_value_at */
         for (j = 0; j < arg->col_count; j++) {
-            rb_ary_store(args, (long)j, rbduckdb_vector_value_at(arg->input_vectors[j], arg->input_types[j], i));
+            rb_ary_store(args, (long)j + offset, rbduckdb_vector_value_at(arg->input_vectors[j], arg->input_types[j], i));
         }
 
         /* Call the Ruby block with the arguments */
-        result = rb_apply(arg->ctx->function_proc, rb_intern("call"), args);
+        result = rb_apply(arg->proc, rb_intern("call"), args);
 
         /* Write result to output using helper function */
         rbduckdb_vector_set_value_at(arg->output, arg->output_type, i, result);
@@ -309,10 +353,12 @@ static VALUE cleanup_callback(VALUE varg) {
  *
  * DuckDB calls this once on each worker thread that will run the execute
  * callback. We create a per-worker proxy (allocating its Ruby thread under the
- * GVL via the global executor, since this runs on a non-Ruby thread) and store
- * it as per-worker state. The execute callback then dispatches through it
- * instead of the shared global executor, so workers run callbacks concurrently.
- * DuckDB invokes rbduckdb_worker_proxy_destroy when the state is freed.
+ * GVL via the global executor, since this runs on a non-Ruby thread). The
+ * execute callback then dispatches through it instead of the shared global
+ * executor, so workers run callbacks concurrently. The init block, if any,
+ * runs through the same proxy and its result is kept in the function data
+ * registry. Both are stored as per-worker state, freed by
+ * scalar_function_local_state_destroy.
  */
 struct create_proxy_callback_arg {
     struct worker_proxy *proxy;
@@ -328,8 +374,8 @@ static VALUE create_proxy_callback(VALUE varg) {
  * rbduckdb_worker_proxy_create may raise (NoMemError, Thread.new failure),
  * and the executor runs callbacks unprotected — a raise would longjmp past
  * its done-signaling and block the waiting DuckDB worker forever. Swallow
- * the exception instead: the proxy stays NULL, init sets no state, and the
- * execute callback falls back to the global executor.
+ * the exception instead: the proxy stays NULL and the execute callback
+ * falls back to the global executor.
  */
 static void create_proxy_callback_protected(void *user_data) {
     int exception_state;
@@ -340,18 +386,84 @@ static void create_proxy_callback_protected(void *user_data) {
     }
 }
 
+struct init_dispatch_arg {
+    rubyDuckDBScalarFunction *ctx;
+    duckdb_init_info info;
+    rubyDuckDBScalarFunctionLocalState *local;
+};
+
+static VALUE call_init_proc(VALUE varg) {
+    struct init_dispatch_arg *darg = (struct init_dispatch_arg *)varg;
+    duckdb_client_context client_context;
+
+    duckdb_scalar_function_init_get_client_context(darg->info, &client_context);
+    return rb_funcall(darg->ctx->init_proc, rb_intern("call"), 1, rbduckdb_client_context_new(client_context));
+}
+
+static void execute_init_callback_protected(void *user_data) {
+    struct init_dispatch_arg *darg = (struct init_dispatch_arg *)user_data;
+    VALUE state;
+    int exception_state;
+
+    state = rb_protect(call_init_proc, (VALUE)darg, &exception_state);
+    if (exception_state) {
+        VALUE msg = rbduckdb_pending_error_message();
+        duckdb_scalar_function_init_set_error(darg->info, StringValueCStr(msg));
+        RB_GC_GUARD(msg);
+        return;
+    }
+    darg->local->state_handle = rbduckdb_function_data_register(state);
+}
+
 static void scalar_function_init_callback(duckdb_init_info info) {
+    rubyDuckDBScalarFunction *ctx;
+    rubyDuckDBScalarFunctionLocalState *local;
     struct create_proxy_callback_arg arg;
+    struct init_dispatch_arg darg;
+    int ruby_thread = ruby_native_thread_p();
+
+    ctx = (rubyDuckDBScalarFunction *)duckdb_scalar_function_init_get_extra_info(info);
+    if (ctx == NULL) return;
 
     /* A Ruby calling thread runs the callback inline (Case 1/2); no proxy needed. */
-    if (ruby_native_thread_p()) return;
+    if (ruby_thread && ctx->init_proc == Qnil) return;
+
+    local = calloc(1, sizeof(rubyDuckDBScalarFunctionLocalState));
+    if (local == NULL) {
+        duckdb_scalar_function_init_set_error(info, "failed to allocate scalar function state");
+        return;
+    }
+
+    if (!ruby_thread) {
+        arg.proxy = NULL;
+        rbduckdb_function_executor_dispatch(create_proxy_callback_protected, &arg);
+        local->proxy = arg.proxy;
+    }
+
+    if (ctx->init_proc != Qnil) {
+        darg.ctx = ctx;
+        darg.info = info;
+        darg.local = local;
+        rbduckdb_function_executor_dispatch_via_proxy(execute_init_callback_protected, &darg, local->proxy);
+    }
 
-    arg.proxy = NULL;
-    rbduckdb_function_executor_dispatch(create_proxy_callback_protected, &arg);
+    duckdb_scalar_function_init_set_state(info, local, scalar_function_local_state_destroy);
+}
+
+/*
+ * Frees a worker's state. Called by DuckDB, possibly from a non-Ruby thread;
+ * the registry entry is released through the executor.
+ */
+static void scalar_function_local_state_destroy(void *data) {
+    rubyDuckDBScalarFunctionLocalState *local = (rubyDuckDBScalarFunctionLocalState *)data;
 
-    if (arg.proxy != NULL) {
-        duckdb_scalar_function_init_set_state(info, arg.proxy, rbduckdb_worker_proxy_destroy);
+    if (local->state_handle != NULL) {
+        rbduckdb_function_data_destroy(local->state_handle);
     }
+    if (local->proxy != NULL) {
+        rbduckdb_worker_proxy_destroy(local->proxy);
+    }
+    free(local);
 }
 #endif
 
@@ -409,6 +521,19 @@ static VALUE scalar_function__set_bind(VALUE self) {
     return self;
 }
 
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
+/* :nodoc: */
+static VALUE scalar_function__set_init(VALUE self) {
+    rubyDuckDBScalarFunction *p;
+
+    TypedData_Get_Struct(self, rubyDuckDBScalarFunction, &scalar_function_data_type, p);
+
+    p->init_proc = rb_block_proc();
+
+    return self;
+}
+#endif
+
 struct bind_call_arg {
     VALUE bind_proc;
     VALUE bind_info_obj;
@@ -429,20 +554,34 @@ struct bind_dispatch_arg {
  * Executes the bind proc under rb_protect, reporting any Ruby exception
  * back to DuckDB via duckdb_scalar_function_bind_set_error.
  * Called via rbduckdb_function_executor_dispatch with the GVL held.
+ *
+ * A Proc or Method returned by the bind proc is stored as the call site's
+ * bind data; the execute callback calls it instead of the function's block.
  */
 static void execute_bind_callback_protected(void *user_data) {
     struct bind_dispatch_arg *darg = (struct bind_dispatch_arg *)user_data;
     int exception_state;
     struct bind_call_arg arg;
+    VALUE specialized;
 
     arg.bind_proc = darg->ctx->bind_proc;
     arg.bind_info_obj = rbduckdb_scalar_function_bind_info_new(darg->info);
 
-    rb_protect(call_bind_proc, (VALUE)&arg, &exception_state);
+    specialized = rb_protect(call_bind_proc, (VALUE)&arg, &exception_state);
     if (exception_state) {
         VALUE msg = rbduckdb_pending_error_message();
         duckdb_scalar_function_bind_set_error(darg->info, StringValueCStr(msg));
         RB_GC_GUARD(msg);
+        return;
+    }
+
+    if (rb_obj_is_proc(specialized) || rb_obj_is_method(specialized)) {
+        duckdb_scalar_function_set_bind_data(darg->info, rbduckdb_function_data_register(specialized),
+                                             rbduckdb_function_data_destroy);
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
+        /* Copies of the bound expression made by the optimizer keep the callable. */
+        duckdb_scalar_function_set_bind_data_copy(darg->info, rbduckdb_function_data_copy);
+#endif
     }
 }
 
@@ -482,4 +621,7 @@ void rbduckdb_init_scalar_function(void) {
     rb_define_private_method(cDuckDBScalarFunction, "_add_parameter", scalar_function__add_parameter, 1);
     rb_define_method(cDuckDBScalarFunction, "set_function", scalar_function_set_function, 0);
     rb_define_private_method(cDuckDBScalarFunction, "_set_bind", scalar_function__set_bind, 0);
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
+    rb_define_private_method(cDuckDBScalarFunction, "_set_init", scalar_function__set_init, 0);
+#endif
 }
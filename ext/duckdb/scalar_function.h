@@ -5,10 +5,22 @@ struct _rubyDuckDBScalarFunction {
     duckdb_scalar_function scalar_function;
     VALUE function_proc;
     VALUE bind_proc;
+    VALUE init_proc;
 };
 
 typedef struct _rubyDuckDBScalarFunction rubyDuckDBScalarFunction;
 
+/*
+ * Per-worker state of an executing scalar function: the worker's proxy thread
+ * (if any) and the registry handle of the object returned by the init block.
+ */
+struct _rubyDuckDBScalarFunctionLocalState {
+    struct worker_proxy *proxy;
+    void *state_handle;
+};
+
+typedef struct _rubyDuckDBScalarFunctionLocalState rubyDuckDBScalarFunctionLocalState;
+
 void rbduckdb_init_scalar_function(void);
 rubyDuckDBScalarFunction *rbduckdb_get_struct_scalar_function(VALUE obj);
 
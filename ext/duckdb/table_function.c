@@ -21,11 +21,14 @@ static VALUE table_function_init(VALUE self);
 static void table_function_init_callback(duckdb_init_info info);
 static VALUE table_function_execute(VALUE self);
 static void table_function_execute_callback(duckdb_function_info info, duckdb_data_chunk output);
-#ifdef HAVE_DUCKDB_H_GE_V1_5_0
+static VALUE table_function_local_init(VALUE self);
+static VALUE table_function_set_projection_pushdown(VALUE self, VALUE enabled);
+static void table_function_init_data_destroy(void *data);
 /* Thread detection (declared in function_executor.c); used to skip the proxy on Ruby threads. */
 extern int ruby_native_thread_p(void);
 static void table_function_local_init_callback(duckdb_init_info info);
-#endif
+static void table_function_local_data_destroy(void *data);
+static void local_state_close(void *data);
 
 static const rb_data_type_t table_function_data_type = {
     "DuckDB/TableFunction",
@@ -38,6 +41,7 @@ static void mark(void *ctx) {
     rb_gc_mark(p->bind_proc);
     rb_gc_mark(p->init_proc);
     rb_gc_mark(p->execute_proc);
+    rb_gc_mark(p->local_init_proc);
 }
 
 static void deallocate(void *ctx) {
@@ -53,7 +57,7 @@ static void deallocate(void *ctx) {
 /*
  * GC compaction callback - updates VALUE references that may have moved during compaction.
  * This is critical for Ruby 2.7+ where GC can move objects in memory.
- * TableFunction has three callback procs (bind, init, execute) that all need updating.
+ * TableFunction has four callback procs (bind, init, execute, local_init) that all need updating.
  * Without this, these VALUE pointers could become stale after compaction,
  * leading to crashes when DuckDB invokes the callbacks.
  */
@@ -68,6 +72,9 @@ static void compact(void *ctx) {
     if (p->execute_proc != Qnil) {
         p->execute_proc = rb_gc_location(p->execute_proc);
     }
+    if (p->local_init_proc != Qnil) {
+        p->local_init_proc = rb_gc_location(p->local_init_proc);
+    }
 }
 
 static VALUE allocate(VALUE klass) {
@@ -102,6 +109,7 @@ static VALUE table_function_initialize(VALUE self) {
     ctx->bind_proc = Qnil;
     ctx->init_proc = Qnil;
     ctx->execute_proc = Qnil;
+    ctx->local_init_proc = Qnil;
 
     // Set extra_info to the C struct pointer (safe with GC compaction)
     // Store ctx instead of self - ctx is xmalloc'd and won't move during GC
@@ -262,6 +270,37 @@ static void table_function_bind_callback(duckdb_bind_info info) {
     rbduckdb_function_executor_dispatch(execute_bind_callback_protected, &darg);
 }
 
+/*
+ * call-seq:
+ *   table_function.projection_pushdown = true
+ *
+ * Enables projection pushdown: DuckDB then asks only for the columns a query
+ * reads, and the output DataChunk holds just those, in the order given by
+ * FunctionInfo#projected_columns. DataChunk#set_value still takes the column
+ * index declared in the bind callback, and silently skips a column that is
+ * not projected, so an execute block written for all columns keeps working
+ * and only pays for the converted ones. DataChunk#get_vector indexes the
+ * output chunk's own columns.
+ *
+ * Requires an init callback.
+ *
+ *   table_function.projection_pushdown = true
+ */
+static VALUE table_function_set_projection_pushdown(VALUE self, VALUE enabled) {
+    rubyDuckDBTableFunction *ctx;
+
+    TypedData_Get_Struct(self, rubyDuckDBTableFunction, &table_function_data_type, ctx);
+
+    if (!ctx->table_function) {
+        rb_raise(eDuckDBError, "Table function is destroyed");
+    }
+
+    ctx->projection_pushdown = RTEST(enabled);
+    duckdb_table_function_supports_projection_pushdown(ctx->table_function, ctx->projection_pushdown);
+
+    return enabled;
+}
+
 /*
  * call-seq:
  *   table_function.init { |init_info| ... } -> table_function
@@ -302,17 +341,43 @@ static VALUE call_init_proc(VALUE args_val) {
 struct init_dispatch_arg {
     rubyDuckDBTableFunction *ctx;
     duckdb_init_info info;
+    rubyDuckDBTableFunctionInitData *init_data;
 };
 
+/* Records the projected columns and their output positions in the init data. */
+static void set_projection(duckdb_init_info info, rubyDuckDBTableFunctionInitData *init_data) {
+    idx_t count = duckdb_init_get_column_count(info);
+    idx_t i;
+    idx_t column;
+    VALUE projection = rb_ary_new_capa((long)count);
+    VALUE positions = rb_ary_new();
+
+    for (i = 0; i < count; i++) {
+        column = duckdb_init_get_column_index(info, i);
+        rb_ary_push(projection, ULL2NUM(column));
+        /* Skip virtual columns (e.g. the row id), which have huge indexes. */
+        if (column < (idx_t)LONG_MAX) {
+            rb_ary_store(positions, (long)column, ULL2NUM(i));
+        }
+    }
+    init_data->projection_handle = rbduckdb_function_data_register(rb_ary_freeze(projection));
+    init_data->column_positions_handle = rbduckdb_function_data_register(rb_ary_freeze(positions));
+}
+
 static void execute_init_callback_protected(void *user_data) {
     struct init_dispatch_arg *darg = (struct init_dispatch_arg *)user_data;
     VALUE init_info_obj;
     rubyDuckDBInitInfo *init_info_ctx;
     int state = 0;
 
+    if (darg->ctx->projection_pushdown) {
+        set_projection(darg->info, darg->init_data);
+    }
+
     init_info_obj = rb_class_new_instance(0, NULL, cDuckDBTableFunctionInitInfo);
     init_info_ctx = rbduckdb_get_struct_init_info(init_info_obj);
     init_info_ctx->info = darg->info;
+    init_info_ctx->init_data = darg->init_data;
 
     VALUE call_args[2] = { darg->ctx->init_proc, init_info_obj };
     rb_protect(call_init_proc, (VALUE)call_args, &state);
@@ -333,16 +398,52 @@ static void table_function_init_callback(duckdb_init_info info) {
 
     darg.ctx = ctx;
     darg.info = info;
+    darg.init_data = calloc(1, sizeof(rubyDuckDBTableFunctionInitData));
+    if (!darg.init_data) {
+        duckdb_init_set_error(info, "failed to allocate table function init data");
+        return;
+    }
+    duckdb_init_set_init_data(info, darg.init_data, table_function_init_data_destroy);
 
     rbduckdb_function_executor_dispatch(execute_init_callback_protected, &darg);
 }
 
+/*
+ * Frees the scan's global init data. Called by DuckDB, possibly from a
+ * non-Ruby thread; the registry entries are released through the executor.
+ */
+static void table_function_init_data_destroy(void *data) {
+    rubyDuckDBTableFunctionInitData *init_data = (rubyDuckDBTableFunctionInitData *)data;
+
+    rbduckdb_function_data_destroy(init_data->partitions_handle);
+    rbduckdb_function_data_destroy(init_data->projection_handle);
+    rbduckdb_function_data_destroy(init_data->column_positions_handle);
+    free(init_data);
+}
+
+/*
+ * Returns the registered object whose handle sits at +handle_offset+ in the
+ * scan's init data, or nil when there is no init data or no such object.
+ */
+VALUE rbduckdb_table_function_init_data_value(duckdb_function_info info, size_t handle_offset) {
+    rubyDuckDBTableFunctionInitData *init_data;
+
+    init_data = (rubyDuckDBTableFunctionInitData *)duckdb_function_get_init_data(info);
+    if (init_data == NULL) {
+        return Qnil;
+    }
+    return rbduckdb_function_data_lookup(*(void **)((char *)init_data + handle_offset));
+}
+
 /*
  * call-seq:
  *   table_function.execute { |function_info, output| ... } -> table_function
  *
  * Sets the execute callback for the table function.
  * The callback is invoked during query execution to generate output rows.
+ * Each worker thread passes the same +func_info+ and +output+ objects to
+ * every call, re-pointed at the current chunk, so the column vectors and
+ * types output.set_value resolves on the first chunk are reused.
  *
  *   table_function.execute do |func_info, output|
  *     output.size = 10
@@ -371,35 +472,60 @@ static VALUE table_function_execute(VALUE self) {
     return self;
 }
 
-static VALUE call_execute_proc(VALUE args_val) {
-    VALUE *args = (VALUE *)args_val;
-    return rb_funcall(args[0], rb_intern("call"), 2, args[1], args[2]);
-}
-
 struct execute_dispatch_arg {
     rubyDuckDBTableFunction *ctx;
     duckdb_function_info info;
     duckdb_data_chunk output;
+    rubyDuckDBTableFunctionLocalData *local;
 };
 
-static void execute_execute_callback_protected(void *user_data) {
-    struct execute_dispatch_arg *darg = (struct execute_dispatch_arg *)user_data;
-    VALUE func_info_obj;
+/*
+ * Returns the [FunctionInfo, DataChunk] pair passed to the execute block.
+ * With local init data the pair is created on the worker's first call and
+ * re-pointed at the info and output chunk of each later call, so the
+ * DataChunk keeps its vector and column type caches across chunks.
+ */
+static VALUE execute_callback_wrappers(struct execute_dispatch_arg *darg) {
+    VALUE wrappers = Qnil;
     VALUE data_chunk_obj;
-    rubyDuckDBFunctionInfo *func_info_ctx;
-    rubyDuckDBDataChunk *data_chunk_ctx;
-    int state = 0;
 
-    func_info_obj = rb_class_new_instance(0, NULL, cDuckDBTableFunctionFunctionInfo);
-    func_info_ctx = rbduckdb_get_struct_function_info(func_info_obj);
-    func_info_ctx->info = darg->info;
+    if (darg->local && darg->local->wrappers_handle) {
+        wrappers = rbduckdb_function_data_lookup(darg->local->wrappers_handle);
+    }
+
+    if (NIL_P(wrappers)) {
+        data_chunk_obj = rb_class_new_instance(0, NULL, cDuckDBDataChunk);
+        if (darg->ctx->projection_pushdown) {
+            rb_ivar_set(data_chunk_obj, rb_intern("@column_positions"),
+                        rbduckdb_table_function_init_data_value(darg->info, offsetof(rubyDuckDBTableFunctionInitData, column_positions_handle)));
+        }
+        wrappers = rb_assoc_new(rb_class_new_instance(0, NULL, cDuckDBTableFunctionFunctionInfo), data_chunk_obj);
+        if (darg->local) {
+            darg->local->wrappers_handle = rbduckdb_function_data_register(wrappers);
+        }
+    }
+
+    rbduckdb_get_struct_function_info(RARRAY_AREF(wrappers, 0))->info = darg->info;
+    rbduckdb_data_chunk_rebind(RARRAY_AREF(wrappers, 1), darg->output);
+
+    return wrappers;
+}
+
+/* Builds the wrappers inside rb_protect too: a raise must not skip the executor's reply. */
+static VALUE call_execute_proc(VALUE arg) {
+    struct execute_dispatch_arg *darg = (struct execute_dispatch_arg *)arg;
+    VALUE wrappers = execute_callback_wrappers(darg);
+
+    rb_funcall(darg->ctx->execute_proc, rb_intern("call"), 2, RARRAY_AREF(wrappers, 0), RARRAY_AREF(wrappers, 1));
+    RB_GC_GUARD(wrappers);
+    return Qnil;
+}
 
-    data_chunk_obj = rb_class_new_instance(0, NULL, cDuckDBDataChunk);
-    data_chunk_ctx = rbduckdb_get_struct_data_chunk(data_chunk_obj);
-    data_chunk_ctx->data_chunk = darg->output;
+static void execute_execute_callback_protected(void *user_data) {
+    struct execute_dispatch_arg *darg = (struct execute_dispatch_arg *)user_data;
+    int state = 0;
 
-    VALUE call_args[3] = { darg->ctx->execute_proc, func_info_obj, data_chunk_obj };
-    rb_protect(call_execute_proc, (VALUE)call_args, &state);
+    rb_protect(call_execute_proc, (VALUE)darg, &state);
 
     if (state) {
         VALUE msg = rbduckdb_pending_error_message();
@@ -411,7 +537,7 @@ static void execute_execute_callback_protected(void *user_data) {
 static void table_function_execute_callback(duckdb_function_info info, duckdb_data_chunk output) {
     rubyDuckDBTableFunction *ctx;
     struct execute_dispatch_arg darg;
-    struct worker_proxy *proxy = NULL;
+    rubyDuckDBTableFunctionLocalData *local;
 
     ctx = (rubyDuckDBTableFunction *)duckdb_function_get_extra_info(info);
     if (!ctx || ctx->execute_proc == Qnil) return;
@@ -420,24 +546,64 @@ static void table_function_execute_callback(duckdb_function_info info, duckdb_da
     darg.info = info;
     darg.output = output;
 
-#ifdef HAVE_DUCKDB_H_GE_V1_5_0
-    /* On DuckDB >= 1.5.0 each worker thread carries its own proxy (see local_init). */
-    proxy = (struct worker_proxy *)duckdb_function_get_local_init_data(info);
-#endif
-    rbduckdb_function_executor_dispatch_via_proxy(execute_execute_callback_protected, &darg, proxy);
+    /* Each worker thread may carry its own proxy and wrappers (see local_init). */
+    local = (rubyDuckDBTableFunctionLocalData *)duckdb_function_get_local_init_data(info);
+    darg.local = local;
+    rbduckdb_function_executor_dispatch_via_proxy(execute_execute_callback_protected, &darg, local ? local->proxy : NULL);
 }
 
-#ifdef HAVE_DUCKDB_H_GE_V1_5_0
 /*
- * Per-worker init for the execute path (DuckDB >= 1.5.0).
+ * call-seq:
+ *   table_function.local_init { |init_info| ... } -> table_function
+ *
+ * Sets the per-thread init callback for the table function.
+ * DuckDB calls it once on every thread that runs the execute callback, after
+ * the init callback. The block's return value becomes that thread's local
+ * state, available as FunctionInfo#local_state while executing. Combined with
+ * InitInfo#partitions=, it lets several threads produce rows at once, each
+ * keeping track of the partition it is working on. If the state responds to
+ * +close+, it is called when DuckDB is done with the thread, including when
+ * the scan stops early (LIMIT, errors), so the state can release what it holds.
+ *
+ *   table_function.local_init do |_init_info|
+ *     { rows: [] } # this thread's buffer
+ *   end
+ */
+static VALUE table_function_local_init(VALUE self) {
+    rubyDuckDBTableFunction *ctx;
+
+    if (!rb_block_given_p()) {
+        rb_raise(rb_eArgError, "block is required for local_init");
+    }
+
+    TypedData_Get_Struct(self, rubyDuckDBTableFunction, &table_function_data_type, ctx);
+
+    if (!ctx->table_function) {
+        rb_raise(eDuckDBError, "Table function is destroyed");
+    }
+
+    ctx->local_init_proc = rb_block_proc();
+    duckdb_table_function_set_local_init(ctx->table_function, table_function_local_init_callback);
+
+    rbduckdb_function_executor_ensure_started();
+
+    return self;
+}
+
+/*
+ * Per-worker init for the execute path.
  *
  * DuckDB calls this once on each worker thread that will run the execute
- * callback. We create a per-worker proxy (allocating its Ruby thread under the
- * GVL via the global executor, since this runs on a non-Ruby thread) and store
- * it as thread-local init data. The execute callback then dispatches through it
- * instead of the shared global executor, so workers run callbacks concurrently.
- * DuckDB invokes rbduckdb_worker_proxy_destroy when the local state is freed.
+ * callback. On DuckDB >= 1.5.0 we create a per-worker proxy (allocating its
+ * Ruby thread under the GVL via the global executor, since this runs on a
+ * non-Ruby thread). The execute callback then dispatches through it instead of
+ * the shared global executor, so workers run callbacks concurrently. The
+ * local_init block, if any, runs through the same proxy and its result is kept
+ * in the function data registry. Both are stored as thread-local init data,
+ * freed by table_function_local_data_destroy. The local data is kept even when
+ * it holds neither, as it also caches the worker's execute wrappers.
  */
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
 struct create_proxy_callback_arg {
     struct worker_proxy *proxy;
 };
@@ -461,21 +627,132 @@ static void create_proxy_callback_protected(void *user_data) {
         rb_set_errinfo(Qnil);
     }
 }
+#endif
+
+static VALUE call_local_init_proc(VALUE args_val) {
+    VALUE *args = (VALUE *)args_val;
+    return rb_funcall(args[0], rb_intern("call"), 1, args[1]);
+}
+
+struct local_init_dispatch_arg {
+    rubyDuckDBTableFunction *ctx;
+    duckdb_init_info info;
+    rubyDuckDBTableFunctionLocalData *local;
+};
+
+static void execute_local_init_callback_protected(void *user_data) {
+    struct local_init_dispatch_arg *darg = (struct local_init_dispatch_arg *)user_data;
+    VALUE init_info_obj;
+    VALUE local_state;
+    rubyDuckDBInitInfo *init_info_ctx;
+    int state = 0;
+
+    init_info_obj = rb_class_new_instance(0, NULL, cDuckDBTableFunctionInitInfo);
+    init_info_ctx = rbduckdb_get_struct_init_info(init_info_obj);
+    init_info_ctx->info = darg->info;
+
+    VALUE call_args[2] = { darg->ctx->local_init_proc, init_info_obj };
+    local_state = rb_protect(call_local_init_proc, (VALUE)call_args, &state);
+
+    if (state) {
+        VALUE msg = rbduckdb_pending_error_message();
+        duckdb_init_set_error(darg->info, StringValueCStr(msg));
+        RB_GC_GUARD(msg);
+        return;
+    }
+    darg->local->local_state_handle = rbduckdb_function_data_register(local_state);
+}
 
 static void table_function_local_init_callback(duckdb_init_info info) {
+    rubyDuckDBTableFunction *ctx;
+    rubyDuckDBTableFunctionLocalData *local;
+    struct local_init_dispatch_arg darg;
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
     struct create_proxy_callback_arg arg;
+#endif
+
+    ctx = (rubyDuckDBTableFunction *)duckdb_init_get_extra_info(info);
+    if (!ctx) return;
+
+    local = calloc(1, sizeof(rubyDuckDBTableFunctionLocalData));
+    if (!local) {
+        duckdb_init_set_error(info, "failed to allocate table function local state");
+        return;
+    }
 
+#ifdef HAVE_DUCKDB_H_GE_V1_5_0
     /* A Ruby calling thread runs the callback inline (Case 1/2); no proxy needed. */
-    if (ruby_native_thread_p()) return;
+    if (!ruby_native_thread_p()) {
+        arg.proxy = NULL;
+        rbduckdb_function_executor_dispatch(create_proxy_callback_protected, &arg);
+        local->proxy = arg.proxy;
+    }
+#endif
 
-    arg.proxy = NULL;
-    rbduckdb_function_executor_dispatch(create_proxy_callback_protected, &arg);
+    if (ctx->local_init_proc != Qnil) {
+        darg.ctx = ctx;
+        darg.info = info;
+        darg.local = local;
+        rbduckdb_function_executor_dispatch_via_proxy(execute_local_init_callback_protected, &darg, local->proxy);
+    }
 
-    if (arg.proxy != NULL) {
-        duckdb_init_set_init_data(info, arg.proxy, rbduckdb_worker_proxy_destroy);
+    duckdb_init_set_init_data(info, local, table_function_local_data_destroy);
+}
+
+static VALUE call_local_state_close(VALUE local_state) {
+    if (rb_respond_to(local_state, rb_intern("close"))) {
+        rb_funcall(local_state, rb_intern("close"), 0);
     }
+    return Qnil;
+}
+
+static VALUE warn_local_state_close_failed(VALUE msg) {
+    rb_warn("DuckDB::TableFunction: closing a local state failed: %"PRIsVALUE, msg);
+    return Qnil;
+}
+
+/*
+ * Closes and releases a worker's local state. An exception from close has
+ * nowhere to go while DuckDB tears the scan down, so it is reported as a
+ * warning instead: a source left open should not go unnoticed.
+ */
+static void local_state_close(void *data) {
+    VALUE msg;
+    int state = 0;
+
+    rb_protect(call_local_state_close, rbduckdb_function_data_lookup(data), &state);
+    if (state) {
+        msg = rbduckdb_pending_error_message();
+        rb_protect(warn_local_state_close_failed, msg, &state);
+        if (state) {
+            rb_set_errinfo(Qnil);
+        }
+    }
+    rbduckdb_function_data_release(data);
+}
+
+/*
+ * Frees a worker's local init data. Called by DuckDB, possibly from a
+ * non-Ruby thread; the registry entry is released through the executor.
+ * The local state is closed through the worker's proxy, the thread that ran
+ * its execute callbacks, as a Fiber it holds can only be resumed there. A
+ * worker without a proxy ran them on a Ruby thread that cannot be reached
+ * from here; if close fails on the thread it lands on, local_state_close warns.
+ */
+static void table_function_local_data_destroy(void *data) {
+    rubyDuckDBTableFunctionLocalData *local = (rubyDuckDBTableFunctionLocalData *)data;
+
+    if (local->local_state_handle != NULL) {
+        rbduckdb_function_executor_dispatch_via_proxy(local_state_close, local->local_state_handle, local->proxy);
+    }
+    if (local->wrappers_handle != NULL) {
+        rbduckdb_function_data_destroy(local->wrappers_handle);
+    }
+    if (local->proxy != NULL) {
+        rbduckdb_worker_proxy_destroy(local->proxy);
+    }
+    free(local);
 }
-#endif
 
 rubyDuckDBTableFunction *rbduckdb_get_struct_table_function(VALUE self) {
     rubyDuckDBTableFunction *ctx;
@@ -498,4 +775,6 @@ void rbduckdb_init_table_function(void) {
     rb_define_method(cDuckDBTableFunction, "bind", table_function_bind, 0);
     rb_define_method(cDuckDBTableFunction, "init", table_function_init, 0);
     rb_define_method(cDuckDBTableFunction, "execute", table_function_execute, 0);
+    rb_define_method(cDuckDBTableFunction, "local_init", table_function_local_init, 0);
+    rb_define_method(cDuckDBTableFunction, "projection_pushdown=", table_function_set_projection_pushdown, 1);
 }
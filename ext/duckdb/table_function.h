@@ -6,12 +6,48 @@ struct _rubyDuckDBTableFunction {
     VALUE bind_proc;
     VALUE init_proc;
     VALUE execute_proc;
+    VALUE local_init_proc;
+    bool projection_pushdown;
 };
 
 typedef struct _rubyDuckDBTableFunction rubyDuckDBTableFunction;
 
+/*
+ * Global init data of a scan, allocated by the init callback. The Ruby
+ * objects it refers to live in the function data registry:
+ *
+ * - partitions, set by InitInfo#partitions=. next_partition is only read and
+ *   advanced with the GVL held, which makes claiming a partition atomic.
+ * - with projection pushdown, the projected column indexes and their inverse
+ *   (declared column index -> output chunk position, nil when not projected).
+ */
+struct _rubyDuckDBTableFunctionInitData {
+    void *partitions_handle;
+    idx_t partition_count;
+    idx_t next_partition;
+    void *projection_handle;
+    void *column_positions_handle;
+};
+
+typedef struct _rubyDuckDBTableFunctionInitData rubyDuckDBTableFunctionInitData;
+
+/*
+ * Per-thread local init data of a scan: the worker's proxy thread (if any),
+ * the registry handle of the object returned by the local_init block, and
+ * the registry handle of the [FunctionInfo, DataChunk] pair reused by every
+ * execute call of the worker.
+ */
+struct _rubyDuckDBTableFunctionLocalData {
+    struct worker_proxy *proxy;
+    void *local_state_handle;
+    void *wrappers_handle;
+};
+
+typedef struct _rubyDuckDBTableFunctionLocalData rubyDuckDBTableFunctionLocalData;
+
 extern VALUE cDuckDBTableFunction;
 rubyDuckDBTableFunction *rbduckdb_get_struct_table_function(VALUE self);
+VALUE rbduckdb_table_function_init_data_value(duckdb_function_info info, size_t handle_offset);
 void rbduckdb_init_table_function(void);
 
 #endif
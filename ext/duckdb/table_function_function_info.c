@@ -7,6 +7,9 @@ static VALUE allocate(VALUE klass);
 static size_t memsize(const void *p);
 static VALUE table_function_function_info_bind_data(VALUE self);
 static VALUE table_function_function_info_set_error(VALUE self, VALUE error);
+static VALUE table_function_function_info_next_partition(VALUE self);
+static VALUE table_function_function_info_local_state(VALUE self);
+static VALUE table_function_function_info_projected_columns(VALUE self);
 
 static const rb_data_type_t function_info_data_type = {
     "DuckDB/TableFunctionFunctionInfo",
@@ -75,6 +78,78 @@ static VALUE table_function_function_info_set_error(VALUE self, VALUE error) {
     return self;
 }
 
+/*
+ * call-seq:
+ *   function_info.next_partition -> object or nil
+ *
+ * Claims the next partition set by DuckDB::TableFunction::InitInfo#partitions=
+ * and returns it, or returns nil when every partition has been claimed. Each
+ * partition is returned to exactly one thread, so a thread that gets nil has
+ * no more work and its execute block should return 0 once its own rows are out.
+ *
+ *   path = function_info.next_partition
+ */
+static VALUE table_function_function_info_next_partition(VALUE self) {
+    rubyDuckDBFunctionInfo *ctx;
+    rubyDuckDBTableFunctionInitData *init_data;
+    idx_t index;
+
+    TypedData_Get_Struct(self, rubyDuckDBFunctionInfo, &function_info_data_type, ctx);
+
+    init_data = (rubyDuckDBTableFunctionInitData *)duckdb_function_get_init_data(ctx->info);
+    if (init_data == NULL || init_data->partitions_handle == NULL) {
+        rb_raise(eDuckDBError, "partitions are not set; set InitInfo#partitions= in the init callback");
+    }
+    /* Every execute callback runs with the GVL held, so this claim is atomic. */
+    if (init_data->next_partition >= init_data->partition_count) {
+        return Qnil;
+    }
+    index = init_data->next_partition++;
+
+    return rb_ary_entry(rbduckdb_function_data_lookup(init_data->partitions_handle), (long)index);
+}
+
+/*
+ * call-seq:
+ *   function_info.local_state -> object or nil
+ *
+ * Returns the object the DuckDB::TableFunction#local_init block returned on
+ * the current thread, or nil if no local_init block is set.
+ *
+ *   state = function_info.local_state
+ */
+static VALUE table_function_function_info_local_state(VALUE self) {
+    rubyDuckDBFunctionInfo *ctx;
+    rubyDuckDBTableFunctionLocalData *local;
+
+    TypedData_Get_Struct(self, rubyDuckDBFunctionInfo, &function_info_data_type, ctx);
+
+    local = (rubyDuckDBTableFunctionLocalData *)duckdb_function_get_local_init_data(ctx->info);
+    if (local == NULL) {
+        return Qnil;
+    }
+    return rbduckdb_function_data_lookup(local->local_state_handle);
+}
+
+/*
+ * call-seq:
+ *   function_info.projected_columns -> Array or nil
+ *
+ * With DuckDB::TableFunction#projection_pushdown= enabled, returns the
+ * indexes (as declared in the bind callback) of the columns the query reads,
+ * in the order of the output DataChunk's columns. Returns nil without
+ * projection pushdown, when every declared column is produced.
+ *
+ *   function_info.projected_columns # => [2, 0]
+ */
+static VALUE table_function_function_info_projected_columns(VALUE self) {
+    rubyDuckDBFunctionInfo *ctx;
+
+    TypedData_Get_Struct(self, rubyDuckDBFunctionInfo, &function_info_data_type, ctx);
+
+    return rbduckdb_table_function_init_data_value(ctx->info, offsetof(rubyDuckDBTableFunctionInitData, projection_handle));
+}
+
 void rbduckdb_init_table_function_function_info(void) {
 #if 0
     VALUE mDuckDB = rb_define_module("DuckDB");
@@ -84,4 +159,7 @@ void rbduckdb_init_table_function_function_info(void) {
 
     rb_define_method(cDuckDBTableFunctionFunctionInfo, "bind_data", table_function_function_info_bind_data, 0);
     rb_define_method(cDuckDBTableFunctionFunctionInfo, "set_error", table_function_function_info_set_error, 1);
+    rb_define_method(cDuckDBTableFunctionFunctionInfo, "next_partition", table_function_function_info_next_partition, 0);
+    rb_define_method(cDuckDBTableFunctionFunctionInfo, "local_state", table_function_function_info_local_state, 0);
+    rb_define_method(cDuckDBTableFunctionFunctionInfo, "projected_columns", table_function_function_info_projected_columns, 0);
 }
@@ -10,6 +10,7 @@ static VALUE table_function_init_info_set_max_threads(VALUE self, VALUE max_thre
 static VALUE table_function_init_info_column_count(VALUE self);
 static VALUE table_function_init_info_column_index(VALUE self, VALUE index);
 static VALUE table_function_init_info_bind_data(VALUE self);
+static VALUE table_function_init_info_set_partitions(VALUE self, VALUE partitions);
 
 static const rb_data_type_t init_info_data_type = {
     "DuckDB/TableFunctionInitInfo",
@@ -133,6 +134,48 @@ static VALUE table_function_init_info_bind_data(VALUE self) {
     return rbduckdb_function_data_lookup(duckdb_init_get_bind_data(ctx->info));
 }
 
+/*
+ * call-seq:
+ *   init_info.partitions = partitions
+ *
+ * Splits the scan into +partitions+, an Array of arbitrary objects (file
+ * names, key ranges, ...). Each thread executing the table function claims
+ * the next unclaimed partition with FunctionInfo#next_partition, so every
+ * partition is handed out exactly once. Also sets max_threads to the number
+ * of partitions; DuckDB still caps it by its +threads+ setting.
+ *
+ * Call it from the init callback, not from local_init.
+ *
+ *   table_function.init do |init_info|
+ *     init_info.partitions = %w[part-0.csv part-1.csv part-2.csv]
+ *   end
+ */
+static VALUE table_function_init_info_set_partitions(VALUE self, VALUE partitions) {
+    rubyDuckDBInitInfo *ctx;
+    rubyDuckDBTableFunctionInitData *init_data;
+    VALUE list;
+
+    TypedData_Get_Struct(self, rubyDuckDBInitInfo, &init_info_data_type, ctx);
+
+    init_data = ctx->init_data;
+    if (init_data == NULL) {
+        rb_raise(eDuckDBError, "partitions can only be set in the init callback");
+    }
+    list = rb_ary_freeze(rb_ary_dup(rb_Array(partitions)));
+
+    if (init_data->partitions_handle != NULL) {
+        rbduckdb_function_data_release(init_data->partitions_handle);
+    }
+    init_data->partition_count = (idx_t)RARRAY_LEN(list);
+    init_data->next_partition = 0;
+    init_data->partitions_handle = rbduckdb_function_data_register(list);
+    if (init_data->partition_count > 0) {
+        duckdb_init_set_max_threads(ctx->info, init_data->partition_count);
+    }
+
+    return partitions;
+}
+
 void rbduckdb_init_table_function_init_info(void) {
 #if 0
     VALUE mDuckDB = rb_define_module("DuckDB");
@@ -146,4 +189,5 @@ void rbduckdb_init_table_function_init_info(void) {
     rb_define_method(cDuckDBTableFunctionInitInfo, "column_count", table_function_init_info_column_count, 0);
     rb_define_method(cDuckDBTableFunctionInitInfo, "column_index", table_function_init_info_column_index, 1);
     rb_define_method(cDuckDBTableFunctionInitInfo, "bind_data", table_function_init_info_bind_data, 0);
+    rb_define_method(cDuckDBTableFunctionInitInfo, "partitions=", table_function_init_info_set_partitions, 1);
 }
@@ -3,6 +3,7 @@
 
 struct _rubyDuckDBInitInfo {
     duckdb_init_info info;
+    struct _rubyDuckDBTableFunctionInitData *init_data;
 };
 
 typedef struct _rubyDuckDBInitInfo rubyDuckDBInitInfo;
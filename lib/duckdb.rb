@@ -16,11 +16,14 @@
 require 'duckdb/appender'
 require 'duckdb/config'
 require 'duckdb/column'
+require 'duckdb/row'
+require 'duckdb/column_buffer'
 require 'duckdb/logical_type'
 require 'duckdb/function_type_validation'
 require 'duckdb/scalar_function'
 require 'duckdb/scalar_function_set'
 require 'duckdb/aggregate_function'
+require 'duckdb/aggregate_function/state'
 require 'duckdb/aggregate_function_set'
 require 'duckdb/expression'
 require 'duckdb/client_context'
@@ -31,6 +34,7 @@
 require 'duckdb/table_function/bind_info'
 require 'duckdb/table_function/init_info'
 require 'duckdb/table_function/function_info'
+require 'duckdb/table_function/array_adapter'
 require 'duckdb/infinity'
 require 'duckdb/instance_cache'
 require 'duckdb/casting'
@@ -60,6 +64,42 @@ def default_timezone=(value)
       @default_timezone = value
     end
 
+    # Controls how DuckDB::Result converts ENUM column values.
+    #
+    # - `:string` - (default) frozen String shared by every row with the same value
+    # - `:symbol` - Symbol
+    #
+    # Example:
+    #   DuckDB.enum_as = :symbol
+    #
+    # The ENUM dictionary is decoded once per column for each Result#each.
+    attr_reader :enum_as
+
+    def enum_as=(value)
+      raise ArgumentError, 'DuckDB.enum_as must be either :string or :symbol.' unless %i[string symbol].include?(value)
+
+      @enum_as = value
+    end
+
+    # Controls how DuckDB::Result converts DECIMAL column values.
+    #
+    # - `:bigdecimal`    - (default) BigDecimal
+    # - `:float`         - Float, which may lose precision
+    # - `:rational`      - Rational
+    # - `:integer_cents` - the unscaled Integer, e.g. 12345 for 123.45 in DECIMAL(18, 2)
+    #
+    # Example:
+    #   DuckDB.decimal_as = :integer_cents
+    attr_reader :decimal_as
+
+    def decimal_as=(value)
+      unless %i[bigdecimal float rational integer_cents].include?(value)
+        raise ArgumentError, 'DuckDB.decimal_as must be one of :bigdecimal, :float, :rational or :integer_cents.'
+      end
+
+      @decimal_as = value
+    end
+
     def const_missing(name)
       deprecated = DEPRECATED_CONSTANTS[name]
       return super unless deprecated
@@ -78,4 +118,6 @@ def const_missing(name)
   # Default to local time to preserve existing behavior unless explicitly
   # configured otherwise.
   self.default_timezone = :local
+  self.enum_as = :string
+  self.decimal_as = :bigdecimal
 end
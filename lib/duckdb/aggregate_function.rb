@@ -54,6 +54,34 @@ module DuckDB
   #   af.set_finalize { |state| state[:weight].zero? ? nil : state[:sum] / state[:weight] }
   #
   #   con.register_aggregate_function(af)
+  #
+  # == Typed state
+  #
+  # For numeric accumulators, +set_state+ replaces +set_init+: the state is a
+  # fixed set of BIGINT and DOUBLE fields kept in DuckDB's own state memory
+  # instead of a Ruby object. Callbacks receive a DuckDB::AggregateFunction::State
+  # view with a reader and a writer per field; +set_update+ changes it in place
+  # and its return value is ignored. +set_combine+ can name a native operation
+  # per field (+:sum+, +:min+ or +:max+), so merging partial states runs
+  # without Ruby.
+  #
+  #   af.set_state({ sum: :double, weight: :double })
+  #   af.set_update do |state, value, weight|
+  #     state.sum += value * weight
+  #     state.weight += weight
+  #   end
+  #   af.set_combine(:sum)
+  #   af.set_finalize { |state| state.weight.zero? ? nil : state.sum / state.weight }
+  #
+  # == Batched combine and finalize
+  #
+  # DuckDB combines and finalizes states in batches of up to a vector of
+  # groups. +set_combine_batch+ and +set_finalize_batch+ take a whole batch in
+  # one Ruby call instead of one call per state, which matters for GROUP BY
+  # with many groups:
+  #
+  #   af.set_combine_batch { |sources, targets| sources.zip(targets).map { |s, t| s + t } }
+  #   af.set_finalize_batch { |states| states.map(&:to_f) }
   class AggregateFunction
     include FunctionTypeValidation
 
@@ -74,14 +102,16 @@ class << self
       # @param return_type [DuckDB::LogicalType | Symbol] the SQL return type
       # @param params [Array<DuckDB::LogicalType | Symbol>] input parameter types
       #   (empty array for a zero-argument aggregate)
-      # @param init [#call] callable that returns the initial per-group state
+      # @param init [#call, Hash] callable that returns the initial per-group
+      #   state, or with +state:+ a Hash of initial field values (default 0)
       # @param update [#call] callable that folds one row into the state;
       #   receives +state, *inputs+ and must return the updated state.
       #   Default: +->( state, *) { state }+ (ignore inputs)
-      # @param combine [#call] callable that merges two partial states;
+      # @param combine [#call, Symbol, Hash] callable that merges two partial states;
       #   receives +source_state, target_state+ and must return the merged
       #   state. Default: +->(state, _other) { state }+ (keep source only —
-      #   only correct for single-threaded execution)
+      #   only correct for single-threaded execution). Required with +state:+,
+      #   where it may also be a native operation, as for +set_combine+.
       # @param finalize [#call] callable that converts the final state into the
       #   SQL result value; receives +state+ and must return a value compatible
       #   with +return_type+.
@@ -89,6 +119,12 @@ class << self
       # @param null_handling [Boolean] when +true+, enables special NULL
       #   handling so that rows with NULL inputs are passed to +update+ as
       #   +nil+ instead of being skipped (default: +false+)
+      # @param state [Hash{Symbol => Symbol}] typed state fields (see +set_state+);
+      #   +update+ then changes the state in place
+      # @param combine_batch [#call] replaces +combine+ with one call per batch
+      #   of states (see +set_combine_batch+)
+      # @param finalize_batch [#call] replaces +finalize+ with one call per batch
+      #   of states (see +set_finalize_batch+)
       # @return [DuckDB::AggregateFunction] the configured aggregate function,
       #   ready to be passed to +Connection#register_aggregate_function+
       # @raise [ArgumentError] if any of +init+, +update+, +combine+, or
@@ -118,37 +154,73 @@ class << self
       #     combine:      ->(state, other) { state + other },
       #     null_handling: true
       #   )
-      def create( # rubocop:disable Metrics/MethodLength, Metrics/ParameterLists, Metrics/AbcSize
+      #
+      # == Example: weighted average with a typed state
+      #
+      #   af = DuckDB::AggregateFunction.create(
+      #     name:        'weighted_avg',
+      #     return_type: :double,
+      #     params:      %i[double double],
+      #     state:       { sum: :double, weight: :double },
+      #     update:      ->(state, value, weight) { state.sum += value * weight; state.weight += weight },
+      #     combine:     :sum,
+      #     finalize:    ->(state) { state.sum / state.weight }
+      #   )
+      def create( # rubocop:disable Metrics/ParameterLists
         name:,
         return_type:,
-        params: [], # rubocop:disable Style/KeywordParametersOrder
-        init:,
-        update: ->(state, *_inputs) { state },
-        combine: ->(state, _other_state) { state },
-        finalize: ->(state) { state },
-        null_handling: false
+        params: [],
+        init: nil,
+        update: nil,
+        combine: nil,
+        finalize: nil,
+        null_handling: false,
+        state: nil,
+        combine_batch: nil,
+        finalize_batch: nil
       )
-        callable!(:init, init)
-        callable!(:update, update)
-        callable!(:combine, combine)
-        callable!(:finalize, finalize)
-
         af = AggregateFunction.new
         af.name = name
         af.return_type = return_type
-        params.each do |param|
-          af.add_parameter(param)
-        end
-        af.set_init { init.call }
-        af.set_update { |state, *inputs| update.call(state, *inputs) }
-        af.set_combine { |state, other_state| combine.call(state, other_state) }
-        af.set_finalize { |state| finalize.call(state) }
+        params.each { |param| af.add_parameter(param) }
+        init_state(af, state, init, combine || combine_batch)
+        set_callbacks(af, update, combine, finalize)
+        set_batch_callbacks(af, combine_batch, finalize_batch)
         af.set_special_handling if null_handling
         af
       end
 
       private
 
+      def init_state(af, state, init, combine)
+        if state
+          raise ArgumentError, 'combine: is required with state:' unless combine
+
+          af.set_state(state, init: init || {})
+        else
+          callable!(:init, init)
+          af.set_init { init.call }
+        end
+      end
+
+      # Callbacks left nil keep the defaults of set_init or set_state.
+      def set_callbacks(af, update, combine, finalize)
+        { update:, finalize: }.each { |name, callable| callable!(name, callable) if callable }
+        af.set_update { |state, *inputs| update.call(state, *inputs) } if update
+        af.set_finalize { |state| finalize.call(state) } if finalize
+        return unless combine
+        return af.set_combine(combine) if combine.is_a?(Symbol) || combine.is_a?(Hash)
+
+        callable!(:combine, combine)
+        af.set_combine { |state, other_state| combine.call(state, other_state) }
+      end
+
+      def set_batch_callbacks(af, combine_batch, finalize_batch)
+        { combine_batch:, finalize_batch: }.each { |name, callable| callable!(name, callable) if callable }
+        af.set_combine_batch { |sources, targets| combine_batch.call(sources, targets) } if combine_batch
+        af.set_finalize_batch { |states| finalize_batch.call(states) } if finalize_batch
+      end
+
       def callable!(name, arg)
         raise ArgumentError, "#{name} must respond to `call`" unless arg.respond_to?(:call)
       end
@@ -187,7 +259,10 @@ def add_parameter(logical_type)
     #   explicitly when the aggregate must be parallel-safe.
     #
     # @return [DuckDB::AggregateFunction] self
+    # @raise [DuckDB::Error] if the function has a typed state (+set_state+)
     def set_init(&)
+      raise DuckDB::Error, 'the aggregate function has a typed state; set_init cannot be used' if @state
+
       unless @init_set
         _set_update { |state, *| state } unless @update_set
         _set_combine { |s1, _s2| s1 } unless @combine_set
@@ -197,6 +272,37 @@ def set_init(&)
       @init_set = true
     end
 
+    # Gives the aggregate function a typed state instead of a Ruby object:
+    # +fields+ maps each field name to +:bigint+ or +:double+, and +init+ gives
+    # initial values (0 by default). The state lives in DuckDB's state memory,
+    # so it costs no Ruby allocation per group; callbacks receive it as a
+    # DuckDB::AggregateFunction::State view, which +set_update+ and a
+    # +set_combine+ block change in place.
+    #
+    # Unless they are set, update ignores its inputs and finalize returns the
+    # first field. A combine is required: a block, or native operations given to
+    # +set_combine+. Partial states all start from +init+, so a field combined
+    # with +:sum+ should start at 0.
+    #
+    #   af.set_state({ min: :bigint, max: :bigint }, init: { min: 2**63 - 1, max: -2**63 })
+    #   af.set_update { |state, value| state.min = [state.min, value].min; state.max = [state.max, value].max }
+    #   af.set_combine(min: :min, max: :max)
+    #   af.set_finalize { |state| state.max - state.min }
+    #
+    # @param fields [Hash{Symbol => Symbol}] field names and types
+    # @param init [Hash{Symbol => Numeric}] initial field values
+    # @return [DuckDB::AggregateFunction] self
+    # @raise [ArgumentError] if a field type or name is invalid
+    # @raise [DuckDB::Error] if the state or +set_init+ is already set
+    def set_state(fields, init: {})
+      state_class = State.define(fields)
+      _set_state(state_class, state_class.field_types, state_class.initial_values(init))
+      @state = state_class
+      _set_update { |*| nil } unless @update_set
+      _set_finalize { |state| state.public_send(state_class.members.first) } unless @finalize_set
+      self
+    end
+
     # Sets the block that accumulates one row into the state.
     # The block receives the current state followed by the input column
     # value(s) for that row, and must return the updated state.
@@ -214,13 +320,40 @@ def set_update(&)
     # merged state.
     # May be called after +set_init+ to override the injected default.
     #
+    # With a typed state (+set_state+) the block adds the source view into the
+    # target view instead, or +operation+ merges the fields natively: +:sum+,
+    # +:min+ or +:max+ for every field, or a Hash with one of them per field.
+    # BIGINT sums that overflow fail the query.
+    #
+    #   af.set_combine(sum: :sum, n: :sum, max: :max)
+    #
     # @note The default +{ |s1, _s2| s1 }+ is only correct for single-threaded
     #   execution. Supply an explicit combine block for parallel-safe aggregates.
     #
     # @return [DuckDB::AggregateFunction] self
-    def set_combine(&)
+    # @raise [ArgumentError] if +operation+ is invalid or there is no typed state
+    def set_combine(operation = nil, &)
+      @combine_set = true
+      return _set_combine(&) unless operation
+
+      raise ArgumentError, 'combine operations need a typed state (set_state)' unless @state
+
+      _set_combine_operations(@state.combine_operations(operation))
+    end
+
+    # Sets the block that merges partial states a batch at a time, replacing
+    # +set_combine+. The block receives an Array of source states and an Array
+    # of target states of the same size, and returns an Array of the merged
+    # states. With a typed state (+set_state+) it receives
+    # DuckDB::AggregateFunction::State views and updates the targets in place;
+    # its return value is then ignored.
+    #
+    #   af.set_combine_batch { |sources, targets| sources.zip(targets).map { |s, t| s + t } }
+    #
+    # @return [DuckDB::AggregateFunction] self
+    def set_combine_batch(&)
       @combine_set = true
-      _set_combine(&)
+      _set_combine_batch(&)
     end
 
     # Sets the block that converts the final state into the SQL result value.
@@ -235,6 +368,18 @@ def set_finalize(&)
       _set_finalize(&)
     end
 
+    # Sets the block that converts final states into SQL result values a batch
+    # at a time, replacing +set_finalize+. The block receives an Array of states
+    # and returns an Array of the same size with the result of each.
+    #
+    #   af.set_finalize_batch { |states| states.map { |sum, n| sum.fdiv(n) } }
+    #
+    # @return [DuckDB::AggregateFunction] self
+    def set_finalize_batch(&)
+      @finalize_set = true
+      _set_finalize_batch(&)
+    end
+
     # Sets special NULL handling for the aggregate function.
     # By default DuckDB skips rows with NULL input values.  Calling this
     # method disables that behaviour so the update callback is invoked even
@@ -0,0 +1,102 @@
+# frozen_string_literal: true
+
+module DuckDB
+  class AggregateFunction
+    #
+    # The state of an aggregate function with a typed state (see
+    # AggregateFunction#set_state). It is a view of a fixed set of BIGINT and
+    # DOUBLE fields stored in DuckDB's own state memory, with a reader and a
+    # writer for each field:
+    #
+    #   af.set_state({ sum: :double, n: :bigint })
+    #   af.set_update { |state, value| state.sum += value; state.n += 1 }
+    #
+    # A view is only valid inside the callback it is passed to; DuckDB may free
+    # or reuse the memory afterwards, and using the view then raises
+    # DuckDB::Error.
+    #
+    class State
+      FIELD_TYPES = { bigint: 0, double: 1 }.freeze # :nodoc:
+      COMBINE_OPERATIONS = { sum: 1, min: 2, max: 3 }.freeze # :nodoc:
+
+      class << self
+        attr_reader :members, :field_types
+
+        # Creates a State subclass for +fields+, with a reader and a writer for
+        # each field.
+        def define(fields) # :nodoc:
+          members = fields.keys.map(&:to_sym)
+          check_members!(members)
+          types = fields.values.map { |type| field_type(type) }
+
+          Class.new(self) do
+            @members = members.freeze
+            @field_types = types.freeze
+            members.each_with_index do |member, index|
+              define_method(member) { _get(index) }
+              define_method(:"#{member}=") { |value| _set(index, value) }
+            end
+          end
+        end
+
+        # The initial value of each field, from a Hash of field names (0 by default).
+        def initial_values(init) # :nodoc:
+          unknown = init.keys.map(&:to_sym) - members
+          raise ArgumentError, "unknown state field in init: #{unknown.join(', ')}" unless unknown.empty?
+
+          members.map { |member| init.fetch(member) { init.fetch(member.to_s, 0) } }
+        end
+
+        # The native combine operation of each field, from one operation for
+        # all fields or a Hash of them per field.
+        def combine_operations(operation) # :nodoc:
+          members.map do |member|
+            op = operation.is_a?(Hash) ? operation[member] || operation[member.to_s] : operation
+            COMBINE_OPERATIONS.fetch(op&.to_sym) do
+              raise ArgumentError, "combine operation of `#{member}` must be :sum, :min or :max: #{op.inspect}"
+            end
+          end
+        end
+
+        private
+
+        def check_members!(members)
+          raise ArgumentError, 'state needs at least one field' if members.empty?
+
+          clash = members.find { |member| method_defined?(member) || private_method_defined?(member) }
+          raise ArgumentError, "state field name `#{clash}` clashes with a method of #{self}" if clash
+        end
+
+        def field_type(type)
+          FIELD_TYPES.fetch(type.to_sym) { raise ArgumentError, "state field type must be :bigint or :double: #{type}" }
+        end
+      end
+
+      # Returns the field names.
+      def members
+        self.class.members
+      end
+
+      # Returns the value of the field +name+.
+      def [](name)
+        _get(index_of(name))
+      end
+
+      # Sets the value of the field +name+.
+      def []=(name, value)
+        _set(index_of(name), value)
+      end
+
+      # Returns the fields as a Hash.
+      def to_h
+        members.each_with_index.to_h { |member, index| [member, _get(index)] }
+      end
+
+      private
+
+      def index_of(name)
+        members.index(name.to_sym) || raise(KeyError, "no field `#{name}` in the aggregate state")
+      end
+    end
+  end
+end
@@ -0,0 +1,52 @@
+# frozen_string_literal: true
+
+module DuckDB
+  # DuckDB::ColumnBuffer holds the values of a fixed-width column as packed
+  # binary data, returned by DuckDB::Result#column_buffer and yielded by
+  # DuckDB::Result#each_chunk_buffers.
+  #
+  # - +type+ — the column type Symbol (:integer, :double, :timestamp, ...)
+  # - +size+ — the number of values
+  # - +data+ — an ASCII-8BIT String of +size+ values in the native byte order.
+  #   DATE is int32 days, TIME is int64 micro (TIME_NS nano) seconds and
+  #   TIMESTAMP int64 micro (TIMESTAMP_S/_MS/_NS: seconds/milli/nano) seconds
+  #   since the epoch. The data of a NULL value is undefined.
+  # - +validity+ — nil when no value is NULL, otherwise a bitmap String where
+  #   bit i (least significant bit first) is set when value i is not NULL.
+  #
+  #   buffer = con.query('SELECT price FROM items').column_buffer(0)
+  #   prices = Numo::DFloat.from_binary(buffer.data)
+  ColumnBuffer = Data.define(:type, :size, :data, :validity)
+
+  class ColumnBuffer
+    # the Array#pack directive of each value type.
+    PACK_FORMATS = {
+      boolean: 'C', tinyint: 'c', smallint: 's', integer: 'l', bigint: 'q',
+      utinyint: 'C', usmallint: 'S', uinteger: 'L', ubigint: 'Q',
+      float: 'f', double: 'd', date: 'l', time: 'q', time_ns: 'q',
+      timestamp: 'q', timestamp_s: 'q', timestamp_ms: 'q', timestamp_ns: 'q', timestamp_tz: 'q'
+    }.freeze
+
+    # returns true unless the value at index is NULL. Raises IndexError when
+    # index is not in 0...size.
+    def valid?(index)
+      raise IndexError, "index #{index} outside of the buffer (size #{size})" unless index.between?(0, size - 1)
+
+      validity.nil? || validity.getbyte(index >> 3)[index & 7] == 1
+    end
+
+    # returns the Array#pack directive of the values, or nil for HUGEINT and UHUGEINT.
+    def pack_format
+      PACK_FORMATS[type]
+    end
+
+    # returns the raw values as an Array of Integers (Floats, for FLOAT and
+    # DOUBLE), with nil for NULL. BOOLEAN values are 0 or 1.
+    def to_a
+      format = pack_format
+      raise DuckDB::Error, "#{type} values cannot be unpacked" unless format
+
+      data.unpack("#{format}#{size}").each_with_index.map { |value, index| value if valid?(index) }
+    end
+  end
+end
@@ -1,5 +1,7 @@
 # frozen_string_literal: true
 
+require 'etc'
+
 module DuckDB
   # The DuckDB::Connection encapsulates connection with DuckDB database.
   #
@@ -353,12 +355,16 @@ def register_table_function(table_function)
     #
     # Looks up a table adapter registered for the object's class via
     # +DuckDB::TableFunction.add_table_adapter+, then uses it to create and register
-    # a table function under the given name.
+    # a table function under the given name. Arrays of Arrays, Hashes, Structs
+    # or Data objects are supported out of the box by
+    # +DuckDB::TableFunction::ArrayAdapter+.
     #
     # @param object [Object] the Ruby object to expose as a table (e.g. a CSV instance)
     # @param name [String] the SQL name of the table function
     # @param columns [Hash{String => DuckDB::LogicalType}, nil] optional column schema override;
     #   if omitted, the adapter determines the columns (e.g. from headers or inference)
+    # @param cardinality [Integer, #call, nil] optional estimate of the number of rows,
+    #   replacing the adapter's own (see DuckDB::TableFunction#cardinality=)
     # @raise [ArgumentError] if no adapter is registered for the object's class
     # @return [void]
     #
@@ -369,17 +375,28 @@ def register_table_function(table_function)
     #   con.expose_as_table(csv, 'csv_table')
     #   con.query('SELECT * FROM csv_table()').to_a
     #
+    # @example Expose an Array of Hashes as a table
+    #   con.expose_as_table([{ id: 1, name: 'Alice' }, { id: 2, name: 'Bob' }], 'users')
+    #   con.query('SELECT name FROM users() WHERE id = 2').to_a # => [["Bob"]]
+    #
     # @example With explicit column types
     #   con.expose_as_table(csv, 'csv_table', columns: {
     #     'id'   => DuckDB::LogicalType::BIGINT,
     #     'name' => DuckDB::LogicalType::VARCHAR
     #   })
     #
-    def expose_as_table(object, name, columns: nil)
+    # @example Tell the optimizer how large the source is
+    #   con.expose_as_table(csv, 'csv_table', cardinality: File.foreach('data.csv').count - 1)
+    #
+    def expose_as_table(object, name, columns: nil, cardinality: nil)
       adapter = TableFunction.table_adapter_for(object.class)
       raise ArgumentError, "No table adapter registered for #{object.class}" if adapter.nil?
 
       tf = adapter.call(object, name, columns:)
+      if cardinality
+        tf.cardinality = cardinality
+        tf.exact_cardinality = false
+      end
       register_table_function(tf)
     end
 
@@ -393,36 +410,110 @@ def expose_as_table(object, name, columns: nil)
     # a type that cannot be cast (e.g. a non-numeric VARCHAR into an INTEGER
     # column) or a column-count mismatch raises +DuckDB::Error+.
     #
-    # This is not transactional: a schema mismatch fails before any rows are
-    # written, but a rarer mid-stream failure can leave earlier chunks
+    # By default this is not transactional: a schema mismatch fails before any
+    # rows are written, but a rarer mid-stream failure can leave earlier chunks
     # appended. Wrap the call in your own transaction for all-or-nothing.
     #
+    # For long loads, +commit_every:+ appends the stream in batches of that
+    # many Arrow chunks, each committed in its own transaction. After each
+    # batch, and inside its transaction, the block (if given) is called with
+    # the number of the stream's chunks committed so far (including skipped
+    # ones) and the rows appended by this call. Progress the block records in
+    # a table therefore commits atomically with the rows. A failed batch is
+    # rolled back, so restarting with +skip_chunks:+ set to the last recorded
+    # chunk count resumes the load without duplicating rows. As each batch
+    # commits on its own, +commit_every:+ raises ArgumentError when the
+    # connection already has a transaction open. +skip_chunks:+
+    # discards that many chunks from the start of the stream unconverted; the
+    # producer must yield the same chunks in the same order on every export.
+    #
+    # The stream is read, converted and appended by native threads without
+    # holding the GVL: one thread pulls Arrow batches, +threads+ threads
+    # convert them into DuckDB chunks, and the calling thread appends them in
+    # stream order. Other Ruby threads keep running meanwhile. The producer's
+    # Arrow stream must therefore be callable from any native thread.
+    #
     # This API is built on DuckDB's unstable Arrow C API and may change in any
     # minor release.
     #
     # @param table [String] the name of the existing target table
     # @param producer [#arrow_c_stream] the Arrow producer
+    # @param threads [Integer, nil] the number of converter threads
+    #   (the number of processors, DuckDB's default +threads+, when nil)
+    # @param commit_every [Integer, nil] the number of chunks per transaction
+    # @param skip_chunks [Integer] the number of leading chunks to skip
+    # @yieldparam chunks [Integer] the stream's chunks committed so far
+    # @yieldparam rows [Integer] the rows appended so far by this call
     # @raise [TypeError] if +producer+ does not respond to +#arrow_c_stream+
+    # @raise [ArgumentError] if +threads+ or +commit_every+ is not positive, or
+    #   +commit_every+ is given inside an open transaction
     # @return [Integer] the number of rows appended
     #
     # @example Load a Polars DataFrame into a table
     #   con.query('CREATE TABLE t (id INTEGER, name VARCHAR)')
     #   con.append_arrow('t', polars_df)
     #
-    def append_arrow(table, producer)
+    # @example Resume a checkpointed load
+    #   done = con.query('SELECT chunks FROM load_progress').to_a.dig(0, 0) || 0
+    #   con.append_arrow('t', polars_df, commit_every: 100, skip_chunks: done) do |chunks, _rows|
+    #     con.query('INSERT OR REPLACE INTO load_progress VALUES (1, ?)', chunks)
+    #   end
+    #
+    def append_arrow(table, producer, threads: nil, commit_every: nil, skip_chunks: 0, &progress)
       unless producer.respond_to?(:arrow_c_stream)
         raise TypeError, "Arrow producer must respond to #arrow_c_stream, got #{producer.class}"
       end
+      raise ArgumentError, 'commit_every must be positive' if commit_every && Integer(commit_every) < 1
 
-      stream = producer.arrow_c_stream # keep the producer's stream alive for the duration
-      address = stream.to_i
-      begin
-        append_arrow_chunks(table, address)
-      ensure
-        _arrow_release(address)
+      with_arrow_append_pipeline(producer, threads, skip_chunks) do |pipeline|
+        next append_arrow_chunks(table, pipeline).last unless commit_every
+
+        append_arrow_in_transactions(table, pipeline, Integer(commit_every), Integer(skip_chunks), &progress)
       end
     end
 
+    # [EXPERIMENTAL] Registers an Arrow producer as a table function DuckDB
+    # scans in place.
+    #
+    # Unlike #append_arrow, the producer's data is not copied into a table:
+    # each query reading +name+ opens a fresh Arrow C stream from +producer+
+    # (any object responding to +#arrow_c_stream+, such as a ruby-polars
+    # +DataFrame+) and DuckDB reads the converted chunks directly. Only the
+    # columns a query uses are converted. An Array of producers with the same
+    # columns (e.g. a list of record batches) is scanned as one table.
+    #
+    # The column names and types are taken from the producer's first
+    # non-empty chunk, read at registration. Each later scan calls
+    # +#arrow_c_stream+ again, so the producer must be able to export more
+    # than once to be queried repeatedly (a +DuckDB::Result+ can be scanned
+    # only once).
+    #
+    # This API is built on DuckDB's unstable Arrow C API and may change in any
+    # minor release.
+    #
+    # @param name [String] the SQL name of the table function
+    # @param producer [#arrow_c_stream, Array<#arrow_c_stream>] the Arrow producer(s)
+    # @raise [TypeError] if a producer does not respond to +#arrow_c_stream+
+    # @raise [DuckDB::Error] if the producer has no rows to infer the columns from
+    # @return [DuckDB::Connection] self
+    #
+    # @example Join a Polars DataFrame against a table without copying it
+    #   con.register_arrow('events', polars_df)
+    #   con.query('SELECT u.name, e.kind FROM users u JOIN events() e ON e.user_id = u.id')
+    #
+    def register_arrow(name, producer)
+      producers = producer.is_a?(Array) ? producer.dup : [producer]
+      raise ArgumentError, 'at least one Arrow producer is required' if producers.empty?
+
+      producers.each do |p|
+        next if p.respond_to?(:arrow_c_stream)
+
+        raise TypeError, "Arrow producer must respond to #arrow_c_stream, got #{p.class}"
+      end
+
+      _register_arrow(name.to_s, producers.freeze)
+    end
+
     # Returns the names of the tables referenced by the given SQL query,
     # without executing it.
     #
@@ -444,18 +535,67 @@ def table_names(query, qualified: false)
 
     private
 
-    # Drives the Arrow stream at +address+ chunk by chunk into +table+,
-    # returning the number of rows appended.
-    def append_arrow_chunks(table, address)
-      converted_schema = _arrow_converted_schema(address)
-      rows = 0
-      appender(table) do |app|
-        while (chunk = _arrow_next_chunk(address, converted_schema))
-          rows += chunk.size
-          app.append_data_chunk(chunk)
+    # Yields an ArrowAppendPipeline reading +producer+'s Arrow stream. The
+    # pipeline is closed (its threads joined) before the stream is released.
+    def with_arrow_append_pipeline(producer, threads, skip_chunks)
+      threads ||= Etc.nprocessors
+      stream = producer.arrow_c_stream # keep the producer's stream alive for the duration
+      address = stream.to_i
+      begin
+        pipeline = _arrow_append_pipeline(address, _arrow_converted_schema(address), Integer(threads),
+                                          Integer(skip_chunks))
+        yield pipeline
+      ensure
+        pipeline&.close
+        _arrow_release(address)
+      end
+    end
+
+    # Appends up to +max_chunks+ of the pipeline's chunks (all when nil) into
+    # +table+, returning [chunks, rows].
+    def append_arrow_chunks(table, pipeline, max_chunks = nil)
+      app = appender(table)
+      pipeline.append(app, max_chunks)
+    ensure
+      app&.close
+    end
+
+    # Appends the pipeline's chunks +commit_every+ at a time, each batch in its
+    # own transaction, returning the number of rows appended.
+    def append_arrow_in_transactions(table, pipeline, commit_every, skip_chunks)
+      done = [skip_chunks, 0]
+      loop do
+        counts = append_arrow_transaction(table, pipeline, commit_every) do |chunks, rows|
+          yield done[0] + chunks, done[1] + rows if block_given?
         end
+        break done[1] if counts.first.zero?
+
+        done = done.zip(counts).map(&:sum)
       end
-      rows
+    end
+
+    # Appends one batch in a transaction. The block runs inside it, so that
+    # progress it records commits atomically with the batch's rows.
+    def append_arrow_transaction(table, pipeline, max_chunks)
+      begin_arrow_transaction
+      begin
+        counts = append_arrow_chunks(table, pipeline, max_chunks)
+        yield(*counts) if counts.first.positive?
+      rescue Exception # rubocop:disable Lint/RescueException
+        query('ROLLBACK')
+        raise
+      end
+      query('COMMIT')
+      counts
+    end
+
+    def begin_arrow_transaction
+      query('BEGIN TRANSACTION')
+    rescue DuckDB::Error => e
+      raise unless e.message.include?('within a transaction')
+
+      raise ArgumentError, 'append_arrow with commit_every: commits its own transactions; ' \
+                           'call it outside an open transaction, or without commit_every:'
     end
 
     def run_appender_block(appender, &)
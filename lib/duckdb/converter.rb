@@ -23,8 +23,8 @@ module Converter # :nodoc: all
     HALF_HUGEINT_BIT = 64
     HALF_HUGEINT = 1 << HALF_HUGEINT_BIT
     LOWER_HUGEINT_MASK = HALF_HUGEINT - 1
-    EPOCH = Time.local(1970, 1, 1)
-    EPOCH_UTC = Time.utc(1970, 1, 1)
+    EPOCH = Time.local(1970, 1, 1).freeze
+    EPOCH_UTC = Time.utc(1970, 1, 1).freeze
 
     module_function
 
@@ -111,10 +111,6 @@ def _to_time_from_duckdb_timestamp_tz(bits)
       Time.parse(timestamp_str)
     end
 
-    def _to_hugeint_from_vector(lower, upper)
-      (upper << HALF_HUGEINT_BIT) + lower
-    end
-
     def _hugeint_lower(value)
       value & LOWER_HUGEINT_MASK
     end
@@ -127,23 +123,10 @@ def _decimal_width(value)
       value.to_s('F').gsub(/[^0-9]/, '').length
     end
 
-    def _to_decimal_from_hugeint(width, scale, upper, lower = nil)
-      v = lower.nil? ? upper : _to_hugeint_from_vector(lower, upper)
-      _to_decimal_from_value(width, scale, v)
-    end
-
-    def _to_decimal_from_value(_width, scale, value)
-      BigDecimal("#{value}e-#{scale}")
-    end
-
     def _decimal_to_unscaled(value, scale)
       (value * (10**scale)).to_i
     end
 
-    def _to_interval_from_vector(months, days, micros)
-      Interval.new(interval_months: months, interval_days: days, interval_micros: micros)
-    end
-
     def _parse_date(value)
       case value
       when Date, Time
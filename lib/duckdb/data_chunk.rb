@@ -30,6 +30,10 @@ class DataChunk
     # Sets a value at the specified column and row index.
     # Type conversion is automatic based on the column's logical type.
     #
+    # In a table function with projection pushdown enabled, +col_idx+ is the
+    # column's index as declared in the bind callback; a value for a column the
+    # query does not read is skipped.
+    #
     # @param col_idx [Integer] Column index (0-based)
     # @param row_idx [Integer] Row index (0-based)
     # @param value [Object] Value to set (Integer, Float, String, Time, Date, nil)
@@ -46,6 +50,11 @@ class DataChunk
     #
     # rubocop:disable Metrics/AbcSize, Metrics/CyclomaticComplexity, Metrics/MethodLength
     def set_value(col_idx, row_idx, value)
+      if @column_positions
+        col_idx = @column_positions[col_idx]
+        return value if col_idx.nil?
+      end
+
       vector = cached_vector(col_idx)
       type_id = cached_type_id(col_idx, vector)
 
@@ -96,6 +105,64 @@ def set_value(col_idx, row_idx, value)
     end
     # rubocop:enable Metrics/AbcSize, Metrics/CyclomaticComplexity, Metrics/MethodLength
 
+    #
+    # Writes +values+ into the column +col_idx+, starting at row +offset+.
+    # The column's type is resolved once and the values are written in C, so
+    # this is much faster than calling #set_value for each row. +nil+ values
+    # are written as NULL. A LIST column takes Arrays, and a STRUCT column takes
+    # Hashes keyed by the field names (String or Symbol) or Arrays of the fields
+    # in order. The chunk size is left unchanged.
+    #
+    # In a table function with projection pushdown enabled, +col_idx+ is the
+    # column's index as declared in the bind callback; the values of a column
+    # the query does not read are skipped.
+    #
+    # @param col_idx [Integer] Column index (0-based)
+    # @param values [Array] Values to write
+    # @param offset [Integer] Index of the row the first value is written to
+    # @return [DuckDB::DataChunk] self
+    #
+    # @example Write a column of 3 rows
+    #   output.write_column(0, [1, 2, nil])
+    #   output.write_column(1, %w[Alice Bob Cathy])
+    #   output.size = 3
+    #
+    def write_column(col_idx, values, offset: 0)
+      if @column_positions
+        col_idx = @column_positions[col_idx]
+        return self if col_idx.nil?
+      end
+
+      _write_column(col_idx, values, offset)
+    end
+
+    #
+    # Writes +rows+, an Array of row Arrays with one value per column, from the
+    # first row of the chunk, and sets the chunk size to the number of rows.
+    # The values are converted as with #write_column.
+    #
+    # With +keys+, one per column, a row can also be a Hash holding the column
+    # values under those keys (a missing key is NULL), or a Struct or Data
+    # object whose members are named by them.
+    #
+    # In a table function with projection pushdown enabled, each row holds the
+    # columns declared in the bind callback; the columns the query does not
+    # read are skipped.
+    #
+    # @param rows [Array<Array, Hash, Struct, Data>] Rows to write
+    # @param keys [Array, nil] Hash keys or member names of the columns
+    # @return [DuckDB::DataChunk] self
+    #
+    # @example Write 2 rows
+    #   output.write_rows([[1, 'Alice'], [2, 'Bob']])
+    #
+    # @example Write Hash rows
+    #   output.write_rows([{ id: 1, name: 'Alice' }, { id: 2 }], keys: %i[id name])
+    #
+    def write_rows(rows, keys: nil)
+      _write_rows(rows, @column_positions, keys)
+    end
+
     #
     # Resets the data chunk so it can be reused for another batch of rows.
     #
@@ -111,6 +178,15 @@ def reset
 
     private
 
+    # Called by the C extension when a reused chunk is pointed at another
+    # DuckDB chunk (the output of the next table function execute call): the
+    # cached vectors follow it, the cached data pointers are dropped, and the
+    # cached column types stay valid.
+    def rebind_caches
+      @vector_cache&.each { |col_idx, vector| _rebind_vector(vector, col_idx) }
+      @data_cache = nil
+    end
+
     def cached_vector(col_idx)
       @vector_cache ||= {}
       @vector_cache[col_idx] ||= get_vector(col_idx)
@@ -20,6 +20,24 @@ module DuckDB
   #   result.each do |row|
   #     p row
   #   end
+  #
+  # A database can be shared with Ractors by Ractor.make_shareable. Each
+  # Ractor then connects on its own and decodes its results in parallel.
+  # Connections, queries, prepared statements, pending results and reading
+  # results work in any Ractor; registering Ruby functions, appenders and
+  # the Arrow APIs are available in the main Ractor only. Functions can be
+  # registered before or after sharing the database. A database from
+  # DuckDB::InstanceCache cannot be shared. Close the shared database only
+  # after every Ractor is done with it: a #connect racing #close raises
+  # DuckDB::Error instead of connecting.
+  #
+  #   Ractor.make_shareable(db)
+  #   ractors = 4.times.map do |i|
+  #     Ractor.new(db, i) do |db, part|
+  #       db.connect { |con| con.query("SELECT * FROM users WHERE id % 4 = #{part}").to_a }
+  #     end
+  #   end
+  #   rows = ractors.flat_map(&:take)
   class Database
     # Opens a DuckDB database.
     #
@@ -27,6 +27,8 @@ class Result
 
     RETURN_TYPES = %i[invalid changed_rows nothing query_result].freeze
 
+    JSON_FORMATS = %i[records columns ndjson].freeze
+
     alias column_size column_count
 
     class << self
@@ -41,6 +43,125 @@ def each(&)
       _chunk_stream(&)
     end
 
+    # yields a DuckDB::Row for each row. Unlike #each, the columns of a row are
+    # decoded only when they are read, which avoids decoding the columns that
+    # the block does not use.
+    #
+    #   result = con.query('SELECT * FROM users')
+    #   ids = []
+    #   result.each_row { |row| ids << row[0] }
+    def each_row(&)
+      return _row_stream unless block_given?
+
+      _row_stream(&)
+    end
+
+    # yields each row as a Hash keyed by the column names. The keys are frozen
+    # Strings shared by all the rows, or Symbols when symbolize is true.
+    #
+    #   result = con.query('SELECT id, name FROM users')
+    #   result.each_hash(symbolize: true) { |h| p h } # => { id: 1, name: 'Alice' }
+    def each_hash(symbolize: false, &)
+      return to_enum(:each_hash, symbolize:) unless block_given?
+
+      _hash_stream(symbolize, &)
+    end
+
+    # returns all the rows as an Array of Hashes keyed by the column names.
+    #
+    #   result = con.query('SELECT id, name FROM users')
+    #   result.to_hashes # => [{ 'id' => 1, 'name' => 'Alice' }, { 'id' => 2, 'name' => 'Bob' }]
+    def to_hashes(symbolize: false)
+      _to_hashes(symbolize)
+    end
+
+    # returns the values of the column at index as a DuckDB::ColumnBuffer,
+    # reading the rest of the result. The data of each chunk is copied with
+    # one memcpy, without creating a Ruby object per value, so a numeric
+    # column can be handed to Numo::NArray or unpacked in bulk. Only
+    # fixed-width numeric and temporal columns are supported.
+    #
+    #   buffer = con.query('SELECT price FROM items').column_buffer(0)
+    #   prices = Numo::DFloat.from_binary(buffer.data)
+    def column_buffer(index)
+      column_buffer_of(_column_buffer(index))
+    end
+
+    # yields an Array of DuckDB::ColumnBuffer, one for each of the columns at
+    # indices (all the columns by default), for each chunk of the result.
+    #
+    #   result = con.query('SELECT id, price FROM items')
+    #   result.each_chunk_buffers { |ids, prices| ... }
+    def each_chunk_buffers(*indices)
+      return to_enum(:each_chunk_buffers, *indices) unless block_given?
+
+      indices = (0...column_count).to_a if indices.empty?
+      _chunk_buffers(indices) do |buffers|
+        yield buffers.map { |buffer| column_buffer_of(buffer) }
+      end
+    end
+
+    # writes the rows as JSON to io, which is an IO-like object responding to
+    # #write or a String to append to, and returns the number of rows written.
+    # The rows are fetched and serialized in C without the GVL and handed to
+    # io in blocks of about 1MB, so :records and :ndjson export a streaming
+    # result in constant memory.
+    #
+    # format is one of the following:
+    #   :records - an Array of Objects: [{"id":1,"name":"Alice"},...]
+    #   :columns - an Object of Arrays: {"id":[1,...],"name":["Alice",...]}
+    #   :ndjson  - an Object per line: {"id":1,"name":"Alice"}\n...
+    #
+    # :columns cannot write the first column before the last row is read, so
+    # it keeps the serialized values of every column in memory (about the
+    # size of the JSON output) until the end of the result.
+    #
+    # TIMESTAMP WITH TIME ZONE values are written in UTC with a +00 offset,
+    # whatever the TimeZone setting of the connection; this also applies to
+    # #write_csv.
+    #
+    #   result = con.query('SELECT id, name FROM users')
+    #   File.open('users.ndjson', 'w') { |f| result.write_json(f, format: :ndjson) }
+    def write_json(io, format: :records)
+      index = JSON_FORMATS.index(format)
+      raise ArgumentError, "format must be one of #{JSON_FORMATS.join(', ')}, got #{format.inspect}" unless index
+
+      _write_json(io, index)
+    end
+
+    # writes the rows as CSV to io, which is an IO-like object responding to
+    # #write or a String to append to, and returns the number of rows written.
+    # Like #write_json, the rows are serialized in C without the GVL and
+    # handed to io in blocks of about 1MB, so a streaming result is exported
+    # in constant memory.
+    #
+    # delimiter must be a single character other than a double quote or a
+    # line break. A field is quoted when it contains the delimiter, a double
+    # quote or a line break, or when it equals the null text. NULL is
+    # written as null.
+    # LIST, STRUCT and MAP values are written as JSON.
+    #
+    #   result = con.query('SELECT id, name FROM users')
+    #   File.open('users.tsv', 'w') { |f| result.write_csv(f, delimiter: "\t") }
+    def write_csv(io, delimiter: ',', header: true, null: '')
+      unless delimiter.is_a?(String) && delimiter.size == 1 && !delimiter.match?(/["\r\n]/)
+        raise ArgumentError, "delimiter must be one character other than a double quote or a line break: #{delimiter.inspect}"
+      end
+
+      _write_csv(io, delimiter, header, null)
+    end
+
+    # returns the rows as a JSON String, reading the rest of the result. See
+    # #write_json for the formats. Unlike #to_json, it is not called by
+    # JSON.generate, so a result nested in other data is not drained.
+    #
+    #   con.query('SELECT 1 AS id').to_json_string # => '[{"id":1}]'
+    def to_json_string(format: :records)
+      json = +''
+      write_json(json, format:)
+      json
+    end
+
     # returns return type. The return value is one of the following symbols:
     #  :invalid, :changed_rows, :nothing, :query_result
     #
@@ -98,6 +219,10 @@ def enum_dictionary_values(col_index)
 
     private
 
+    def column_buffer_of((type_id, size, data, validity))
+      ColumnBuffer.new(type: DuckDB::Converter::IntToSym.type_to_sym(type_id), size:, data:, validity:)
+    end
+
     def _enum_dictionary_size(idx)
       warn(":_enum_dictionary_size is deprecated. use columns[#{idx}].logical_type.dictionary_size instead.")
 
@@ -0,0 +1,34 @@
+# frozen_string_literal: true
+
+module DuckDB
+  # The Row class is a row of DuckDB::Result yielded by Result#each_row.
+  # Each column is decoded only when it is read.
+  #
+  #   result = con.query('SELECT * FROM users')
+  #   result.each_row do |row|
+  #     row[0]      # => 1
+  #     row[:name]  # => 'Alice'
+  #     row.to_h    # => { 'id' => 1, 'name' => 'Alice' }
+  #   end
+  #
+  # A row references the data chunk it was read from. Keeping a row after
+  # the iteration keeps its chunk alive; use #to_a or #to_h to keep only the
+  # values.
+  class Row
+    include Enumerable
+
+    alias length size
+
+    def each(&)
+      return to_enum(:each) { size } unless block_given?
+
+      to_a.each(&)
+    end
+
+    alias deconstruct to_a
+
+    def inspect
+      "#<#{self.class} #{to_h.inspect}>"
+    end
+  end
+end
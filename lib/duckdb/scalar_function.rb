@@ -161,8 +161,17 @@ def varargs_type=(logical_type)
     # The block is called once at query planning time, before execution.
     # It receives a DuckDB::ScalarFunction::BindInfo object.
     #
+    # The block is called once for each call of the function in a query. If it
+    # returns a Proc or Method, that callable is used for that call instead of
+    # the function's block, and receives the same arguments. This lets the bind
+    # block build something from constant arguments once (e.g. a Regexp from a
+    # pattern literal) instead of on every row. The callable must return the
+    # same results as the function's block, which still runs when the bind block
+    # returns anything else.
+    #
     # @yield [bind_info] called at planning time with a BindInfo object
     # @yieldparam bind_info [DuckDB::ScalarFunction::BindInfo]
+    # @yieldreturn [Proc, Method, Object] a callable specialized for this call, or anything else
     # @return [DuckDB::ScalarFunction] self
     # @raise [ArgumentError] if no block is given
     #
@@ -170,10 +179,47 @@ def varargs_type=(logical_type)
     #   sf.set_bind do |bind_info|
     #     bind_info.set_error('expected 1 argument') if bind_info.argument_count != 1
     #   end
+    #
+    # @example Compile a constant pattern once per query
+    #   sf.set_function { |str, pattern| Regexp.new(pattern).match?(str) }
+    #   sf.set_bind do |bind_info|
+    #     pattern = bind_info.get_argument(1)
+    #     next unless pattern.foldable?
+    #
+    #     regexp = Regexp.new(pattern.fold(bind_info.client_context))
+    #     ->(str, _pattern) { regexp.match?(str) }
+    #   end
     def set_bind(&block)
       raise ArgumentError, 'block is required' unless block
 
       _set_bind(&block)
     end
+
+    if DuckDB::ScalarFunction.private_method_defined?(:_set_init)
+      # Registers an init callback that builds per-thread state for the function.
+      # The block is called once on each thread that executes the function in a
+      # query, with the query's DuckDB::ClientContext, and its return value is
+      # passed as the first argument to every call of the function's block (or of
+      # a callable returned by the bind block) on that thread. Threads never
+      # share the state, so it can hold resources that are not thread-safe, such
+      # as parsers, buffers or caches, without locking.
+      #
+      # Requires DuckDB >= 1.5.0.
+      #
+      # @yield [client_context] called once per executing thread
+      # @yieldparam client_context [DuckDB::ClientContext]
+      # @yieldreturn [Object] the thread's state
+      # @return [DuckDB::ScalarFunction] self
+      # @raise [ArgumentError] if no block is given
+      #
+      # @example Cache lookups per thread
+      #   sf.set_init { |_client_context| {} }
+      #   sf.set_function { |cache, word| cache[word] ||= expensive_lookup(word) }
+      def set_init(&block)
+        raise ArgumentError, 'block is required' unless block
+
+        _set_init(&block)
+      end
+    end
   end
 end
@@ -49,6 +49,19 @@ class << self
       # @param name [String] The name of the table function
       # @param parameters [Array<LogicalType>, Hash<String, LogicalType>] Function parameters (optional)
       # @param columns [Hash<String, LogicalType>] Output columns (required)
+      # @param partitions [Array, #call, nil] Work units threads claim with
+      #   FunctionInfo#next_partition, or a callable receiving the InitInfo and
+      #   returning them (optional; see InitInfo#partitions=)
+      # @param local_init [#call, nil] Called once per executing thread with the
+      #   InitInfo; its result is available as FunctionInfo#local_state (optional)
+      # @param projection_pushdown [Boolean] Produce only the columns a query
+      #   reads (see #projection_pushdown=); the execute block can ask
+      #   FunctionInfo#projected_columns which ones (default: false)
+      # @param cardinality [Integer, #call, nil] The number of rows the function
+      #   returns, given to DuckDB's optimizer for join ordering; a callable
+      #   receives the BindInfo (see #cardinality=) (optional)
+      # @param exact_cardinality [Boolean] Whether +cardinality+ is exact rather
+      #   than an estimate (default: false)
       # @yield [func_info, output] The execute block that generates data
       # @yieldparam func_info [FunctionInfo] Function execution context
       # @yieldparam output [DataChunk] Output data chunk to fill
@@ -75,38 +88,69 @@ class << self
       #     3  # Return row count
       #   end
       #
+      # @example Scan shards from several threads at once
+      #   tf = TableFunction.create(
+      #     name: 'shards',
+      #     columns: { 'line' => LogicalType::VARCHAR },
+      #     partitions: %w[shard-0.txt shard-1.txt shard-2.txt],
+      #     local_init: ->(_init_info) { { lines: [] } }
+      #   ) do |func_info, output|
+      #     state = func_info.local_state
+      #     while state[:lines].empty? && (path = func_info.next_partition)
+      #       state[:lines] = File.readlines(path, chomp: true)
+      #     end
+      #     rows = state[:lines].shift(2048)
+      #     rows.each_with_index { |line, i| output.set_value(0, i, line) }
+      #     rows.size
+      #   end
+      #
+      # @example Convert only the columns a query reads
+      #   tf = TableFunction.create(name: 'wide', columns: wide_columns, projection_pushdown: true) do |func_info, output|
+      #     next 0 if rows.empty?
+      #
+      #     batch = rows.shift(2048)
+      #     func_info.projected_columns.each do |col|
+      #       batch.each_with_index { |row, i| output.set_value(col, i, row[col]) }
+      #     end
+      #     batch.size
+      #   end
+      #
+      # @example Tell the optimizer how many rows to expect
+      #   tf = TableFunction.create(name: 'events', columns:, cardinality: ->(_bind_info) { events.size },
+      #                             exact_cardinality: true) do |func_info, output|
+      #     # ...
+      #   end
+      #
       # rubocop:disable Metrics/AbcSize, Metrics/CyclomaticComplexity, Metrics/MethodLength, Metrics/PerceivedComplexity
-      def create(name:, columns:, parameters: nil, &)
+      # rubocop:disable Metrics/ParameterLists
+      def create(name:, columns:, parameters: nil, partitions: nil, local_init: nil, projection_pushdown: false,
+                 cardinality: nil, exact_cardinality: false, &)
         raise ArgumentError, 'name is required' unless name
         raise ArgumentError, 'columns are required' unless columns
         raise ArgumentError, 'block is required' unless block_given?
 
         tf = new
         tf.name = name
+        tf.cardinality = cardinality
+        tf.exact_cardinality = exact_cardinality
 
-        # Add parameters (positional or named)
-        if parameters
-          case parameters
-          when Array
-            parameters.each { |type| tf.add_parameter(type) }
-          when Hash
-            parameters.each { |param_name, type| tf.add_named_parameter(param_name, type) }
-          else
-            raise ArgumentError, 'parameters must be Array or Hash'
-          end
-        end
+        add_parameters(tf, parameters) if parameters
 
         # Set bind callback to add result columns
         tf.bind do |bind_info|
           columns.each do |col_name, col_type|
             bind_info.add_result_column(col_name, col_type)
           end
+          tf.__send__(:bind_cardinality, bind_info)
         end
 
+        tf.projection_pushdown = true if projection_pushdown
+
         # Set init callback (required by DuckDB)
-        tf.init do |_init_info|
-          # No-op
+        tf.init do |init_info|
+          init_info.partitions = partitions.respond_to?(:call) ? partitions.call(init_info) : partitions if partitions
         end
+        tf.local_init { |init_info| local_init.call(init_info) } if local_init
 
         # Set execute callback - user's block returns row count
         tf.execute do |func_info, output|
@@ -116,8 +160,73 @@ def create(name:, columns:, parameters: nil, &)
 
         tf
       end
+      # rubocop:enable Metrics/ParameterLists
       # rubocop:enable Metrics/AbcSize, Metrics/CyclomaticComplexity, Metrics/MethodLength, Metrics/PerceivedComplexity
 
+      #
+      # Creates a table function that streams the rows of an Enumerator.
+      #
+      # The block is called once per scan with the function's arguments and
+      # returns an Enumerator (or any object responding to +each+) yielding one
+      # Array of column values per row. Each execute call pulls up to
+      # DuckDB.vector_size rows from it, suspending the enumerator in between,
+      # writes them with DataChunk#write_rows, and the scan ends when the
+      # enumerator is exhausted. Rows are pulled only as DuckDB asks for them, so an infinite
+      # or huge source is read in constant memory, and a query with LIMIT stops
+      # pulling once it has enough rows.
+      #
+      # The rows are produced on one thread, in the enumerator's order. Columns
+      # the query does not read are not converted.
+      #
+      # @param name [String] The name of the table function
+      # @param columns [Hash<String, LogicalType>] Output columns
+      # @param parameters [Array<LogicalType>, Hash<String, LogicalType>] Function parameters (optional)
+      # @param cardinality [Integer, #call, nil] The expected number of rows, or
+      #   a callable receiving the BindInfo and returning it (see #cardinality=) (optional)
+      # @param exact_cardinality [Boolean] Whether +cardinality+ is exact (default: false)
+      # @yield [params] Returns the rows of one scan
+      # @yieldparam params [Array, Hash] The positional arguments as an Array, or
+      #   the named arguments as a Hash when +parameters+ is a Hash
+      # @yieldreturn [Enumerator] Enumerator of row Arrays
+      # @return [TableFunction] The configured table function
+      #
+      # @example Tail a log file
+      #   tf = DuckDB::TableFunction.from_enumerator('log_lines', columns: { 'line' => :varchar }) do
+      #     File.foreach('app.log', chomp: true).lazy.map { |line| [line] }
+      #   end
+      #   con.register_table_function(tf)
+      #   con.query("SELECT count(*) FROM log_lines() WHERE line LIKE '%ERROR%'")
+      #
+      # @example Generate rows from the arguments
+      #   tf = DuckDB::TableFunction.from_enumerator(
+      #     'squares', columns: { 'n' => :bigint, 'square' => :bigint }, parameters: [:bigint]
+      #   ) do |(count)|
+      #     (1..count).each.lazy.map { |n| [n, n * n] }
+      #   end
+      #
+      # rubocop:disable Metrics/MethodLength
+      def from_enumerator(name, columns:, parameters: nil, cardinality: nil, exact_cardinality: false, &block)
+        raise ArgumentError, 'block is required' unless block
+
+        tf = new
+        tf.name = name
+        tf.cardinality = cardinality
+        tf.exact_cardinality = exact_cardinality
+        add_parameters(tf, parameters) if parameters
+        tf.bind do |bind_info|
+          columns.each { |col_name, col_type| bind_info.add_result_column(col_name, col_type) }
+          bind_info.bind_data = bound_parameters(bind_info, parameters)
+          tf.__send__(:bind_cardinality, bind_info)
+        end
+        tf.projection_pushdown = true
+        # One partition: the enumerator is claimed and drained by a single thread.
+        tf.init { |init_info| init_info.partitions = [block.call(init_info.bind_data)] }
+        tf.local_init { |_init_info| EnumeratorScan.new }
+        tf.execute { |func_info, output| write_enumerator_rows(func_info, output) }
+        tf
+      end
+      # rubocop:enable Metrics/MethodLength
+
       # Registers a table adapter for a Ruby class.
       #
       # The adapter is used by +DuckDB::Connection#expose_as_table+ to convert
@@ -135,6 +244,15 @@ def create(name:, columns:, parameters: nil, &)
       # - Return the number of rows written as an +Integer+
       # - Return +0+ to signal that all data has been exhausted
       #
+      # For wide sources, pass +projection_pushdown: true+ to +create+: writes to
+      # columns the query does not read are then skipped, and
+      # +func_info.projected_columns+ tells the block which columns to produce.
+      #
+      # When the adapter knows how many rows the object holds, pass it as
+      # +cardinality:+ to +create+ so DuckDB can order joins against the table
+      # sensibly; without it the optimizer assumes the function returns a
+      # single row.
+      #
       # @example Minimal adapter for CSV objects
       #   class CSVTableAdapter
       #     def call(csv, name, columns: nil)
@@ -185,6 +303,87 @@ def add_table_adapter(klass, adapter)
       def table_adapter_for(klass)
         @table_adapters[klass]
       end
+
+      private
+
+      def add_parameters(table_function, parameters)
+        case parameters
+        when Array
+          parameters.each { |type| table_function.add_parameter(DuckDB::LogicalType.resolve(type)) }
+        when Hash
+          parameters.each do |param_name, type|
+            table_function.add_named_parameter(param_name, DuckDB::LogicalType.resolve(type))
+          end
+        else
+          raise ArgumentError, 'parameters must be Array or Hash'
+        end
+      end
+
+      def bound_parameters(bind_info, parameters)
+        if parameters.is_a?(Hash)
+          parameters.keys.to_h { |param_name| [param_name, bind_info.get_named_parameter(param_name.to_s)] }
+        else
+          Array.new(bind_info.parameter_count) { |i| bind_info.get_parameter(i) }
+        end
+      end
+
+      def write_enumerator_rows(func_info, output)
+        scan = func_info.local_state
+        scan.batches ||= batches_of(func_info.next_partition)
+        output.write_rows(scan.batches&.alive? ? scan.batches.resume : [])
+      end
+
+      # Runs source.each in a Fiber that hands out the rows in batches of
+      # DuckDB.vector_size, so the source is suspended once per chunk, not per row.
+      def batches_of(source)
+        return if source.nil?
+
+        Fiber.new do
+          rows = []
+          source.each do |row|
+            rows << row
+            next if rows.size < DuckDB.vector_size
+
+            Fiber.yield rows
+            rows = []
+          end
+          rows
+        end
+      end
+    end
+
+    # The local state of a TableFunction.from_enumerator scan: the Fiber
+    # reading the source in batches.
+    EnumeratorScan = Struct.new(:batches) do # :nodoc:
+      # Called when DuckDB tears the scan down. A scan stopped early (LIMIT,
+      # errors) leaves the Fiber suspended inside source.each; killing it runs
+      # the source's ensure blocks, so files and cursors it holds are closed.
+      def close
+        batches.kill if batches&.alive?
+      end
+    end
+    private_constant :EnumeratorScan
+
+    #
+    # The number of rows DuckDB's optimizer should expect from a table function
+    # built by TableFunction.create or TableFunction.from_enumerator: an
+    # Integer, or an object responding to +call(bind_info)+ that returns one
+    # (or +nil+ for no hint) each time a query binds the function. Without a
+    # hint DuckDB plans the function as if it returned a single row, which can
+    # put a large Ruby source on the build side of a hash join.
+    #
+    #   tf.cardinality = 1_000_000
+    #
+    attr_accessor :cardinality
+
+    # Whether #cardinality is the exact number of rows rather than an estimate.
+    attr_accessor :exact_cardinality
+
+    private
+
+    def bind_cardinality(bind_info)
+      rows = cardinality.respond_to?(:call) ? cardinality.call(bind_info) : cardinality
+      bind_info.set_cardinality(rows, exact_cardinality) if rows
     end
   end
 end
@@ -0,0 +1,109 @@
+# frozen_string_literal: true
+
+module DuckDB
+  class TableFunction
+    #
+    # The table adapter DuckDB::Connection#expose_as_table uses for Arrays.
+    # It is registered for Array by default.
+    #
+    # The rows can be Arrays (positional columns), Hashes (a column per key) or
+    # Struct or Data objects (a column per member). Without +columns:+, the
+    # columns are inferred from the first SAMPLE_SIZE rows. They are named by
+    # the Hash keys or member names, or +column0+, +column1+, ... for Array
+    # rows, and typed by their values: Integer is BIGINT (HUGEINT when it does not fit),
+    # Float DOUBLE, true/false BOOLEAN, Time TIMESTAMP, Date DATE, and anything
+    # else VARCHAR. Integers and Floats mixed in a column make a DOUBLE column.
+    #
+    # The Array is read when a query runs, so rows added after
+    # expose_as_table are included, and the optimizer is told the exact row
+    # count when a query is planned. The rows are written to DuckDB by
+    # DataChunk#write_rows, a chunk at a time, and only the columns a query
+    # reads are converted.
+    #
+    #   users = [{ id: 1, name: 'Alice' }, { id: 2, name: 'Bob' }]
+    #   con.expose_as_table(users, 'users')
+    #   con.query('SELECT name FROM users() WHERE id = 2').to_a # => [["Bob"]]
+    #
+    class ArrayAdapter
+      SAMPLE_SIZE = 1000
+
+      INFERRED_TYPES = {
+        Integer => :bigint,
+        Float => :double,
+        TrueClass => :boolean,
+        FalseClass => :boolean,
+        Time => :timestamp,
+        Date => :date
+      }.freeze
+
+      def call(rows, name, columns: nil)
+        sample = rows.first(SAMPLE_SIZE).compact
+        keys = row_keys(sample)
+        columns ||= infer_columns(sample, keys)
+        keys = column_keys(keys, columns) if keys
+
+        table_function(rows, name, columns, keys)
+      end
+
+      private
+
+      def table_function(rows, name, columns, keys)
+        vector_size = DuckDB.vector_size
+        TableFunction.create(
+          name:, columns:, projection_pushdown: true,
+          cardinality: ->(_bind_info) { rows.size }, exact_cardinality: true,
+          partitions: ->(_init_info) { (0...rows.size).step(vector_size).to_a }
+        ) do |func_info, output|
+          start = func_info.next_partition
+          start ? output.write_rows(rows[start, vector_size], keys:).size : 0
+        end
+      end
+
+      def row_keys(sample)
+        case sample.first
+        when Hash
+          sample.flat_map(&:keys).uniq
+        when Struct, Data
+          sample.first.class.members
+        end
+      end
+
+      # The key of each column in the rows: the Hash key or member whose name
+      # is the column name.
+      def column_keys(keys, columns)
+        columns.keys.map { |column| keys.find { |key| key.to_s == column.to_s } || column.to_s }
+      end
+
+      def infer_columns(sample, keys)
+        raise ArgumentError, 'columns: is required to expose an empty Array' if sample.empty?
+
+        unless keys
+          return Array.new(sample.first.size) { |i| ["column#{i}", infer_type(sample.map { |row| row[i] })] }.to_h
+        end
+
+        keys.to_h { |key| [key.to_s, infer_type(sample.map { |row| field(row, key) })] }
+      end
+
+      def field(row, key)
+        row.is_a?(Hash) ? row[key] : row.public_send(key)
+      end
+
+      def infer_type(values)
+        types = values.compact.map { |value| value_type(value) }.uniq.sort
+        return types.first if types.size == 1
+        return :double if types == %i[bigint double]
+        return :hugeint if types == %i[bigint hugeint]
+
+        :varchar
+      end
+
+      def value_type(value)
+        return :hugeint if value.is_a?(Integer) && !value.between?(-(2**63), (2**63) - 1)
+
+        INFERRED_TYPES.fetch(value.class, :varchar)
+      end
+    end
+
+    add_table_adapter(Array, ArrayAdapter.new)
+  end
+end
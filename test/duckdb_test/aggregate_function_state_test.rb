@@ -0,0 +1,136 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class AggregateFunctionStateTest < Minitest::Test
+    def setup
+      @db = DuckDB::Database.open
+      @con = @db.connect
+    end
+
+    def teardown
+      @con&.close
+      @db&.close
+    end
+
+    def test_s_create_with_state
+      register_weighted_avg
+
+      assert_in_delta 5.0 / 3, @con.query('SELECT my_weighted_avg(i, i) FROM range(3) t(i)').first.first
+    end
+
+    def test_native_combine_in_parallel_group_by
+      baseline = DuckDB::AggregateFunction._state_registry_size
+      register_weighted_avg
+      @con.execute('SET threads=4')
+      result = @con.query(<<~SQL).to_a
+        SELECT g, my_weighted_avg(i, 1) FROM (SELECT i % 3 AS g, i FROM range(300000) t(i)) GROUP BY g ORDER BY g
+      SQL
+
+      assert_equal [[0, 149_998.5], [1, 149_999.5], [2, 150_000.5]], result
+      assert_equal baseline, DuckDB::AggregateFunction._state_registry_size
+    end
+
+    def test_set_state_with_initial_values_and_combine_per_field
+      af = new_aggregate('my_range', :bigint, [:bigint])
+      af.set_state({ min: :bigint, max: :bigint }, init: { min: (2**63) - 1, max: -2**63 })
+      af.set_update do |state, value|
+        state.min = value if value < state.min
+        state.max = value if value > state.max
+      end
+      af.set_combine(min: :min, max: :max)
+      af.set_finalize { |state| state.max - state.min }
+      @con.register_aggregate_function(af)
+      @con.execute('SET threads=4')
+
+      assert_equal 99_989, @con.query('SELECT my_range(i) FROM range(5, 99995) t(i)').first.first
+    end
+
+    def test_combine_block_updates_target_state
+      af = new_aggregate('my_count', :varchar, [:bigint])
+      af.set_state({ n: :bigint, total: :double })
+      af.set_update do |state, value|
+        state[:n] += 1
+        state[:total] += value
+      end
+      af.set_combine do |source, target|
+        target.n += source.n
+        target.total += source.total
+      end
+      af.set_finalize { |state| state.to_h.to_s }
+      @con.register_aggregate_function(af)
+
+      assert_equal({ n: 4, total: 6.0 }.to_s, @con.query('SELECT my_count(i) FROM range(4) t(i)').first.first)
+    end
+
+    def test_bigint_sum_overflow_in_native_combine_raises_error
+      af = new_aggregate('my_overflow', :bigint, [:bigint])
+      af.set_state({ n: :bigint })
+      af.set_update { |state, value| state.n += value }
+      af.set_combine(:sum)
+      @con.register_aggregate_function(af)
+      # Each thread's partial sum fits in a BIGINT; the combined sum does not.
+      @con.execute('CREATE TABLE t AS SELECT (2 ** 45)::BIGINT AS v FROM range(300000)')
+      @con.execute('SET threads=4')
+
+      error = assert_raises(DuckDB::Error) { @con.query('SELECT my_overflow(v) FROM t') }
+      assert_match(/overflow/, error.message)
+    end
+
+    def test_state_raises_outside_its_callback
+      captured = nil
+      af = new_aggregate('my_leak', :bigint, [:bigint])
+      af.set_state({ n: :bigint })
+      af.set_update { |state, _value| captured = state }
+      af.set_combine(:sum)
+      @con.register_aggregate_function(af)
+      @con.query('SELECT my_leak(i) FROM range(3) t(i)')
+
+      assert_raises(DuckDB::Error) { captured.n }
+    end
+
+    def test_set_state_raises_on_invalid_fields
+      af = new_aggregate('my_invalid', :bigint, [:bigint])
+
+      assert_raises(ArgumentError) { af.set_state({ n: :varchar }) }
+      assert_raises(ArgumentError) { af.set_state({ members: :bigint }) }
+      assert_raises(ArgumentError) { af.set_state({ n: :bigint }, init: { m: 1 }) }
+    end
+
+    def test_typed_state_rejects_set_init_and_ruby_state_rejects_combine_operations
+      af = new_aggregate('my_typed', :bigint, [:bigint])
+      af.set_state({ n: :bigint })
+
+      assert_raises(DuckDB::Error) { af.set_init { 0 } }
+      assert_raises(ArgumentError) { af.set_combine(:avg) }
+      assert_raises(ArgumentError) { new_aggregate('my_untyped', :bigint, [:bigint]).set_combine(:sum) }
+    end
+
+    private
+
+    def new_aggregate(name, return_type, params)
+      af = DuckDB::AggregateFunction.new
+      af.name = name
+      af.return_type = return_type
+      params.each { |param| af.add_parameter(param) }
+      af
+    end
+
+    def register_weighted_avg
+      af = DuckDB::AggregateFunction.create(
+        name: 'my_weighted_avg',
+        return_type: :double,
+        params: %i[double double],
+        state: { sum: :double, weight: :double },
+        update: lambda { |state, value, weight|
+          state.sum += value * weight
+          state.weight += weight
+        },
+        combine: :sum,
+        finalize: ->(state) { state.weight.zero? ? nil : state.sum / state.weight }
+      )
+      @con.register_aggregate_function(af)
+    end
+  end
+end
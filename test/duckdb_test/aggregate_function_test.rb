@@ -482,8 +482,108 @@ def test_aggregate_as_window_function_reuses_source_state
       assert_equal [[101], [201], [101]], [rows.first, rows[2500], rows.last]
     end
 
+    def test_combine_batch_and_finalize_batch_in_parallel_group_by
+      baseline = DuckDB::AggregateFunction._state_registry_size
+      batch_sizes = []
+      af = DuckDB::AggregateFunction.create(
+        name: 'batched_sum', return_type: :bigint, params: [:bigint],
+        init: -> { 0 },
+        update: ->(state, value) { state + value },
+        combine_batch: ->(sources, targets) { sources.zip(targets).map { |s, t| s + t } },
+        finalize_batch: lambda { |states|
+          batch_sizes << states.size
+          states
+        }
+      )
+      @con.register_aggregate_function(af)
+      force_parallel_execution(@con)
+      result = @con.query('SELECT i % 5000 AS g, batched_sum(i) FROM range(100000) t(i) GROUP BY g ORDER BY g').to_a
+
+      assert_equal [0, 950_000], result.first
+      assert_operator batch_sizes.max, :>, 1
+      assert_equal baseline, DuckDB::AggregateFunction._state_registry_size
+    end
+
+    def test_batch_callbacks_with_typed_state
+      af = DuckDB::AggregateFunction.new
+      af.name = 'batched_avg'
+      af.return_type = DuckDB::LogicalType::DOUBLE
+      af.add_parameter(DuckDB::LogicalType::BIGINT)
+      af.set_state({ sum: :bigint, n: :bigint })
+      af.set_update do |state, value|
+        state.sum += value
+        state.n += 1
+      end
+      af.set_combine_batch do |sources, targets|
+        sources.zip(targets).each do |s, t|
+          t.sum += s.sum
+          t.n += s.n
+        end
+      end
+      af.set_finalize_batch { |states| states.map { |state| state.sum.fdiv(state.n) } }
+      @con.register_aggregate_function(af)
+      force_parallel_execution(@con)
+
+      assert_equal [[0, 49_999.0], [1, 50_000.0]],
+                   @con.query('SELECT i % 2 AS g, batched_avg(i) FROM range(100000) t(i) GROUP BY g ORDER BY g').to_a
+    end
+
+    def test_finalize_batch_raises_on_wrong_result_size
+      baseline = DuckDB::AggregateFunction._state_registry_size
+      af = build_aggregate('bad_batch', init: -> { 0 })
+      af.set_finalize_batch { |_states| [] }
+      @con.register_aggregate_function(af)
+
+      error = assert_raises(DuckDB::Error) { @con.query('SELECT bad_batch(i) FROM range(10) t(i)') }
+      assert_match(/finalize_batch must return an Array of 1 values/, error.message)
+      assert_equal baseline, DuckDB::AggregateFunction._state_registry_size
+    end
+
+    # Proxy-thread pool: aggregate callbacks have no per-worker init hook, so
+    # without the pool every callback from a DuckDB worker ran on the single
+    # global executor. A large base table spreads the scan over worker threads;
+    # how many of them DuckDB uses varies, so only where the callbacks ran is
+    # checked: off the calling thread, and never on the executor.
+    def test_aggregate_callbacks_run_on_proxy_pool_threads
+      rows = 500_000
+      @con.execute('SET threads=4')
+      @con.execute("CREATE TABLE large_parallel AS SELECT range AS value FROM range(#{rows})")
+      threads_seen = {}
+      register_aggregate('pooled_sum',
+                         init: -> { 0 },
+                         update: lambda { |state, value|
+                           threads_seen[Thread.current] = true
+                           state + value
+                         },
+                         combine: ->(s1, s2) { s1 + s2 })
+
+      assert_equal (rows - 1) * rows / 2, @con.query('SELECT pooled_sum(value) FROM large_parallel').first.first
+      refute_empty threads_seen.keys - [Thread.current], 'expected callbacks from DuckDB worker threads'
+      refute_includes threads_seen.keys, DuckDB::AggregateFunction._executor_thread
+    end
+
+    # fork() leaves the child without the executor and pool threads; callbacks
+    # from its worker threads must not wait on threads that no longer exist.
+    def test_aggregate_function_runs_in_a_forked_child
+      skip 'fork is not available' unless Process.respond_to?(:fork)
+
+      af = build_aggregate('forked_sum', init: -> { 0 }, update: ->(s, v) { s + v }, combine: ->(s1, s2) { s1 + s2 })
+      @con.register_aggregate_function(af)
+      pid = fork { exit!(sum_in_forked_child(af) == 124_999_750_000) }
+
+      assert_predicate Process.wait2(pid).last, :success?
+    end
+
     private
 
+    def sum_in_forked_child(aggregate_function)
+      con = DuckDB::Database.open.connect
+      con.execute('SET threads=4')
+      con.execute('CREATE TABLE forked AS SELECT range AS value FROM range(500000)')
+      con.register_aggregate_function(aggregate_function)
+      con.query('SELECT forked_sum(value) FROM forked').first.first
+    end
+
     # Force DuckDB to actually parallelise aggregation so the combine callback
     # receives more than one partial state to merge.
     def force_parallel_execution(con)
@@ -95,5 +95,79 @@ def test_append_arrow_streams_multiple_chunks
       assert_equal 5000, rows
       assert_equal 5000, @conn.query('SELECT COUNT(*) FROM big_dest').to_a.first.first
     end
+
+    def test_append_arrow_with_threads_preserves_stream_order
+      @conn.query('CREATE TABLE big_dest (id BIGINT)')
+      producer = @conn.query('SELECT range AS id FROM range(20000) ORDER BY id')
+
+      rows = @conn.append_arrow('big_dest', producer, threads: 4)
+
+      assert_equal 20_000, rows
+      assert_equal [[20_000, 199_990_000, 20_000]],
+                   @conn.query('SELECT count(*), sum(id), count(DISTINCT id) FROM big_dest').to_a
+      ids = @conn.query('SELECT id FROM big_dest').to_a.flatten
+
+      assert_equal (0...20_000).to_a, ids
+    end
+
+    def test_append_arrow_raises_argument_error_for_non_positive_threads
+      producer = @conn.query('SELECT * FROM source')
+
+      assert_raises(ArgumentError) { @conn.append_arrow('dest', producer, threads: 0) }
+    end
+
+    def test_append_arrow_with_commit_every_reports_progress
+      @conn.query('CREATE TABLE big_dest (id BIGINT)')
+      producer = @conn.query('SELECT range AS id FROM range(5000)') # chunks of 2048 rows
+      progress = []
+
+      rows = @conn.append_arrow('big_dest', producer, commit_every: 2) { |chunks, n| progress << [chunks, n] }
+
+      assert_equal 5000, rows
+      assert_equal [[2, 4096], [3, 5000]], progress
+      assert_equal [[5000]], @conn.query('SELECT count(*) FROM big_dest').to_a
+    end
+
+    def test_append_arrow_with_commit_every_rolls_back_only_the_failed_batch
+      @conn.query('CREATE TABLE big_dest (id BIGINT)')
+      @conn.query('CREATE TABLE progress (chunks BIGINT)')
+      @conn.query('INSERT INTO progress VALUES (0)')
+      bad = "SELECT CASE WHEN range < 5000 THEN range::VARCHAR ELSE 'x' END AS id FROM range(10000)"
+
+      assert_raises(DuckDB::Error) do
+        @conn.append_arrow('big_dest', @conn.query(bad), commit_every: 1) do |chunks, _rows|
+          @conn.query('UPDATE progress SET chunks = ?', chunks)
+        end
+      end
+
+      assert_equal [[4096]], @conn.query('SELECT count(*) FROM big_dest').to_a
+      assert_equal [[2]], @conn.query('SELECT chunks FROM progress').to_a
+    end
+
+    def test_append_arrow_with_skip_chunks_resumes_a_load
+      @conn.query('CREATE TABLE big_dest (id BIGINT)')
+      @conn.query('INSERT INTO big_dest SELECT range FROM range(4096)') # first two chunks already loaded
+      producer = @conn.query('SELECT range AS id FROM range(10000)')
+
+      rows = @conn.append_arrow('big_dest', producer, commit_every: 1, skip_chunks: 2)
+
+      assert_equal 5904, rows
+      assert_equal [[10_000, 10_000]], @conn.query('SELECT count(*), count(DISTINCT id) FROM big_dest').to_a
+    end
+
+    def test_append_arrow_with_commit_every_raises_argument_error_inside_a_transaction
+      @conn.query('CREATE TABLE big_dest (id BIGINT)')
+      @conn.query('BEGIN TRANSACTION')
+      producer = @conn.query('SELECT range AS id FROM range(10)')
+
+      assert_raises(ArgumentError) { @conn.append_arrow('big_dest', producer, commit_every: 1) }
+      @conn.query('ROLLBACK')
+    end
+
+    def test_append_arrow_raises_argument_error_for_non_positive_commit_every
+      producer = @conn.query('SELECT * FROM source')
+
+      assert_raises(ArgumentError) { @conn.append_arrow('dest', producer, commit_every: 0) }
+    end
   end
 end
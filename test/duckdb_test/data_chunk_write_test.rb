@@ -0,0 +1,176 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class DataChunkWriteTest < Minitest::Test
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.disconnect
+      @db.close
+    end
+
+    def test_write_column
+      @conn.execute('CREATE TABLE t (i INTEGER, d DOUBLE, s VARCHAR, b BOOLEAN)')
+      chunk = new_chunk(:integer, :double, :varchar, :boolean)
+
+      chunk.write_column(0, [1, nil, 3])
+      chunk.write_column(1, [1.5, 2.5, nil])
+      chunk.write_column(2, ['a', nil, :c])
+      chunk.write_column(3, [true, false, nil])
+      chunk.size = 3
+
+      assert_equal [[1, 1.5, 'a', true], [nil, 2.5, nil, false], [3, nil, 'c', nil]], append_and_read('t', chunk)
+    end
+
+    def test_write_column_with_offset
+      @conn.execute('CREATE TABLE t (i BIGINT)')
+      chunk = new_chunk(:bigint)
+
+      chunk.write_column(0, [1, 2])
+      chunk.write_column(0, [nil, 4], offset: 1)
+      chunk.size = 3
+
+      assert_equal [[1], [nil], [4]], append_and_read('t', chunk)
+    end
+
+    def test_write_column_overwrites_null_rows
+      @conn.execute('CREATE TABLE t (i INTEGER)')
+      chunk = new_chunk(:integer)
+
+      chunk.write_column(0, [nil, nil])
+      chunk.write_column(0, [1, 2])
+      chunk.size = 2
+
+      assert_equal [[1], [2]], append_and_read('t', chunk)
+    end
+
+    def test_write_column_temporal_and_decimal_values
+      @conn.execute('CREATE TABLE t (d DATE, ts TIMESTAMP, n DECIMAL(10, 2), h HUGEINT)')
+      chunk = new_chunk(:date, :timestamp, DuckDB::LogicalType.create_decimal(10, 2), :hugeint)
+      time = Time.local(2024, 3, 15, 10, 30, 45)
+
+      chunk.write_column(0, [Date.new(2024, 3, 15)])
+      chunk.write_column(1, [time])
+      chunk.write_column(2, [BigDecimal('12.34')])
+      chunk.write_column(3, [2**100])
+      chunk.size = 1
+
+      assert_equal [[Date.new(2024, 3, 15), time, BigDecimal('12.34'), 2**100]], append_and_read('t', chunk)
+    end
+
+    def test_write_rows
+      @conn.execute('CREATE TABLE t (id INTEGER, name VARCHAR)')
+      chunk = new_chunk(:integer, :varchar)
+
+      assert_same chunk, chunk.write_rows([[1, 'Alice'], [2, nil], [nil, 'Cathy']])
+      assert_equal 3, chunk.size
+      assert_equal [[1, 'Alice'], [2, nil], [nil, 'Cathy']], append_and_read('t', chunk)
+    end
+
+    def test_write_rows_with_list_and_struct_columns
+      @conn.execute('CREATE TABLE t (l INTEGER[], s STRUCT(name VARCHAR, tags VARCHAR[]))')
+      list = DuckDB::LogicalType.create_list(:integer)
+      struct = DuckDB::LogicalType.create_struct(name: :varchar, tags: DuckDB::LogicalType.create_list(:varchar))
+      chunk = new_chunk(list, struct)
+
+      chunk.write_rows([
+                         [[1, 2, nil], { name: 'a', tags: %w[x y] }],
+                         [[], { 'name' => 'b', 'tags' => nil }],
+                         [nil, ['c', []]],
+                         [[3], nil]
+                       ])
+
+      assert_equal [
+        [[1, 2, nil], { name: 'a', tags: %w[x y] }],
+        [[], { name: 'b', tags: nil }],
+        [nil, { name: 'c', tags: [] }],
+        [[3], nil]
+      ], append_and_read('t', chunk)
+    end
+
+    def test_write_rows_with_keys
+      @conn.execute('CREATE TABLE t (id INTEGER, name VARCHAR)')
+      chunk = new_chunk(:integer, :varchar)
+      row = Struct.new(:id, :name)
+
+      chunk.write_rows([{ id: 1, name: 'Alice' }, { id: 2 }, row.new(3, 'Cathy'), [4, 'Dan']], keys: %i[id name])
+
+      assert_equal [[1, 'Alice'], [2, nil], [3, 'Cathy'], [4, 'Dan']], append_and_read('t', chunk)
+    end
+
+    def test_write_rows_with_keys_raises_on_wrong_key_count
+      chunk = new_chunk(:integer, :varchar)
+
+      assert_raises(ArgumentError) { chunk.write_rows([{ id: 1 }], keys: %i[id]) }
+      assert_raises(TypeError) { chunk.write_rows([1], keys: %i[id name]) }
+    end
+
+    def test_write_rows_raises_on_wrong_row_width
+      chunk = new_chunk(:integer, :varchar)
+
+      assert_raises(ArgumentError) { chunk.write_rows([[1, 'a'], [2]]) }
+    end
+
+    def test_write_column_raises_over_capacity
+      chunk = new_chunk(:integer)
+
+      assert_raises(ArgumentError) { chunk.write_column(0, [1] * 2049) }
+      assert_raises(ArgumentError) { chunk.write_column(0, [1, 2], offset: 2047) }
+    end
+
+    def test_write_column_raises_on_invalid_column_index
+      chunk = new_chunk(:integer)
+
+      assert_raises(IndexError) { chunk.write_column(1, [1]) }
+    end
+
+    def test_write_column_raises_on_invalid_values
+      chunk = new_chunk(:integer, DuckDB::LogicalType.create_list(:integer))
+
+      assert_raises(TypeError) { chunk.write_column(0, ['a']) }
+      assert_raises(TypeError) { chunk.write_column(1, [1]) }
+    end
+
+    def test_write_rows_in_table_function_with_projection_pushdown
+      tf = DuckDB::TableFunction.new
+      tf.name = 'bulk_rows'
+      tf.bind do |bind_info|
+        bind_info.add_result_column('id', DuckDB::LogicalType::BIGINT)
+        bind_info.add_result_column('name', DuckDB::LogicalType::VARCHAR)
+        bind_info.add_result_column('score', DuckDB::LogicalType::DOUBLE)
+      end
+      done = false
+      tf.init { |_init_info| done = false }
+      tf.projection_pushdown = true
+      tf.execute do |_func_info, output|
+        if done
+          output.size = 0
+        else
+          output.write_rows(Array.new(2048) { |i| [i, "n#{i}", i * 0.5] })
+          done = true
+        end
+      end
+      @conn.register_table_function(tf)
+
+      assert_equal [[2048, 1_048_064.0]], @conn.query('SELECT count(*), sum(score) FROM bulk_rows()').to_a
+    end
+
+    private
+
+    def new_chunk(*types)
+      DuckDB::DataChunk.new(types.map { |t| DuckDB::LogicalType.resolve(t) })
+    end
+
+    def append_and_read(table, chunk)
+      appender = @conn.appender(table)
+      appender.append_data_chunk(chunk)
+      appender.close
+      @conn.query("SELECT * FROM #{table}").to_a
+    end
+  end
+end
@@ -0,0 +1,107 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class RactorTest < Minitest::Test
+    def setup
+      @experimental = Warning[:experimental]
+      Warning[:experimental] = false
+      @db = DuckDB::Database.open
+      @db.connect do |con|
+        con.query("CREATE TABLE t AS SELECT range AS id, 'v' || range AS s, range * 1.5 AS d FROM range(10000)")
+      end
+      Ractor.make_shareable(@db)
+    end
+
+    def teardown
+      @db.close
+      Warning[:experimental] = @experimental
+    end
+
+    def test_database_is_shareable
+      assert Ractor.shareable?(@db)
+    end
+
+    def test_query_in_ractors
+      ractors = Array.new(4) do |i|
+        Ractor.new(@db, i) do |db, part|
+          db.connect { |con| con.query("SELECT id, s, d FROM t WHERE id % 4 = #{part} ORDER BY id").to_a }
+        end
+      end
+      rows = ractors.flat_map { |ractor| ractor_value(ractor) }
+
+      assert_equal 10_000, rows.size
+      assert_equal [[0, 'v0', BigDecimal('0.0')], [1, 'v1', BigDecimal('1.5')]], rows.sort.first(2)
+    end
+
+    def test_result_apis_in_ractor
+      ractor = Ractor.new(@db) do |db|
+        db.connect do |con|
+          [
+            con.query('SELECT id FROM t WHERE id < 2 ORDER BY id').to_hashes,
+            con.query('SELECT id FROM t ORDER BY id').fetch(1),
+            con.query('SELECT ?::INTEGER + 1 AS n', 1).each_row.map { |row| row[:n] }
+          ]
+        end
+      end
+
+      assert_equal [[{ 'id' => 0 }, { 'id' => 1 }], [[0]], [2]], ractor_value(ractor)
+    end
+
+    def test_register_function_in_ractor_raises
+      ractor = Ractor.new(@db) do |db|
+        db.connect do |con|
+          con.register_scalar_function(name: :one, return_type: :integer, parameter_types: []) { 1 }
+        rescue Ractor::UnsafeError => e
+          e.class
+        end
+      end
+
+      assert_equal Ractor::UnsafeError, ractor_value(ractor)
+    end
+
+    def test_register_function_after_sharing
+      @db.connect do |con|
+        con.register_scalar_function(name: :plus_one, return_type: :integer, parameter_types: [:integer]) { |v| v + 1 }
+      end
+      ractor = Ractor.new(@db) { |db| db.connect { |con| con.query('SELECT plus_one(41)').to_a } }
+
+      assert_equal [[42]], ractor_value(ractor)
+    end
+
+    def test_register_function_before_sharing
+      db = DuckDB::Database.open
+      db.connect do |con|
+        con.register_scalar_function(name: :plus_two, return_type: :integer, parameter_types: [:integer]) { |v| v + 2 }
+      end
+      Ractor.make_shareable(db)
+      ractor = Ractor.new(db) { |shared| shared.connect { |con| con.query('SELECT plus_two(40)').to_a } }
+
+      assert_equal [[42]], ractor_value(ractor)
+    ensure
+      db&.close
+    end
+
+    def test_close_while_ractors_connect
+      db = Ractor.make_shareable(DuckDB::Database.open)
+      ractors = Array.new(4) do
+        Ractor.new(db) do |shared|
+          loop { shared.connect { |con| con.query('SELECT 1').to_a } }
+        rescue DuckDB::Error
+          :closed
+        end
+      end
+      sleep 0.05
+      db.close
+
+      assert_equal [:closed] * 4, ractors.map { |ractor| ractor_value(ractor) }
+    end
+
+    private
+
+    def ractor_value(ractor)
+      ractor.respond_to?(:value) ? ractor.value : ractor.take
+    end
+  end
+end
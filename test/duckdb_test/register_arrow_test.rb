@@ -0,0 +1,104 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class RegisterArrowTest < Minitest::Test
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+      @conn.query('CREATE TABLE source (id INTEGER, name VARCHAR, score DOUBLE)')
+      @conn.query("INSERT INTO source VALUES (1, 'Alice', 1.5), (2, 'Bob', 2.5), (3, 'Cathy', 3.5)")
+    end
+
+    def teardown
+      @conn.disconnect
+      @db.close
+    end
+
+    def test_register_arrow_scans_an_arrow_producer
+      @conn.register_arrow('arrow_source', @conn.query('SELECT * FROM source ORDER BY id'))
+
+      assert_equal [[1, 'Alice', 1.5], [2, 'Bob', 2.5], [3, 'Cathy', 3.5]],
+                   @conn.query('SELECT * FROM arrow_source() ORDER BY id').to_a
+    end
+
+    def test_register_arrow_reads_column_names_and_types
+      @conn.register_arrow('arrow_source', @conn.query('SELECT * FROM source'))
+
+      result = @conn.query('SELECT * FROM arrow_source()')
+
+      assert_equal %w[id name score], result.columns.map(&:name)
+      assert_equal %i[integer varchar double], result.columns.map(&:type)
+    end
+
+    def test_register_arrow_with_projection
+      @conn.register_arrow('arrow_source', @conn.query('SELECT * FROM source ORDER BY id'))
+
+      assert_equal [['Cathy', 3], ['Bob', 2], ['Alice', 1]],
+                   @conn.query('SELECT name, id FROM arrow_source() ORDER BY id DESC').to_a
+    end
+
+    def test_register_arrow_with_count_star
+      @conn.register_arrow('arrow_source', @conn.query('SELECT * FROM source'))
+
+      assert_equal [[3]], @conn.query('SELECT count(*) FROM arrow_source()').to_a
+    end
+
+    def test_register_arrow_joins_with_a_table
+      @conn.query('CREATE TABLE orders (user_id INTEGER, item VARCHAR)')
+      @conn.query("INSERT INTO orders VALUES (1, 'book'), (3, 'pen'), (3, 'ink')")
+      @conn.register_arrow('users', @conn.query('SELECT id, name FROM source'))
+
+      sql = 'SELECT u.name, o.item FROM orders o JOIN users() u ON u.id = o.user_id ORDER BY 1, 2'
+
+      assert_equal [%w[Alice book], %w[Cathy ink], %w[Cathy pen]], @conn.query(sql).to_a
+    end
+
+    def test_register_arrow_scans_many_chunks
+      @conn.register_arrow('numbers', @conn.query('SELECT range AS n FROM range(10000)'))
+
+      assert_equal [[10_000, 49_995_000]], @conn.query('SELECT count(*), sum(n) FROM numbers()').to_a
+    end
+
+    def test_register_arrow_with_a_list_of_producers
+      producers = [
+        @conn.query('SELECT * FROM source WHERE id = 1'),
+        @conn.query('SELECT * FROM source WHERE id > 100'),
+        @conn.query('SELECT * FROM source WHERE id > 1')
+      ]
+      @conn.register_arrow('arrow_source', producers)
+
+      assert_equal [[1], [2], [3]], @conn.query('SELECT id FROM arrow_source() ORDER BY id').to_a
+    end
+
+    def test_register_arrow_is_visible_from_other_connections
+      @conn.register_arrow('arrow_source', @conn.query('SELECT * FROM source'))
+
+      @db.connect do |other|
+        assert_equal [[6]], other.query('SELECT sum(id) FROM arrow_source()').to_a
+      end
+    end
+
+    def test_register_arrow_raises_type_error_for_non_producer
+      assert_raises(TypeError) { @conn.register_arrow('arrow_source', 'not a producer') }
+    end
+
+    def test_register_arrow_raises_argument_error_for_empty_list
+      assert_raises(ArgumentError) { @conn.register_arrow('arrow_source', []) }
+    end
+
+    def test_register_arrow_raises_on_an_empty_producer
+      producer = @conn.query('SELECT * FROM source WHERE id > 100')
+
+      assert_raises(DuckDB::Error) { @conn.register_arrow('arrow_source', producer) }
+    end
+
+    def test_register_arrow_raises_when_the_producer_cannot_be_scanned_again
+      @conn.register_arrow('arrow_source', @conn.query('SELECT * FROM source'))
+      @conn.query('SELECT * FROM arrow_source()')
+
+      assert_raises(DuckDB::Error) { @conn.query('SELECT * FROM arrow_source()') }
+    end
+  end
+end
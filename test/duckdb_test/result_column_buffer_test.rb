@@ -0,0 +1,83 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class ResultColumnBufferTest < Minitest::Test
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.close
+      @db.close
+    end
+
+    def test_column_buffer
+      buffer = @conn.query('SELECT range::DOUBLE / 2 AS d FROM range(5)').column_buffer(0)
+
+      assert_equal :double, buffer.type
+      assert_equal 5, buffer.size
+      assert_equal Encoding::ASCII_8BIT, buffer.data.encoding
+      assert_equal [0.0, 0.5, 1.0, 1.5, 2.0], buffer.data.unpack('d*')
+      assert_nil buffer.validity
+    end
+
+    def test_column_buffer_with_nulls_across_chunks
+      sql = 'SELECT CASE WHEN range % 1000 = 999 THEN NULL ELSE range END::INTEGER AS i FROM range(5000)'
+      buffer = @conn.query(sql).column_buffer(-1)
+      values = buffer.to_a
+
+      assert_equal 5000, values.size
+      assert_equal (0...5000).map { |i| i % 1000 == 999 ? nil : i }, values
+      refute buffer.valid?(999)
+      assert buffer.valid?(4998)
+      assert_equal 625, buffer.validity.bytesize
+    end
+
+    def test_valid_p_raises_index_error_out_of_range
+      buffer = @conn.query('SELECT NULL::INTEGER UNION ALL SELECT 1').column_buffer(0)
+
+      assert_raises(IndexError) { buffer.valid?(2) }
+      assert_raises(IndexError) { buffer.valid?(-1) }
+    end
+
+    def test_column_buffer_temporal_values
+      sql = "SELECT DATE '1970-01-11' AS d, TIMESTAMP '1970-01-01 00:00:01' AS ts"
+
+      assert_equal [10], @conn.query(sql).column_buffer(0).to_a
+      assert_equal [1_000_000], @conn.query(sql).column_buffer(1).to_a
+    end
+
+    def test_column_buffer_raises_for_variable_width_column
+      assert_raises(DuckDB::Error) { @conn.query("SELECT 'a' AS s").column_buffer(0) }
+    end
+
+    def test_column_buffer_raises_for_invalid_index
+      assert_raises(IndexError) { @conn.query('SELECT 1').column_buffer(1) }
+    end
+
+    def test_each_chunk_buffers
+      sizes = []
+      sum = 0
+      result = @conn.query('SELECT range AS n, range * 2 AS m, NULL::INTEGER AS x FROM range(5000)')
+      result.each_chunk_buffers(1, 2) do |m, x|
+        sizes << m.size
+        sum += m.data.unpack('q*').sum
+
+        assert_equal :bigint, m.type
+        refute x.valid?(0)
+      end
+
+      assert_equal 5000, sizes.sum
+      assert_equal 24_995_000, sum
+    end
+
+    def test_each_chunk_buffers_without_block
+      buffers = @conn.query('SELECT 1 AS a, 2.5::FLOAT AS b').each_chunk_buffers.to_a
+
+      assert_equal [[[1], [2.5]]], buffers.map { |chunk| chunk.map(&:to_a) }
+    end
+  end
+end
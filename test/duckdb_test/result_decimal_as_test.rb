@@ -0,0 +1,58 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class ResultDecimalAsTest < Minitest::Test
+    SQL = 'SELECT 123.45::DECIMAL(18, 2), -0.05::DECIMAL(4, 2), ' \
+          '-12345678901234567890123.1::DECIMAL(38, 1), [1.5::DECIMAL(4, 1)], NULL::DECIMAL(18, 2)'
+
+    def setup
+      @original_decimal_as = DuckDB.decimal_as
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      DuckDB.decimal_as = @original_decimal_as
+      @conn.close
+      @db.close
+    end
+
+    def test_decimal_as_bigdecimal_by_default
+      assert_equal [[BigDecimal('123.45'), BigDecimal('-0.05'), BigDecimal('-12345678901234567890123.1'),
+                     [BigDecimal('1.5')], nil]], @conn.query(SQL).to_a
+    end
+
+    def test_decimal_as_float
+      DuckDB.decimal_as = :float
+
+      assert_equal [[123.45, -0.05, -1.2345678901234568e+22, [1.5], nil]], @conn.query(SQL).to_a
+    end
+
+    def test_decimal_as_rational
+      DuckDB.decimal_as = :rational
+
+      assert_equal [[Rational(12_345, 100), Rational(-5, 100), Rational(-123_456_789_012_345_678_901_231, 10),
+                     [Rational(3, 2)], nil]], @conn.query(SQL).to_a
+    end
+
+    def test_decimal_as_integer_cents
+      DuckDB.decimal_as = :integer_cents
+
+      assert_equal [[12_345, -5, -123_456_789_012_345_678_901_231, [15], nil]], @conn.query(SQL).to_a
+    end
+
+    def test_decimal_as_raises_for_unknown_value
+      assert_raises(ArgumentError) { DuckDB.decimal_as = :string }
+    end
+
+    def test_hugeint_limits
+      sql = 'SELECT 170141183460469231731687303715884105727::HUGEINT, ' \
+            '-170141183460469231731687303715884105727::HUGEINT - 1, -5::HUGEINT, ' \
+            '340282366920938463463374607431768211455::UHUGEINT'
+
+      assert_equal [[(1 << 127) - 1, -(1 << 127), -5, (1 << 128) - 1]], @conn.query(sql).to_a
+    end
+  end
+end
@@ -0,0 +1,49 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class ResultEachHashTest < Minitest::Test
+    SQL = "SELECT 1 AS id, 'Alice' AS name UNION ALL SELECT 2, NULL ORDER BY id"
+
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.close
+      @db.close
+    end
+
+    def test_each_hash
+      rows = []
+      @conn.query(SQL).each_hash { |h| rows << h }
+
+      assert_equal [{ 'id' => 1, 'name' => 'Alice' }, { 'id' => 2, 'name' => nil }], rows
+    end
+
+    def test_each_hash_with_symbolize
+      assert_equal [{ id: 1, name: 'Alice' }, { id: 2, name: nil }], @conn.query(SQL).each_hash(symbolize: true).to_a
+    end
+
+    def test_each_hash_shares_frozen_keys
+      first, second = @conn.query(SQL).each_hash.to_a
+
+      assert_predicate first.keys.first, :frozen?
+      assert_same first.keys.first, second.keys.first
+    end
+
+    def test_to_hashes
+      assert_equal [{ 'id' => 1, 'name' => 'Alice' }, { 'id' => 2, 'name' => nil }], @conn.query(SQL).to_hashes
+      assert_equal [{ id: 1, name: 'Alice' }, { id: 2, name: nil }], @conn.query(SQL).to_hashes(symbolize: true)
+    end
+
+    def test_to_hashes_across_chunks
+      hashes = @conn.query('SELECT i FROM range(5000) t(i) ORDER BY i').to_hashes
+
+      assert_equal 5000, hashes.size
+      assert_equal({ 'i' => 4999 }, hashes.last)
+    end
+  end
+end
@@ -0,0 +1,55 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class ResultEachRowTest < Minitest::Test
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.close
+      @db.close
+    end
+
+    def test_each_row_reads_columns_by_index_and_name
+      values = []
+      @conn.query("SELECT 1 AS id, 'Alice' AS name, [1, 2] AS list").each_row do |row|
+        values << [row[0], row[-1], row['name'], row[:id], row[3], row[:missing]]
+      end
+
+      assert_equal [[1, [1, 2], 'Alice', 1, nil, nil]], values
+    end
+
+    def test_each_row_to_a_and_to_h
+      row = @conn.query("SELECT 1 AS id, 'Alice' AS name").each_row.first
+
+      assert_equal [1, 'Alice'], row.to_a
+      assert_equal({ 'id' => 1, 'name' => 'Alice' }, row.to_h)
+      assert_equal %w[id name], row.columns
+      assert_equal 2, row.size
+    end
+
+    def test_each_row_keeps_rows_valid_after_iteration
+      rows = @conn.query("SELECT i, 'v' || i FROM range(5000) t(i) ORDER BY i").each_row.to_a
+      GC.start
+
+      assert_equal 5000, rows.size
+      assert_equal [0, 'v0'], rows.first.to_a
+      assert_equal [2048, 'v2048'], rows[2048].to_a
+      assert_equal [4999, 'v4999'], rows.last.to_a
+    end
+
+    def test_each_row_without_block_is_enumerator
+      assert_instance_of Enumerator, @conn.query('SELECT 1').each_row
+    end
+
+    def test_row_is_enumerable
+      row = @conn.query('SELECT 1, 2, 3').each_row.first
+
+      assert_equal [2, 4, 6], row.map { |v| v * 2 }
+    end
+  end
+end
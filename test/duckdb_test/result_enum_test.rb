@@ -0,0 +1,58 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class ResultEnumTest < Minitest::Test
+    def setup
+      @original_enum_as = DuckDB.enum_as
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+      @conn.query("CREATE TYPE mood AS ENUM ('sad', 'ok', 'happy')")
+    end
+
+    def teardown
+      DuckDB.enum_as = @original_enum_as
+      @conn.close
+      @db.close
+    end
+
+    def test_enum_values_are_shared_frozen_strings
+      rows = @conn.query("SELECT m::mood FROM (VALUES ('sad'), ('ok'), (NULL), ('sad')) t(m)").to_a
+
+      assert_equal [['sad'], ['ok'], [nil], ['sad']], rows
+      assert_predicate rows[0][0], :frozen?
+      assert_same rows[0][0], rows[3][0]
+    end
+
+    def test_enum_values_as_symbols
+      DuckDB.enum_as = :symbol
+
+      assert_equal [[:happy, nil]], @conn.query("SELECT 'happy'::mood, NULL::mood").to_a
+    end
+
+    def test_nested_enum_values
+      DuckDB.enum_as = :symbol
+
+      assert_equal [[[:sad, nil], { m: :ok }]], @conn.query("SELECT ['sad'::mood, NULL], {m: 'ok'::mood}").to_a
+    end
+
+    def test_enum_with_usmallint_internal_type
+      values = (0...300).map { |i| "'v#{i}'" }.join(', ')
+      @conn.query("CREATE TYPE wide AS ENUM (#{values})")
+
+      assert_equal [%w[v299 v7]], @conn.query("SELECT 'v299'::wide, 'v7'::wide").to_a
+    end
+
+    def test_enum_with_uinteger_internal_type
+      values = (0...70_000).map { |i| "'v#{i}'" }.join(', ')
+      @conn.query("CREATE TYPE huge AS ENUM (#{values})")
+
+      assert_equal [['v69999', ['v65536']]], @conn.query("SELECT 'v69999'::huge, ['v65536'::huge]").to_a
+    end
+
+    def test_enum_as_raises_for_unknown_value
+      assert_raises(ArgumentError) { DuckDB.enum_as = :integer }
+    end
+  end
+end
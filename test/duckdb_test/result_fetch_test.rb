@@ -0,0 +1,134 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class ResultFetchTest < Minitest::Test
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.close
+      @db.close
+    end
+
+    def test_fetch
+      result = @conn.query("SELECT range AS id, 'name' || range AS name FROM range(3)")
+
+      assert_equal [[0, 'name0'], [1, 'name1']], result.fetch(2)
+      assert_equal [[2, 'name2']], result.fetch(2)
+      assert_empty result.fetch(2)
+    end
+
+    def test_fetch_across_chunks
+      result = @conn.query('SELECT range FROM range(5000)')
+      pages = []
+      until (page = result.fetch(1000)).empty?
+        pages << page
+      end
+
+      assert_equal [1000] * 5, pages.map(&:size)
+      assert_equal (0...5000).to_a, pages.flatten
+    end
+
+    def test_fetch_zero_and_negative_count
+      result = @conn.query('SELECT 1')
+
+      assert_empty result.fetch(0)
+      assert_raises(ArgumentError) { result.fetch(-1) }
+      assert_equal [[1]], result.fetch(1)
+    end
+
+    def test_fetch_chunk
+      result = @conn.query('SELECT range FROM range(3000)')
+
+      assert_equal [[0], [1]], result.fetch(2)
+      rest_of_first_chunk = result.fetch_chunk
+
+      assert_equal [2], rest_of_first_chunk.first
+      sizes = [rest_of_first_chunk.size]
+      while (rows = result.fetch_chunk)
+        sizes << rows.size
+      end
+
+      assert_equal 2998, sizes.sum
+      assert_nil result.fetch_chunk
+    end
+
+    def test_each_continues_after_fetch
+      result = @conn.query('SELECT range FROM range(5)')
+      result.fetch(2)
+
+      assert_equal [[2], [3], [4]], result.to_a
+    end
+
+    def test_each_row_continues_after_fetch
+      result = @conn.query('SELECT range FROM range(5)')
+      result.fetch(4)
+
+      assert_equal [[4]], result.each_row.map(&:to_a)
+    end
+
+    def test_write_csv_and_write_json_continue_after_fetch
+      csv = +''
+      result = @conn.query('SELECT range AS n FROM range(5)')
+      result.fetch(2)
+      result.write_csv(csv)
+      json = @conn.query('SELECT range AS n FROM range(5)')
+      json.fetch(4)
+
+      assert_equal "n\n2\n3\n4\n", csv
+      assert_equal '[{"n":4}]', json.to_json_string
+    end
+
+    def test_column_buffer_continues_after_fetch
+      result = @conn.query('SELECT CASE WHEN range % 3 = 0 THEN NULL ELSE range END FROM range(3000)')
+      result.fetch(5)
+      expected = (5...3000).map { |i| (i % 3).zero? ? nil : i }
+
+      assert_equal expected, result.column_buffer(0).to_a
+    end
+
+    def test_each_chunk_buffers_continues_after_fetch
+      result = @conn.query('SELECT range FROM range(5)')
+      result.fetch(2)
+
+      assert_equal [[2, 3, 4]], result.each_chunk_buffers.map { |(buffer)| buffer.to_a }
+    end
+
+    def test_arrow_c_stream_raises_after_partial_fetch
+      result = @conn.query('SELECT range FROM range(5)')
+      result.fetch(2)
+
+      assert_raises(DuckDB::Error) { result.arrow_c_stream }
+    end
+
+    def test_fetch_with_streaming_result
+      pending_result = @conn.async_query('SELECT range FROM range(10000)')
+      pending_result.execute_task while pending_result.state == :not_ready
+      result = pending_result.execute_pending
+
+      assert_equal [[0], [1], [2]], result.fetch(3)
+      assert_equal [[3]], result.fetch(1)
+      assert_equal 9996, result.to_a.size
+    end
+
+    def test_rewind_p
+      result = @conn.query('SELECT range FROM range(5)')
+
+      assert_predicate result, :rewind?
+      result.fetch(1)
+
+      refute_predicate result, :rewind?
+    end
+
+    def test_rewind_p_after_each
+      result = @conn.query('SELECT 1')
+      result.each { |row| row }
+
+      refute_predicate result, :rewind?
+    end
+  end
+end
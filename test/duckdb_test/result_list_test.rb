@@ -67,5 +67,14 @@ def test_result_list_of_multiple_list_columns
       assert_equal([1, 2], ary.first[0])
       assert_equal([[3, 4]], ary.first[1])
     end
+
+    def test_result_list_of_struct_across_chunks
+      @conn.execute("CREATE TABLE test AS SELECT [{id: i, tags: ['t' || i, NULL]}, NULL] AS value FROM range(3000) t(i);")
+      result = @conn.execute('SELECT value FROM test ORDER BY value[1].id;')
+      ary = result.each.to_a
+
+      assert_equal(3000, ary.size)
+      assert_equal([[{ id: 2999, tags: ['t2999', nil] }, nil]], ary.last)
+    end
   end
 end
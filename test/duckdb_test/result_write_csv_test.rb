@@ -0,0 +1,92 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+require 'csv'
+require 'stringio'
+
+module DuckDBTest
+  class ResultWriteCsvTest < Minitest::Test
+    SQL = "SELECT 1 AS id, 'Alice' AS name UNION ALL SELECT 2, NULL ORDER BY id"
+
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.close
+      @db.close
+    end
+
+    def test_write_csv
+      csv = +''
+
+      assert_equal 2, @conn.query(SQL).write_csv(csv)
+      assert_equal "id,name\n1,Alice\n2,\n", csv
+    end
+
+    def test_write_csv_without_header
+      csv = +''
+      @conn.query(SQL).write_csv(csv, header: false)
+
+      assert_equal "1,Alice\n2,\n", csv
+    end
+
+    def test_write_csv_with_delimiter_and_null
+      csv = +''
+      @conn.query(SQL).write_csv(csv, delimiter: "\t", null: '\\N')
+
+      assert_equal "id\tname\n1\tAlice\n2\t\\N\n", csv
+    end
+
+    def test_write_csv_quotes_fields
+      sql = <<~SQL
+        SELECT * FROM (VALUES ('a,b'), ('say "hi"'), ('two' || chr(10) || 'lines'), (''), (NULL)) t(s)
+      SQL
+      io = StringIO.new
+      @conn.query(sql).write_csv(io)
+
+      assert_equal "s\n\"a,b\"\n\"say \"\"hi\"\"\"\n\"two\nlines\"\n\"\"\n\n", io.string
+      assert_equal [['a,b'], ['say "hi"'], ["two\nlines"], [''], [nil]], CSV.parse(io.string, headers: true).map(&:fields)
+    end
+
+    def test_write_csv_values_as_duckdb_text
+      sql = <<~SQL
+        SELECT -0.05::DECIMAL(5, 2) AS d, 1.5::DOUBLE AS f, true AS b, DATE '2024-01-02' AS dt,
+               TIMESTAMP '2024-01-02 03:04:05.5' AS ts, [1, 2] AS l, {'x': 'y'} AS s
+      SQL
+      csv = +''
+      @conn.query(sql).write_csv(csv, header: false)
+
+      assert_equal "-0.05,1.5,true,2024-01-02,2024-01-02 03:04:05.5,\"[1,2]\",\"{\"\"x\"\":\"\"y\"\"}\"\n", csv
+    end
+
+    def test_write_csv_with_streaming_result
+      io = StringIO.new
+      pending_result = @conn.async_query('SELECT range AS n FROM range(100000)')
+      pending_result.execute_task while pending_result.state == :not_ready
+      rows = pending_result.execute_pending.write_csv(io)
+
+      assert_equal 100_000, rows
+      lines = io.string.lines
+
+      assert_equal 100_001, lines.size
+      assert_equal "99999\n", lines.last
+    end
+
+    def test_write_csv_raises_error_for_unsupported_nested_column_type
+      result = @conn.query('SELECT [1::VARIANT] AS v')
+    rescue DuckDB::Error
+      skip 'VARIANT is not supported by this DuckDB version'
+    else
+      assert_raises(DuckDB::Error) { result.write_csv(+'') }
+    end
+
+    def test_write_csv_raises_argument_error_for_invalid_delimiter
+      assert_raises(ArgumentError) { @conn.query(SQL).write_csv(+'', delimiter: '') }
+      assert_raises(ArgumentError) { @conn.query(SQL).write_csv(+'', delimiter: '"') }
+      assert_raises(ArgumentError) { @conn.query(SQL).write_csv(+'', delimiter: ';;') }
+      assert_raises(ArgumentError) { @conn.query(SQL).write_csv(+'', delimiter: 1) }
+    end
+  end
+end
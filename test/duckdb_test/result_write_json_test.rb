@@ -0,0 +1,128 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+require 'json'
+require 'stringio'
+
+module DuckDBTest
+  class ResultWriteJsonTest < Minitest::Test
+    SQL = "SELECT 1 AS id, 'Alice' AS name UNION ALL SELECT 2, NULL ORDER BY id"
+
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.close
+      @db.close
+    end
+
+    def test_to_json_string_records
+      assert_equal '[{"id":1,"name":"Alice"},{"id":2,"name":null}]', @conn.query(SQL).to_json_string
+    end
+
+    def test_to_json_string_columns
+      assert_equal '{"id":[1,2],"name":["Alice",null]}', @conn.query(SQL).to_json_string(format: :columns)
+    end
+
+    def test_to_json_string_ndjson
+      assert_equal "{\"id\":1,\"name\":\"Alice\"}\n{\"id\":2,\"name\":null}\n",
+                   @conn.query(SQL).to_json_string(format: :ndjson)
+    end
+
+    def test_to_json_string_empty_result
+      sql = 'SELECT range AS n FROM range(0)'
+
+      assert_equal '[]', @conn.query(sql).to_json_string
+      assert_equal '{"n":[]}', @conn.query(sql).to_json_string(format: :columns)
+      assert_equal '', @conn.query(sql).to_json_string(format: :ndjson)
+    end
+
+    def test_json_generate_does_not_drain_a_nested_result
+      result = @conn.query(SQL)
+      JSON.generate({ result: result })
+
+      assert_equal 2, result.to_a.size
+    end
+
+    def test_write_json_to_io
+      io = StringIO.new
+
+      assert_equal 2, @conn.query(SQL).write_json(io, format: :ndjson)
+      assert_equal [{ 'id' => 1, 'name' => 'Alice' }, { 'id' => 2, 'name' => nil }],
+                   io.string.lines.map { |line| JSON.parse(line) }
+    end
+
+    def test_write_json_with_many_chunks
+      io = StringIO.new
+      rows = @conn.query("SELECT range AS n, repeat('x', 20) AS s FROM range(100000)").write_json(io)
+
+      assert_equal 100_000, rows
+      parsed = JSON.parse(io.string)
+
+      assert_equal 100_000, parsed.size
+      assert_equal({ 'n' => 99_999, 's' => 'x' * 20 }, parsed.last)
+    end
+
+    def test_write_json_escapes_strings
+      json = @conn.query("SELECT 'a\"b\\c' || chr(10) || chr(1) || 'é' AS \"k\"\"ey\"").to_json_string
+
+      assert_equal [{ "k\"ey" => "a\"b\\c\n\u0001é" }], JSON.parse(json)
+    end
+
+    def test_write_json_numbers
+      sql = <<~SQL
+        SELECT 170141183460469231731687303715884105727::HUGEINT AS h,
+               340282366920938463463374607431768211455::UHUGEINT AS u,
+               -0.05::DECIMAL(5, 2) AS d, 0.1::DOUBLE AS f, 'nan'::DOUBLE AS nan, true AS b
+      SQL
+
+      assert_equal '[{"h":170141183460469231731687303715884105727,"u":340282366920938463463374607431768211455,' \
+                   '"d":-0.05,"f":0.1,"nan":null,"b":true}]', @conn.query(sql).to_json_string
+    end
+
+    def test_write_json_temporal_values_as_duckdb_text
+      sql = <<~SQL
+        SELECT DATE '2024-01-02' AS d, TIME '12:34:56.789' AS t, TIMESTAMP '2024-01-02 03:04:05.5' AS ts,
+               TIMESTAMP_NS '2024-01-02 03:04:05.123456789' AS ns, INTERVAL '1 year 3 days 04:05:06' AS i,
+               '550e8400-e29b-41d4-a716-446655440000'::UUID AS u
+      SQL
+      expected = {
+        'd' => '2024-01-02', 't' => '12:34:56.789', 'ts' => '2024-01-02 03:04:05.5',
+        'ns' => '2024-01-02 03:04:05.123456789', 'i' => '1 year 3 days 04:05:06',
+        'u' => '550e8400-e29b-41d4-a716-446655440000'
+      }
+
+      assert_equal [expected], JSON.parse(@conn.query(sql).to_json_string)
+    end
+
+    def test_write_json_nested_values
+      sql = <<~SQL
+        SELECT [1, NULL, 3] AS l, {'x': 1, 'y': ['p']} AS s, MAP {1: 'a', 2: NULL} AS m,
+               [1, 2]::INTEGER[2] AS a, union_value(n := 5)::UNION(s VARCHAR, n INTEGER) AS un
+      SQL
+
+      assert_equal '[{"l":[1,null,3],"s":{"x":1,"y":["p"]},"m":{"1":"a","2":null},"a":[1,2],"un":5}]',
+                   @conn.query(sql).to_json_string
+    end
+
+    def test_write_json_enum
+      @conn.query("CREATE TYPE mood AS ENUM ('sad', 'happy')")
+
+      assert_equal '[{"m":"happy"}]', @conn.query("SELECT 'happy'::mood AS m").to_json_string
+    end
+
+    def test_write_json_raises_error_for_unsupported_column_type
+      result = @conn.query('SELECT 1::VARIANT AS v')
+    rescue DuckDB::Error
+      skip 'VARIANT is not supported by this DuckDB version'
+    else
+      assert_raises(DuckDB::Error) { result.write_json(+'') }
+    end
+
+    def test_write_json_raises_argument_error_for_unknown_format
+      assert_raises(ArgumentError) { @conn.query(SQL).write_json(+'', format: :xml) }
+    end
+  end
+end
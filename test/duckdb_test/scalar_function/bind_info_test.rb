@@ -205,6 +205,67 @@ def test_get_argument_raises_for_out_of_range_index
       assert_raises(DuckDB::Error) { @conn.execute('SELECT test_get_arg_oob(1)') }
     end
 
+    # --- specialization: a Proc returned by the bind block runs for that call site ---
+
+    # the returned Proc replaces the block, so work done at bind time is not repeated per row
+    def test_bind_block_returning_proc_specializes_the_call_site
+      compiled = 0
+
+      sf = regexp_match_function('test_bind_specialized_match') do |bind_info|
+        pattern = bind_info.get_argument(1)
+        next unless pattern.foldable?
+
+        compiled += 1
+        regexp = Regexp.new(pattern.fold(bind_info.client_context))
+        ->(str, _pattern) { regexp.match?(str) }
+      end
+      @conn.register_scalar_function(sf)
+
+      result = @conn.execute(<<~SQL)
+        SELECT count(*) FROM range(10000) t(i) WHERE test_bind_specialized_match('item' || i::VARCHAR, '^item9+$')
+      SQL
+
+      assert_equal [[4]], result.to_a
+      assert_equal 1, compiled
+    end
+
+    # each call site binds and specializes separately
+    def test_bind_specializations_are_per_call_site
+      sf = regexp_match_function('test_bind_per_call_site') do |bind_info|
+        regexp = Regexp.new(bind_info.get_argument(1).fold(bind_info.client_context))
+        ->(str, _pattern) { regexp.match?(str) }
+      end
+      @conn.register_scalar_function(sf)
+
+      result = @conn.execute(<<~SQL)
+        SELECT test_bind_per_call_site(s, '^a'), test_bind_per_call_site(s, 'b$') FROM (VALUES ('ab'), ('ba')) t(s)
+      SQL
+
+      assert_equal [[true, true], [false, false]], result.to_a
+    end
+
+    # without a Proc from the bind block (e.g. a column pattern), the block runs
+    def test_bind_block_without_proc_falls_back_to_the_block
+      sf = regexp_match_function('test_bind_fallback') do |bind_info|
+        next unless bind_info.get_argument(1).foldable?
+
+        ->(_str, _pattern) { raise 'specialized for a constant pattern' }
+      end
+      @conn.register_scalar_function(sf)
+
+      result = @conn.execute("SELECT test_bind_fallback(s, p) FROM (VALUES ('abc', 'b'), ('abc', 'x')) t(s, p)")
+
+      assert_equal [[true], [false]], result.to_a
+    end
+
+    # a Method object is accepted as well
+    def test_bind_block_returning_method_specializes_the_call_site
+      sf = regexp_match_function('test_bind_method') { |_bind_info| 'always'.method(:start_with?) }
+      @conn.register_scalar_function(sf)
+
+      assert_equal [[true]], @conn.execute("SELECT test_bind_method('x', 'al')").to_a
+    end
+
     # --- future: requires duckdb_scalar_function_set_bind_data / get_bind_data ---
 
     # set_bind_data stores data that can be retrieved during execute
@@ -229,5 +290,18 @@ def test_client_context_returns_client_context_object
 
       assert_instance_of DuckDB::ClientContext, received
     end
+
+    private
+
+    def regexp_match_function(name, &bind)
+      sf = DuckDB::ScalarFunction.new
+      sf.name = name
+      sf.return_type = :boolean
+      sf.add_parameter(:varchar)
+      sf.add_parameter(:varchar)
+      sf.set_bind(&bind)
+      sf.set_function { |str, pattern| Regexp.new(pattern).match?(str) }
+      sf
+    end
   end
 end
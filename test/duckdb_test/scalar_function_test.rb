@@ -762,6 +762,90 @@ def test_scalar_function_runs_on_per_worker_proxy_threads
                       'expected callbacks on per-worker proxy threads, not just caller + global executor'
     end
 
+    def test_set_init_passes_state_to_every_call
+      skip 'set_init requires DuckDB >= 1.5.0' if ::DuckDBTest.duckdb_library_version < Gem::Version.new('1.5.0')
+
+      contexts = []
+      sf = DuckDB::ScalarFunction.new
+      sf.name = 'running_count'
+      sf.add_parameter(:integer)
+      sf.return_type = :bigint
+      sf.set_init do |client_context|
+        contexts << client_context
+        { calls: 0 }
+      end
+      sf.set_function { |state, v| v + (state[:calls] += 1) }
+
+      @con.register_scalar_function(sf)
+      result = @con.execute('SELECT running_count(i::INTEGER) FROM range(3) t(i)')
+
+      assert_equal [[1], [3], [5]], result.to_a
+      assert_equal 1, contexts.size
+      assert_instance_of DuckDB::ClientContext, contexts.first
+    end
+
+    def test_set_init_state_with_no_parameters
+      skip 'set_init requires DuckDB >= 1.5.0' if ::DuckDBTest.duckdb_library_version < Gem::Version.new('1.5.0')
+
+      sf = DuckDB::ScalarFunction.new
+      sf.name = 'next_id'
+      sf.return_type = :bigint
+      sf.set_init { |_client_context| [0] }
+      sf.set_function { |counter| counter[0] += 1 }
+
+      @con.register_scalar_function(sf)
+
+      assert_equal [[1], [2]], @con.execute('SELECT next_id() FROM range(2)').to_a
+    end
+
+    def test_set_init_state_is_per_thread
+      skip 'set_init requires DuckDB >= 1.5.0' if ::DuckDBTest.duckdb_library_version < Gem::Version.new('1.5.0')
+
+      @con.execute('SET threads=4')
+      @con.execute('CREATE TABLE large_parallel AS SELECT range::INTEGER AS value FROM range(500000)')
+
+      users = Hash.new { |h, k| h[k] = {} }
+      mutex = Mutex.new
+      sf = DuckDB::ScalarFunction.new
+      sf.name = 'tagged_triple'
+      sf.add_parameter(:integer)
+      sf.return_type = :bigint
+      sf.set_init { |_client_context| Object.new }
+      sf.set_function do |state, v|
+        mutex.synchronize { users[state][Thread.current] = true }
+        v * 3
+      end
+
+      @con.register_scalar_function(sf)
+      result = @con.execute('SELECT SUM(tagged_triple(value)) FROM large_parallel')
+
+      assert_equal 499_999 * 500_000 / 2 * 3, result.first.first
+      assert_operator users.size, :>, 1
+      assert(users.values.all? { |threads| threads.size == 1 }, 'expected each state to be used by one thread')
+    end
+
+    def test_set_init_error_is_reported
+      skip 'set_init requires DuckDB >= 1.5.0' if ::DuckDBTest.duckdb_library_version < Gem::Version.new('1.5.0')
+
+      sf = DuckDB::ScalarFunction.new
+      sf.name = 'broken_init'
+      sf.add_parameter(:integer)
+      sf.return_type = :integer
+      sf.set_init { |_client_context| raise 'no state for you' }
+      sf.set_function { |_state, v| v }
+
+      @con.register_scalar_function(sf)
+
+      error = assert_raises(DuckDB::Error) { @con.execute('SELECT broken_init(1)') }
+      assert_match(/no state for you/, error.message)
+    end
+
+    def test_set_init_without_block_raises_error
+      skip 'set_init requires DuckDB >= 1.5.0' if ::DuckDBTest.duckdb_library_version < Gem::Version.new('1.5.0')
+
+      assert_raises(ArgumentError) { DuckDB::ScalarFunction.new.set_init }
+    end
+
     def test_scalar_function_with_symbol_return_type_and_params
       @con.execute('CREATE TABLE large_test AS SELECT range::INTEGER AS value FROM range(10000)')
 
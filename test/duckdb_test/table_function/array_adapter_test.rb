@@ -0,0 +1,113 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  module TableFunction
+    class ArrayAdapterTest < Minitest::Test
+      User = Struct.new(:id, :name)
+      Score = Data.define(:id, :score)
+
+      def setup
+        @db = DuckDB::Database.open
+        @conn = @db.connect
+      end
+
+      def teardown
+        @conn.disconnect
+        @db.close
+      end
+
+      def test_array_adapter_is_registered_for_array
+        assert_instance_of DuckDB::TableFunction::ArrayAdapter, DuckDB::TableFunction.table_adapter_for(Array)
+      end
+
+      def test_expose_array_of_arrays
+        @conn.expose_as_table([[1, 'a', 1.5, true], [2, nil, 2, false]], 'rows')
+
+        assert_equal [[1, 'a', 1.5, true], [2, nil, 2.0, false]], @conn.query('SELECT * FROM rows()').to_a
+        assert_equal [%w[column0 BIGINT], %w[column1 VARCHAR], %w[column2 DOUBLE], %w[column3 BOOLEAN]],
+                     column_types('rows')
+      end
+
+      def test_expose_array_of_hashes
+        @conn.expose_as_table([{ id: 1, name: 'Alice' }, { id: 2, born: Date.new(2000, 1, 2) }], 'users')
+
+        assert_equal [[1, 'Alice', nil], [2, nil, Date.new(2000, 1, 2)]], @conn.query('SELECT * FROM users()').to_a
+        assert_equal [%w[id BIGINT], %w[name VARCHAR], %w[born DATE]], column_types('users')
+      end
+
+      def test_expose_array_of_structs_and_data
+        @conn.expose_as_table([User.new(1, 'Alice'), User.new(2, 'Bob')], 'users')
+        @conn.expose_as_table([Score.new(id: 2, score: 9.5)], 'scores')
+
+        assert_equal [['Bob', 9.5]], @conn.query('SELECT name, score FROM users() JOIN scores() USING (id)').to_a
+      end
+
+      def test_expose_with_columns
+        rows = [{ 'id' => 1, 'name' => 'Alice' }]
+        @conn.expose_as_table(rows, 'users', columns: { 'name' => :varchar, 'id' => :integer })
+
+        assert_equal [['Alice', 1]], @conn.query('SELECT * FROM users()').to_a
+        assert_equal [%w[name VARCHAR], %w[id INTEGER]], column_types('users')
+      end
+
+      def test_expose_reads_rows_added_later
+        rows = [[1]]
+        @conn.expose_as_table(rows, 'numbers')
+        rows << [2]
+
+        assert_equal [[2]], @conn.query('SELECT count(*) FROM numbers()').to_a
+      end
+
+      def test_expose_many_rows
+        rows = Array.new(10_000) { |i| { id: i, name: "n#{i}" } }
+        @conn.expose_as_table(rows, 'many')
+
+        assert_equal [[10_000, 49_995_000]], @conn.query('SELECT count(*), sum(id) FROM many()').to_a
+      end
+
+      def test_expose_infers_hugeint_and_varchar_columns
+        @conn.expose_as_table([[2**70, :sym], [1, 'text']], 'mixed')
+
+        assert_equal [%w[column0 HUGEINT], %w[column1 VARCHAR]], column_types('mixed')
+        assert_equal [[2**70, 'sym'], [1, 'text']], @conn.query('SELECT * FROM mixed()').to_a
+      end
+
+      def test_expose_empty_array_requires_columns
+        assert_raises(ArgumentError) { @conn.expose_as_table([], 'empty') }
+
+        @conn.expose_as_table([], 'empty', columns: { 'id' => :integer })
+
+        assert_equal [[0]], @conn.query('SELECT count(*) FROM empty()').to_a
+      end
+
+      def test_expose_passes_the_row_count_to_the_optimizer
+        rows = Array.new(3000) { |i| [i] }
+        @conn.expose_as_table(rows, 'numbers')
+
+        assert_match(/~3,000 rows/, explain('SELECT * FROM numbers()'))
+
+        rows.concat(rows)
+
+        assert_match(/~6,000 rows/, explain('SELECT * FROM numbers()'))
+      end
+
+      def test_expose_with_cardinality_overrides_the_row_count
+        @conn.expose_as_table([[1]], 'one', cardinality: 50_000)
+
+        assert_match(/~50,000 rows/, explain('SELECT * FROM one()'))
+      end
+
+      private
+
+      def explain(sql)
+        @conn.query("EXPLAIN #{sql}").to_a.map(&:last).join
+      end
+
+      def column_types(name)
+        @conn.query("DESCRIBE SELECT * FROM #{name}()").to_a.map { |row| row[0, 2] }
+      end
+    end
+  end
+end
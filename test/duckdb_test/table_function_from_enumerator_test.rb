@@ -0,0 +1,135 @@
+# frozen_string_literal: true
+
+require 'test_helper'
+
+module DuckDBTest
+  class TableFunctionFromEnumeratorTest < Minitest::Test
+    def setup
+      @db = DuckDB::Database.open
+      @conn = @db.connect
+    end
+
+    def teardown
+      @conn.disconnect
+      @db.close
+    end
+
+    def test_from_enumerator
+      tf = DuckDB::TableFunction.from_enumerator('people', columns: { 'id' => :integer, 'name' => :varchar }) do
+        [[1, 'Alice'], [2, nil]].each
+      end
+      @conn.register_table_function(tf)
+
+      assert_equal [[1, 'Alice'], [2, nil]], @conn.query('SELECT * FROM people()').to_a
+    end
+
+    def test_from_enumerator_streams_many_chunks_in_order
+      columns = { 'n' => :bigint }
+      tf = DuckDB::TableFunction.from_enumerator('numbers', columns:, parameters: [:bigint]) do |(count)|
+        (1..count).lazy.map { |n| [n] }
+      end
+      @conn.register_table_function(tf)
+
+      assert_equal [[10_000, 50_005_000, true]],
+                   @conn.query('SELECT count(*), sum(n), bool_and(n = rn) FROM ' \
+                               '(SELECT n, row_number() OVER () AS rn FROM numbers(10000))').to_a
+    end
+
+    def test_from_enumerator_with_named_parameters
+      columns = { 'text' => :varchar }
+      parameters = { 'text' => :varchar, 'times' => :integer }
+      tf = DuckDB::TableFunction.from_enumerator('repeat_text', columns:, parameters:) do |params|
+        Array.new(params['times'] || 1) { [params['text']] }
+      end
+      @conn.register_table_function(tf)
+
+      assert_equal [['a'], ['a']], @conn.query("SELECT * FROM repeat_text(text := 'a', times := 2)").to_a
+    end
+
+    def test_from_enumerator_pulls_only_the_rows_a_limit_needs
+      pulled = 0
+      tf = DuckDB::TableFunction.from_enumerator('naturals', columns: { 'n' => :bigint }) do
+        Enumerator.produce(0) { |n| n + 1 }.lazy.map do |n|
+          pulled += 1
+          [n]
+        end
+      end
+      @conn.register_table_function(tf)
+
+      assert_equal [[0], [1], [2]], @conn.query('SELECT n FROM naturals() LIMIT 3').to_a
+      assert_operator pulled, :<=, DuckDB.vector_size * 2
+    end
+
+    def test_from_enumerator_closes_the_source_a_limit_stops
+      closed = false
+      tf = DuckDB::TableFunction.from_enumerator('endless', columns: { 'n' => :bigint }) do
+        Enumerator.new do |y|
+          n = 0
+          loop { y << [n += 1] }
+        ensure
+          closed = true
+        end
+      end
+      @conn.register_table_function(tf)
+
+      assert_equal [[1], [2]], @conn.query('SELECT n FROM endless() LIMIT 2').to_a
+      assert closed
+    end
+
+    def test_from_enumerator_closes_the_source_a_limit_stops_on_many_threads
+      closed = 0
+      tf = DuckDB::TableFunction.from_enumerator('endless', columns: { 'n' => :bigint }) do
+        Enumerator.new do |y|
+          n = 0
+          loop { y << [n += 1] }
+        ensure
+          closed += 1
+        end
+      end
+      @conn.register_table_function(tf)
+      @conn.execute('SET threads=4')
+
+      _out, err = capture_io { 20.times { @conn.query('SELECT n FROM endless() LIMIT 2').to_a } }
+
+      assert_equal 20, closed
+      assert_empty err
+    end
+
+    def test_from_enumerator_starts_over_for_each_query
+      tf = DuckDB::TableFunction.from_enumerator('letters', columns: { 'c' => :varchar }) { %w[a b].map { |c| [c] } }
+      @conn.register_table_function(tf)
+
+      assert_equal [['a'], ['b']], @conn.query('SELECT * FROM letters()').to_a
+      assert_equal [[4]], @conn.query('SELECT count(*) FROM letters() x, letters() y').to_a
+    end
+
+    def test_from_enumerator_propagates_errors
+      tf = DuckDB::TableFunction.from_enumerator('broken', columns: { 'n' => :integer }) do
+        Enumerator.new do |y|
+          y << [1]
+          raise 'source failed'
+        end
+      end
+      @conn.register_table_function(tf)
+
+      error = assert_raises(DuckDB::Error) { @conn.query('SELECT * FROM broken()') }
+      assert_match(/source failed/, error.message)
+    end
+
+    def test_from_enumerator_with_cardinality
+      cardinality = ->(bind_info) { bind_info.get_parameter(0) }
+      tf = DuckDB::TableFunction.from_enumerator('counted', columns: { 'n' => :bigint }, parameters: [:bigint],
+                                                            cardinality:) do |(count)|
+        (1..count).lazy.map { |n| [n] }
+      end
+      @conn.register_table_function(tf)
+
+      assert_match(/~7,000 rows/, @conn.query('EXPLAIN SELECT * FROM counted(7000)').to_a.map(&:last).join)
+      assert_equal [[7000]], @conn.query('SELECT count(*) FROM counted(7000)').to_a
+    end
+
+    def test_from_enumerator_requires_a_block
+      assert_raises(ArgumentError) { DuckDB::TableFunction.from_enumerator('x', columns: { 'n' => :integer }) }
+    end
+  end
+end
@@ -115,6 +115,43 @@ def test_execute_callback_multi_chunk_under_multi_thread_setting
       assert_operator execute_calls, :>, 1, 'expected execute to be invoked across multiple chunks'
     end
 
+    # Requires per-worker local init data (DuckDB >= 1.5.0 or a local_init block).
+    def test_execute_callback_reuses_wrappers_across_chunks
+      if ::DuckDBTest.duckdb_library_version < Gem::Version.new('1.5.0')
+        skip 'execute wrappers are cached in local init data on DuckDB >= 1.5.0'
+      end
+
+      outputs = []
+      infos = []
+      emitted = 0
+
+      tf = DuckDB::TableFunction.new
+      tf.name = 'reused_wrappers_function'
+      tf.bind do |bind_info|
+        bind_info.add_result_column('n', DuckDB::LogicalType::BIGINT)
+        bind_info.add_result_column('s', DuckDB::LogicalType::VARCHAR)
+      end
+      tf.init { |_init_info| emitted = 0 }
+      tf.execute do |func_info, output|
+        outputs << output
+        infos << func_info
+        batch = [5000 - emitted, 2048].min
+        batch.times do |i|
+          output.set_value(0, i, emitted + i)
+          output.set_value(1, i, (emitted + i).to_s)
+        end
+        output.size = batch
+        emitted += batch
+      end
+
+      @connection.register_table_function(tf)
+      result = @connection.query('SELECT COUNT(*), SUM(n), SUM(s::BIGINT) FROM reused_wrappers_function()').to_a
+
+      assert_equal [[5000, (0...5000).sum, (0...5000).sum]], result
+      assert_equal 1, outputs.uniq(&:object_id).size
+      assert_equal 1, infos.uniq(&:object_id).size
+    end
+
     private
 
     def set_multi_thread
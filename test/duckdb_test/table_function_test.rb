@@ -264,8 +264,190 @@ def test_execute_runs_on_per_worker_proxy_threads
       db.close
     end
 
+    def test_partitions_are_claimed_once_across_threads # rubocop:disable Minitest/MultipleAssertions
+      db = DuckDB::Database.open
+      conn = db.connect
+      conn.execute('SET threads=4')
+      claimed = []
+
+      tf = DuckDB::TableFunction.create(
+        name: 'partitioned',
+        columns: { 'part' => DuckDB::LogicalType::BIGINT, 'n' => DuckDB::LogicalType::BIGINT },
+        partitions: (0...16).to_a,
+        local_init: ->(_init_info) { { part: nil, next_row: 0 } }
+      ) do |func_info, output|
+        state = func_info.local_state
+        if state[:part].nil?
+          state[:part] = func_info.next_partition
+          claimed << state[:part] unless state[:part].nil?
+        end
+        next 0 if state[:part].nil?
+
+        rows = [1000 - state[:next_row], 500].min
+        rows.times do |i|
+          output.set_value(0, i, state[:part])
+          output.set_value(1, i, state[:next_row] + i)
+        end
+        state[:next_row] += rows
+        state.update(part: nil, next_row: 0) if state[:next_row] == 1000
+        rows
+      end
+
+      conn.register_table_function(tf)
+      result = conn.query('SELECT count(*), count(DISTINCT part), sum(n) FROM partitioned()').to_a
+
+      assert_equal [[16_000, 16, 16 * 499_500]], result
+      assert_equal (0...16).to_a, claimed.sort
+
+      conn.disconnect
+      db.close
+    end
+
+    def test_local_init_state_is_per_thread
+      db = DuckDB::Database.open
+      conn = db.connect
+      states = []
+
+      tf = DuckDB::TableFunction.new
+      tf.name = 'local_state_fn'
+      tf.bind { |bind_info| bind_info.add_result_column('v', DuckDB::LogicalType::BIGINT) }
+      tf.init { |_init_info| nil }
+      tf.local_init { |_init_info| { done: false }.tap { |state| states << state } }
+      tf.execute do |func_info, output|
+        state = func_info.local_state
+        next output.size = 0 if state[:done]
+
+        state[:done] = true
+        output.set_value(0, 0, 42)
+        output.size = 1
+      end
+
+      conn.register_table_function(tf)
+
+      assert_equal [[42]], conn.query('SELECT * FROM local_state_fn()').to_a
+      assert_equal 1, states.size
+
+      conn.disconnect
+      db.close
+    end
+
+    def test_next_partition_without_partitions_raises
+      db = DuckDB::Database.open
+      conn = db.connect
+      columns = { 'v' => DuckDB::LogicalType::BIGINT }
+      tf = DuckDB::TableFunction.create(name: 'no_partitions', columns:) do |func_info|
+        func_info.next_partition
+        0
+      end
+      conn.register_table_function(tf)
+
+      assert_raises(DuckDB::Error) { conn.query('SELECT * FROM no_partitions()') }
+
+      conn.disconnect
+      db.close
+    end
+
+    def test_create_with_projection_pushdown_produces_only_read_columns
+      db = DuckDB::Database.open
+      conn = db.connect
+      columns = (0...5).to_h { |i| ["c#{i}", DuckDB::LogicalType::BIGINT] }
+      seen = []
+      done = false
+
+      tf = DuckDB::TableFunction.create(name: 'wide', columns:, projection_pushdown: true) do |func_info, output|
+        next 0 if done
+
+        done = true
+        seen << func_info.projected_columns
+        func_info.projected_columns.each { |col| output.set_value(col, 0, col * 10) }
+        1
+      end
+      conn.register_table_function(tf)
+
+      assert_equal [[40, 20]], conn.query('SELECT c4, c2 FROM wide()').to_a
+      assert_equal [[4, 2]], seen
+
+      conn.disconnect
+      db.close
+    end
+
+    def test_projection_pushdown_skips_writes_to_unread_columns
+      db = DuckDB::Database.open
+      conn = db.connect
+      columns = { 'a' => DuckDB::LogicalType::BIGINT, 'b' => DuckDB::LogicalType::VARCHAR }
+      done = false
+
+      tf = DuckDB::TableFunction.create(name: 'two_cols', columns:, projection_pushdown: true) do |_func_info, output|
+        next 0 if done
+
+        done = true
+        output.set_value(0, 0, 1)
+        output.set_value(1, 0, 'one')
+        1
+      end
+      conn.register_table_function(tf)
+
+      assert_equal [['one']], conn.query('SELECT b FROM two_cols()').to_a
+
+      done = false
+
+      assert_equal [[1, 'one']], conn.query('SELECT * FROM two_cols()').to_a
+
+      conn.disconnect
+      db.close
+    end
+
+    def test_projected_columns_is_nil_without_projection_pushdown
+      db = DuckDB::Database.open
+      conn = db.connect
+      projected = :unset
+      tf = DuckDB::TableFunction.create(name: 'plain', columns: { 'v' => DuckDB::LogicalType::BIGINT }) do |func_info|
+        projected = func_info.projected_columns
+        0
+      end
+      conn.register_table_function(tf)
+      conn.query('SELECT * FROM plain()')
+
+      assert_nil projected
+
+      conn.disconnect
+      db.close
+    end
+
+    def test_create_with_cardinality_sets_the_estimate
+      db = DuckDB::Database.open
+      conn = db.connect
+      columns = { 'v' => DuckDB::LogicalType::BIGINT }
+      tf = DuckDB::TableFunction.create(name: 'hinted', columns:, cardinality: 12_345) { 0 }
+      conn.register_table_function(tf)
+
+      assert_match(/~12,345 rows/, explain(conn, 'SELECT * FROM hinted()'))
+
+      conn.disconnect
+      db.close
+    end
+
+    def test_create_with_cardinality_callable
+      db = DuckDB::Database.open
+      conn = db.connect
+      columns = { 'v' => DuckDB::LogicalType::BIGINT }
+      cardinality = ->(bind_info) { bind_info.get_parameter(0) * 2 }
+      tf = DuckDB::TableFunction.create(name: 'twice', columns:, parameters: [:bigint], cardinality:,
+                                        exact_cardinality: true) { 0 }
+      conn.register_table_function(tf)
+
+      assert_match(/~4,000 rows/, explain(conn, 'SELECT * FROM twice(2000)'))
+
+      conn.disconnect
+      db.close
+    end
+
     private
 
+    def explain(conn, sql)
+      conn.query("EXPLAIN #{sql}").to_a.map(&:last).join
+    end
+
     def setup_incomplete_function
       database = DuckDB::Database.open
       conn = database.connect